@@ -38,10 +38,10 @@ using app::AppInfo;
 
 AppInfo::AppInfo( const QString & filename, 
                   const QString & directory, 
-                  const QImage & iconImage ) :
+                  const QString & iconPath ) :
   filename_( filename ),
   directory_( directory ),
-  iconImage_( iconImage )
+  iconPath_( iconPath )
 {
 }
 
@@ -76,9 +76,15 @@ QString AppInfo::absolutePathToFile()
     return fileInfo.absoluteFilePath();
 }
 
-QImage AppInfo::iconImage()
+/***************************************************************************//**
+The path of the icon image file.  The image itself is not read here; the 
+PaintWidget decodes it (in the background) when the icon is first shown.
+Together with the file's size and modification time, the path identifies 
+the icon in the IconAtlas cache.
+*******************************************************************************/
+QString AppInfo::iconPath()
 {
-    return iconImage_;
+    return iconPath_;
 }
 
 bool AppInfo::isFlash()
@@ -35,7 +35,6 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #define APP_APPINFO_H
 
 #include <QString>
-#include <QImage>
 
 namespace app
 {
@@ -44,7 +43,7 @@ namespace app
     public:
         AppInfo( const QString & filename, 
                  const QString & directory, 
-                 const QImage & icon );
+                 const QString & iconPath );
         virtual ~AppInfo();
 
         QString directory();
@@ -52,13 +51,13 @@ namespace app
         QString filename();
         QString pathToExecutable();
         QString absolutePathToFile();
-        QImage iconImage();
+        QString iconPath();
         bool isFlash();
 
     private:
         QString directory_,
-                filename_;
-        QImage iconImage_;
+                filename_,
+                iconPath_;
     };
 }
 
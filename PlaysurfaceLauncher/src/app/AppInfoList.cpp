@@ -38,7 +38,7 @@ using app::AppInfoList;
 
 AppInfoList::AppInfoList() :
   appInfos_(),
-  appIcons_()
+  iconPaths_()
 {
 }
 
@@ -53,13 +53,33 @@ void AppInfoList::clear()
         delete appInfos_.at( i );
     }
     appInfos_.clear();
-    appIcons_.clear();
+    iconPaths_.clear();
 }
 
 void AppInfoList::add( app::AppInfo * appInfo )
 {
     appInfos_.push_back( appInfo );
-    appIcons_.push_back( appInfo->iconImage() );
+    iconPaths_.push_back( appInfo->iconPath() );
+}
+
+void AppInfoList::insert( int index, app::AppInfo * appInfo )
+{
+    appInfos_.insert( appInfos_.begin() + index, appInfo );
+    iconPaths_.insert( iconPaths_.begin() + index, appInfo->iconPath() );
+}
+
+void AppInfoList::replace( int index, app::AppInfo * appInfo )
+{
+    delete appInfos_.at( index );
+    appInfos_.at( index ) = appInfo;
+    iconPaths_.at( index ) = appInfo->iconPath();
+}
+
+void AppInfoList::remove( int index )
+{
+    delete appInfos_.at( index );
+    appInfos_.erase( appInfos_.begin() + index );
+    iconPaths_.erase( iconPaths_.begin() + index );
 }
 
 app::AppInfo * AppInfoList::appInfo( int index )
@@ -80,7 +100,7 @@ std::vector<app::AppInfo *> * AppInfoList::appInfos()
     return &appInfos_;
 }
 
-std::vector<QImage> * AppInfoList::appIcons()
+std::vector<QString> * AppInfoList::iconPaths()
 {
-    return &appIcons_;
+    return &iconPaths_;
 }
@@ -34,7 +34,7 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #ifndef APP_APPINFOLIST_H
 #define APP_APPINFOLIST_H
 
-#include <QImage>
+#include <QString>
 #include <vector>
 
 namespace app { class AppInfo; }
@@ -49,14 +49,17 @@ namespace app
 
         void clear();
         void add( app::AppInfo * appInfo );
+        void insert( int index, app::AppInfo * appInfo );
+        void replace( int index, app::AppInfo * appInfo );
+        void remove( int index );
         int size();
         AppInfo * appInfo( int index );
         std::vector<app::AppInfo *> * appInfos();
-        std::vector<QImage> * appIcons();
+        std::vector<QString> * iconPaths();
 
     private:
         std::vector<app::AppInfo *> appInfos_;
-        std::vector<QImage> appIcons_;
+        std::vector<QString> iconPaths_;
     };
 }
 
@@ -36,8 +36,17 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #include "gui/DialogBoxUtils.h"
 #include "app/AppInfoList.h"
 #include "app/AppInfo.h"
+#include "app/AppPrefetcher.h"
+#include "app/LaunchTimeline.h"
+#include "app/LaunchStats.h"
+#include "app/TuioGeneratorSupervisor.h"
 #include "utils/WindowUtility.h"
+#include "utils/Win32WindowReadiness.h"
 #include "utils/EdgeGesturesUtility.h"
+#include "utils/StopWatch.h"
+#include "logger/FileLogger.h"
+#include "logger/EventJournal.h"
+#include "metrics/Metrics.h"
 #include "exceptions/FileNotFoundException.h"
 #include "exceptions/FileNotReadableException.h"
 #include <QApplication>
@@ -46,6 +55,8 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #include <QProcess>
 #include <QProcessEnvironment>
 #include <QTimer>
+#include <QFileInfo>
+#include <QtConcurrentRun>
 #include <iostream>
 
 using app::AppLauncher;
@@ -53,10 +64,12 @@ using exceptions::FileNotFoundException;
 using exceptions::FileNotReadableException;
 
 const bool AppLauncher::ASSUME_FLASHPLAYER_EXE_IS_IN_PATH = false;
-const int AppLauncher::FOCUS_DELAY_MILLISECONDS = 400,
-          AppLauncher::MOUSE_X = 20,
+const int AppLauncher::MOUSE_X = 20,
           AppLauncher::MOUSE_Y = 50,
-          AppLauncher::DELAY_FOR_CLOSING_TUIO_SERVER_APP = 3000;
+          AppLauncher::TUIO_SERVER_WINDOW_TIMEOUT_MILLISEC = 3000,
+          AppLauncher::SCAN_PROGRESS_MILLISECONDS = 100,
+          AppLauncher::FIRST_FRAME_TIMEOUT_MILLISECONDS = 30000,
+          AppLauncher::WARM_START_RECENT_APPS = 3;
 
 AppLauncher::AppLauncher( playsurface::Playsurface * parent ) :
   parent_( parent ),
@@ -66,31 +79,83 @@ AppLauncher::AppLauncher( playsurface::Playsurface * parent ) :
   touchHooksInfo_( NULL ),
   flashPlayerInfo_( NULL ),
   appInfoList_( new app::AppInfoList() ),
+  scanAppInfoList_( NULL ),
+  scanProgressTimer_( new QTimer( this ) ),
+  publishedScanCount_( 0 ),
+  appPrefetcher_( new app::AppPrefetcher() ),
+  warmStartApps_(),
+  launchStopWatch_( new utils::StopWatch() ),
+  currentLaunch_( NULL ),
+  launchStats_( new app::LaunchStats() ),
+  launchStatsWatcher_( new QFutureWatcher<bool>( this ) ),
+  tuioGeneratorSupervisor_( new app::TuioGeneratorSupervisor( this ) ),
   windowUtility_( new utils::WindowUtility() ),
-  edgeGesturesUtility_( new utils::EdgeGesturesUtility() ),
+  windowReadiness_( new utils::Win32WindowReadiness() ),
+  edgeGesturesUtility_( new utils::EdgeGesturesUtility( windowReadiness_ ) ),
   bigBlobbyProcess_( NULL ),
   touchHooksProcess_( NULL ),
   multitouchProcess_( NULL ),
   tuioGenerator_( enums::TuioSourceEnum::BIG_BLOBBY ),
   hideBigBlobbyAfterStartup_( false ),
-  hideTouchHooks2TuioAfterStartup_( false )
+  hideTouchHooks2TuioAfterStartup_( false ),
+  reportErrorsWhenRead_( false ),
+  warmStart_( false ),
+  launchStatsChanged_( false )
 {
-
+    scanProgressTimer_->setSingleShot( true );
+    scanProgressTimer_->setInterval( SCAN_PROGRESS_MILLISECONDS );
+    connect( scanProgressTimer_, SIGNAL( timeout() ), this, SLOT( publishScannedAppInfo() ) );
+    connect( windowReadiness_, SIGNAL( windowReady( unsigned long, int ) ),
+             this, SLOT( onWindowReady( unsigned long, int ) ) );
+    connect( windowReadiness_, SIGNAL( windowTimedOut( unsigned long, int ) ),
+             this, SLOT( onWindowTimedOut( unsigned long, int ) ) );
+    launchStats_->load();
+    connect( launchStatsWatcher_, SIGNAL( finished() ), this, SLOT( onLaunchStatsSaved() ) );
+    connect( tuioGeneratorSupervisor_, SIGNAL( restartDue() ), 
+             this, SLOT( restartTuioGenerator() ) );
+    connect( tuioGeneratorSupervisor_, SIGNAL( generatorWedged() ), 
+             this, SLOT( onTuioGeneratorWedged() ) );
+    connect( directoryReader_, SIGNAL( multitouchAppsReadStarted() ), 
+             this, SLOT( onMultitouchAppsReadStarted() ) );
+    connect( directoryReader_, SIGNAL( appInfoRead( app::AppInfo * ) ), 
+             this, SLOT( onAppInfoRead( app::AppInfo * ) ) );
+    connect( directoryReader_, SIGNAL( multitouchAppsReadFinished() ), 
+             this, SLOT( onMultitouchAppsReadFinished() ) );
+    connect( directoryReader_, SIGNAL( appInfoInserted( int, app::AppInfo * ) ), 
+             this, SLOT( onAppInfoInserted( int, app::AppInfo * ) ) );
+    connect( directoryReader_, SIGNAL( appInfoReplaced( int, app::AppInfo * ) ), 
+             this, SLOT( onAppInfoReplaced( int, app::AppInfo * ) ) );
+    connect( directoryReader_, SIGNAL( appInfoRemoved( int ) ), 
+             this, SLOT( onAppInfoRemoved( int ) ) );
 }
 
 AppLauncher::~AppLauncher()
 {
+    warmStart_ = false; // So that closing the app does not start a prefetch.
+    tuioGeneratorSupervisor_->generatorStopped();
     killMultitouchAppProcess();
     killTouchHooks2TuioProcess();
     killBigBlobbyProcess();
     delete edgeGesturesUtility_;
+    delete windowReadiness_;
     delete windowUtility_;
+    delete currentLaunch_;
+    launchStatsWatcher_->disconnect( this );
+    launchStatsWatcher_->waitForFinished();
+
+    if( launchStatsChanged_ ) {
+        launchStats_->save();
+    }
+    delete launchStats_;
+    delete launchStopWatch_;
+    delete appPrefetcher_;
+    delete directoryReader_;
+    delete scanAppInfoList_;
     delete appInfoList_;
     delete flashPlayerInfo_;
     delete touchHooksInfo_;
     delete bigBlobbyInfo_;
     delete dialogBoxUtils_;
-    delete directoryReader_;
 }
 
 enums::TuioSourceEnum::Enum AppLauncher::tuioGenerator()
@@ -98,10 +163,16 @@ enums::TuioSourceEnum::Enum AppLauncher::tuioGenerator()
     return tuioGenerator_;
 }
 
+app::TuioGeneratorSupervisor * AppLauncher::tuioGeneratorSupervisor()
+{
+    return tuioGeneratorSupervisor_;
+}
+
 void AppLauncher::resetTuioGenerator( enums::TuioSourceEnum::Enum tuioSource )
 {
     if( tuioGenerator_ != tuioSource ) {
         tuioGenerator_ = tuioSource;
+        tuioGeneratorSupervisor_->generatorStopped();
         killBigBlobbyProcess();
         killTouchHooks2TuioProcess();
 
@@ -120,6 +191,7 @@ void AppLauncher::resetTuioGenerator( enums::TuioSourceEnum::Enum tuioSource )
 void AppLauncher::killBigBlobbyProcess()
 {
     if( bigBlobbyProcess_ != NULL ) {
+        windowReadiness_->unwatch( processId( bigBlobbyProcess_ ) );
         bigBlobbyProcess_->disconnect();
         bigBlobbyProcess_->close();
         delete bigBlobbyProcess_;
@@ -130,6 +202,7 @@ void AppLauncher::killBigBlobbyProcess()
 void AppLauncher::killTouchHooks2TuioProcess()
 {
     if( touchHooksProcess_ != NULL ) {
+        windowReadiness_->unwatch( processId( touchHooksProcess_ ) );
         touchHooksProcess_->disconnect();
         touchHooksProcess_->close();
         delete touchHooksProcess_;
@@ -337,18 +410,30 @@ void AppLauncher::connectTouchHooks2TuioProcess()
              this, SLOT( onTouchHooks2TuioStarted() ) );
 }
 
+/***************************************************************************//**
+BigBlobby is hidden as soon as its main window appears (see onWindowReady()),
+or after TUIO_SERVER_WINDOW_TIMEOUT_MILLISEC if it never does.
+*******************************************************************************/
 void AppLauncher::onBigBlobbyStarted()
 {
+    tuioGeneratorSupervisor_->generatorStarted( "BigBlobby", true );
+
     if( hideBigBlobbyAfterStartup_ ) {
-        QTimer::singleShot( DELAY_FOR_CLOSING_TUIO_SERVER_APP, this, SLOT( hideBigBlobby() ) );
+        windowReadiness_->watch( processId( bigBlobbyProcess_ ), 
+                                 utils::WindowReadiness::LARGE, 
+                                 TUIO_SERVER_WINDOW_TIMEOUT_MILLISEC );
         hideBigBlobbyAfterStartup_ = false;
     }
 }
 
 void AppLauncher::onTouchHooks2TuioStarted()
 {
+    tuioGeneratorSupervisor_->generatorStarted( "TouchHooks2Tuio", false );
+
     if( hideTouchHooks2TuioAfterStartup_ ) {
-        QTimer::singleShot( DELAY_FOR_CLOSING_TUIO_SERVER_APP, this, SLOT( hideTouchHooks2Tuio() ) );
+        windowReadiness_->watch( processId( touchHooksProcess_ ), 
+                                 utils::WindowReadiness::LARGE, 
+                                 TUIO_SERVER_WINDOW_TIMEOUT_MILLISEC );
         hideTouchHooks2TuioAfterStartup_ = false;
     }
 }
@@ -383,7 +468,10 @@ void AppLauncher::reportBigBlobbyError( QProcess::ProcessError processError )
 {
     if( processError == QProcess::FailedToStart ) {
         killBigBlobbyProcess();
-        dialogBoxUtils_->warnUserBigBlobbyFailedToStart();
+
+        if( !tuioGeneratorSupervisor_->generatorLost( "failed to restart" ) ) {
+            dialogBoxUtils_->warnUserBigBlobbyFailedToStart();
+        }
     }
 }
 
@@ -391,60 +479,311 @@ void AppLauncher::reportTouchHooks2TuioError( QProcess::ProcessError processErro
 {
     if( processError == QProcess::FailedToStart ) {
         killTouchHooks2TuioProcess();
-        dialogBoxUtils_->warnUserTouchHooks2TuioFailedToStart();
+
+        if( !tuioGeneratorSupervisor_->generatorLost( "failed to restart" ) ) {
+            dialogBoxUtils_->warnUserTouchHooks2TuioFailedToStart();
+        }
     }
 }
 
+/***************************************************************************//**
+A crash is left to the TuioGeneratorSupervisor, which restarts BigBlobby; the
+user only gets a dialog box if it gives up.  BigBlobby closing normally means
+someone quit it, so it is not restarted.
+*******************************************************************************/
 void AppLauncher::reportBigBlobbyFinished( int exitCode, QProcess::ExitStatus exitStatus )
 {
+    QProcess::ProcessError processError = QProcess::UnknownError;
+
+    if( bigBlobbyProcess_ != NULL ) {
+        processError = bigBlobbyProcess_->error();
+    }
     killBigBlobbyProcess();
 
-    if( exitCode != 0 ) {
-        QProcess::ProcessError processError = QProcess::UnknownError;
+    if( exitCode != 0 || exitStatus == QProcess::CrashExit ) {
+        QString reason = QString( "exited with code %1" ).arg( exitCode );
 
-        if( bigBlobbyProcess_ != NULL ) {
-            processError = bigBlobbyProcess_->error();
+        if( !tuioGeneratorSupervisor_->generatorLost( reason ) ) {
+            dialogBoxUtils_->warnUserBigBlobbyCrashed( processError );
         }
-        dialogBoxUtils_->warnUserBigBlobbyCrashed( processError );
     }
     else {
+        tuioGeneratorSupervisor_->generatorStopped();
         dialogBoxUtils_->warnUserBigBlobbyClosed();
     }
 }
 
 void AppLauncher::reportTouchHooks2TuioFinished( int exitCode, QProcess::ExitStatus exitStatus )
 {
+    QProcess::ProcessError processError = QProcess::UnknownError;
+
+    if( touchHooksProcess_ != NULL ) {
+        processError = touchHooksProcess_->error();
+    }
     killTouchHooks2TuioProcess();
 
-    if( exitCode != 0 ) {
-        QProcess::ProcessError processError = QProcess::UnknownError;
+    if( exitCode != 0 || exitStatus == QProcess::CrashExit ) {
+        QString reason = QString( "exited with code %1" ).arg( exitCode );
 
-        if( touchHooksProcess_ != NULL ) {
-            processError = touchHooksProcess_->error();
+        if( !tuioGeneratorSupervisor_->generatorLost( reason ) ) {
+            dialogBoxUtils_->warnUserTouchHooks2TuioCrashed( processError );
         }
-        dialogBoxUtils_->warnUserTouchHooks2TuioCrashed( processError );
     }
     else {
+        tuioGeneratorSupervisor_->generatorStopped();
         dialogBoxUtils_->warnUserTouchHooks2TuioClosed();
     }
 }
 
+/***************************************************************************//**
+A restarted TUIO generator is hidden as soon as its window appears, so that 
+it does not cover the launcher or a running multitouch app.
+*******************************************************************************/
+void AppLauncher::restartTuioGenerator()
+{
+    if( tuioGenerator_ == enums::TuioSourceEnum::BIG_BLOBBY ) {
+        hideBigBlobbyAfterStartup_ = true;
+    }
+    else {
+        hideTouchHooks2TuioAfterStartup_ = true;
+    }
+    launchTuioGenerator( tuioGenerator_ );
+}
+
+/***************************************************************************//**
+The TUIO generator is still running but has stopped sending TUIO frames, so
+it is killed and left to the TuioGeneratorSupervisor to restart.
+*******************************************************************************/
+void AppLauncher::onTuioGeneratorWedged()
+{
+    if( tuioGenerator_ == enums::TuioSourceEnum::BIG_BLOBBY ) {
+        killBigBlobbyProcess();
+
+        if( !tuioGeneratorSupervisor_->generatorLost( "was killed" ) ) {
+            dialogBoxUtils_->warnUserBigBlobbyCrashed( QProcess::Timedout );
+        }
+    }
+    else {
+        killTouchHooks2TuioProcess();
+
+        if( !tuioGeneratorSupervisor_->generatorLost( "was killed" ) ) {
+            dialogBoxUtils_->warnUserTouchHooks2TuioCrashed( QProcess::Timedout );
+        }
+    }
+}
+
+/***************************************************************************//**
+Starts reading the multitouch apps in the background.  The apps that are
+found are collected in a separate list.  At most every 
+SCAN_PROGRESS_MILLISECONDS while the read is running, the apps found since 
+the last time are appended to the current list (with a 
+multitouchAppsAppended() signal; the first batch replaces the old list), and
+when the read finishes the whole list replaces the current list (with a
+multitouchAppsInfoChanged() signal).
+*******************************************************************************/
 void AppLauncher::readMultitouchAppsInfo()
 {
-    appInfoList_->clear();
-    directoryReader_->readMultitouchAppsInfo( appInfoList_ );
+    directoryReader_->startReadingMultitouchAppsInfo();
+}
+
+void AppLauncher::onMultitouchAppsReadStarted()
+{
+    delete scanAppInfoList_;
+    scanAppInfoList_ = new app::AppInfoList();
+    publishedScanCount_ = 0;
+}
+
+void AppLauncher::onAppInfoRead( app::AppInfo * appInfo )
+{
+    if( scanAppInfoList_ == NULL ) {
+        delete appInfo;
+        return;
+    }
+    scanAppInfoList_->add( appInfo );
+
+    if( !scanProgressTimer_->isActive() ) {
+        scanProgressTimer_->start();
+    }
+}
+
+/***************************************************************************//**
+Hands the apps read since the last time to the GUI.  The list being read 
+into keeps ownership of its AppInfo objects, so the published list only 
+gets copies of them, and only the new ones are copied.
+*******************************************************************************/
+void AppLauncher::publishScannedAppInfo()
+{
+    if( scanAppInfoList_ != NULL && scanAppInfoList_->size() > publishedScanCount_ ) {
+        int index = publishedScanCount_;
+
+        if( index == 0 ) {
+            delete appInfoList_;
+            appInfoList_ = new app::AppInfoList();
+        }
+        for( int i = index; i < scanAppInfoList_->size(); ++i ) {
+            appInfoList_->add( new app::AppInfo( *scanAppInfoList_->appInfo( i ) ) );
+        }
+        publishedScanCount_ = scanAppInfoList_->size();
+        emit multitouchAppsAppended( index );
+    }
+}
+
+void AppLauncher::onMultitouchAppsReadFinished()
+{
+    scanProgressTimer_->stop();
+
+    if( scanAppInfoList_ != NULL ) {
+        delete appInfoList_;
+        appInfoList_ = scanAppInfoList_;
+        scanAppInfoList_ = NULL;
+        publishedScanCount_ = 0;
+        emit multitouchAppsInfoChanged();
+    }
+    if( reportErrorsWhenRead_ ) {
+        reportErrorsWhenRead_ = false;
+        reportAnyMultitouchAppInfoErrors();
+    }
+    prefetchWarmStartApps();
+}
+
+/***************************************************************************//**
+The DirectoryReader only reports single-app changes (found by watching the 
+MultitouchApps directory) between full reads, so they always apply to the 
+published list.
+*******************************************************************************/
+void AppLauncher::onAppInfoInserted( int index, app::AppInfo * appInfo )
+{
+    if( index < 0 || index > appInfoList_->size() ) {
+        delete appInfo;
+        return;
+    }
+    appPrefetcher_->forget( appInfo->directory() );
+    appInfoList_->insert( index, appInfo );
+    emit multitouchAppInserted( index );
+}
+
+void AppLauncher::onAppInfoReplaced( int index, app::AppInfo * appInfo )
+{
+    if( index < 0 || index >= appInfoList_->size() ) {
+        delete appInfo;
+        return;
+    }
+    appPrefetcher_->forget( appInfoList_->appInfo( index )->directory() );
+    appPrefetcher_->forget( appInfo->directory() );
+    appInfoList_->replace( index, appInfo );
+    emit multitouchAppReplaced( index );
+}
+
+void AppLauncher::onAppInfoRemoved( int index )
+{
+    if( index >= 0 && index < appInfoList_->size() ) {
+        appPrefetcher_->forget( appInfoList_->appInfo( index )->directory() );
+        appInfoList_->remove( index );
+        emit multitouchAppRemoved( index );
+    }
 }
 
+/***************************************************************************//**
+If the multitouch apps are still being read, the errors are reported when
+the read finishes.
+*******************************************************************************/
 void AppLauncher::reportAnyMultitouchAppInfoErrors()
 {
-    if( directoryReader_->hasAppInfoErrors() ) {
+    if( directoryReader_->isReadingMultitouchAppsInfo() ) {
+        reportErrorsWhenRead_ = true;
+    }
+    else if( directoryReader_->hasAppInfoErrors() ) {
         dialogBoxUtils_->warnUser( directoryReader_->appInfoErrors() );
     }
 }
 
-std::vector<QImage> * AppLauncher::multitouchAppIcons()
+std::vector<QString> * AppLauncher::multitouchAppIconPaths()
 {
-    return appInfoList_->appIcons();
+    return appInfoList_->iconPaths();
+}
+
+/***************************************************************************//**
+In warm-start mode, the executables and DLLs of the chosen apps are read 
+into the file cache in the background whenever the list of apps has been 
+read and no app is running.  The apps are given by the names of their 
+subdirectories in the MultitouchApps directory; if no names are given, the 
+WARM_START_RECENT_APPS most recently launched apps are warmed up (as 
+recorded by the launch statistics, so nothing is warmed up before the first
+launch).  Apps on USB drives never are, since reading them would keep the 
+drive busy.
+*******************************************************************************/
+void AppLauncher::useWarmStart( bool b, const QStringList & appNames )
+{
+    warmStart_ = b;
+    warmStartApps_ = appNames;
+
+    if( warmStart_ ) {
+        prefetchWarmStartApps();
+    }
+    else {
+        appPrefetcher_->cancel();
+    }
+}
+
+bool AppLauncher::isWarmStartInUse()
+{
+    return warmStart_;
+}
+
+void AppLauncher::prefetchWarmStartApps()
+{
+    if( warmStart_ && multitouchProcess_ == NULL ) {
+        appPrefetcher_->prefetch( warmStartDirectories() );
+    }
+}
+
+QStringList AppLauncher::warmStartDirectories()
+{
+    QStringList directories,
+                recentDirectories;
+    bool flashAppIncluded = false;
+
+    if( warmStartApps_.isEmpty() ) {
+        recentDirectories = launchStats_->recentDirectories( WARM_START_RECENT_APPS );
+    }
+    for( int i = 0; i < appInfoList_->size(); ++i ) {
+        app::AppInfo * appInfo = appInfoList_->appInfo( i );
+        QString directory = appInfo->directory(),
+                appName = QFileInfo( directory ).fileName();
+        bool isLocal = directory.startsWith( io::DirectoryReader::MULTI_TOUCH_DIR + "/" ),
+             isChosen = warmStartApps_.isEmpty() 
+                        ? recentDirectories.contains( directory )
+                        : warmStartApps_.contains( appName, Qt::CaseInsensitive );
+
+        if( isLocal && isChosen ) {
+            directories.append( directory );
+            flashAppIncluded = flashAppIncluded || appInfo->isFlash();
+        }
+    }
+    if( flashAppIncluded && flashPlayerInfo_ != NULL ) {
+        directories.prepend( flashPlayerInfo_->directory() );
+    }
+    return directories;
+}
+
+/***************************************************************************//**
+Called as soon as an app icon is touched.  In warm-start mode, any other 
+prefetching is dropped, and the app's own files are read into the file cache 
+during the icon's gray-out delay (if they are not cached already).
+*******************************************************************************/
+void AppLauncher::prepareMultitouchApp( int index )
+{
+    app::AppInfo * appInfo = (index >= 0) ? appInfoList_->appInfo( index ) : NULL;
+
+    if( warmStart_ && appInfo != NULL && multitouchProcess_ == NULL ) {
+        QStringList directories( appInfo->directory() );
+
+        if( appInfo->isFlash() && flashPlayerInfo_ != NULL ) {
+            directories.prepend( flashPlayerInfo_->directory() );
+        }
+        appPrefetcher_->cancel();
+        appPrefetcher_->prefetch( directories );
+    }
 }
 
 void AppLauncher::launchMultitouchApp( int index )
@@ -457,6 +796,11 @@ void AppLauncher::launchMultitouchApp( int index )
             moveMouseToBottomCenter();
             windowUtility_->leftClickMouse();
 
+            startLaunchTiming( appInfo );
+            logger::EventJournal::instance().recordText( logger::EventJournal::APP_LAUNCHED, index,
+                                                         appName( appInfo->directory() ) );
+            metrics::Metrics::instance().appLaunches.increment();
+
             if( appInfo->isFlash() ) {
                 launchFlashMultitouchApp( appInfo );
             }
@@ -496,6 +840,12 @@ void AppLauncher::hideBigBlobby()
     if( bigBlobbyProcess_ != NULL && bigBlobbyProcess_->state() == QProcess::Running ) {
         windowUtility_->hideWindowIfVisible( bigBlobbyProcess_->pid() );
     }
+    // A restarted BigBlobby may be hidden while a multitouch app is open,
+    // and the app should keep the focus.
+    if( multitouchProcess_ != NULL && multitouchProcess_->state() == QProcess::Running ) {
+        focusOnMultitouchApp();
+        return;
+    }
     // After hiding BigBlobby, give focus to the 
     // PlaysurfaceLauncher so keyboard shortcuts will work.
     windowUtility_->moveMouse( MOUSE_X, MOUSE_Y );
@@ -507,6 +857,12 @@ void AppLauncher::hideTouchHooks2Tuio()
     if( touchHooksProcess_ != NULL && touchHooksProcess_->state() == QProcess::Running ) {
         windowUtility_->hideWindowIfVisible( touchHooksProcess_->pid() );
     }
+    // A restarted TouchHooks2Tuio may be hidden while a multitouch app is open,
+    // and the app should keep the focus.
+    if( multitouchProcess_ != NULL && multitouchProcess_->state() == QProcess::Running ) {
+        focusOnMultitouchApp();
+        return;
+    }
     // After hiding TouchHooks2Tuio, give focus to the 
     // PlaysurfaceLauncher so keyboard shortcuts will work.
     windowUtility_->moveMouse( MOUSE_X, MOUSE_Y );
@@ -567,10 +923,178 @@ void AppLauncher::connectMultitouchProcess()
              this, SLOT( reportMultitouchAppFinished( int, QProcess::ExitStatus ) ) );
 }
 
+/***************************************************************************//**
+The app is focused as soon as it shows a large or fullscreen window (rather 
+than after a fixed delay), or after FIRST_FRAME_TIMEOUT_MILLISECONDS if it 
+never does.  A splash screen or console window shown first does not count.
+*******************************************************************************/
 void AppLauncher::onMultitouchProcessStarted()
 {
     disableEdgeGesturesForFullscreenApp();
-    QTimer::singleShot( FOCUS_DELAY_MILLISECONDS, this, SLOT( focusOnMultitouchApp() ) );
+
+    if( currentLaunch_ != NULL ) {
+        currentLaunch_->processStarted = launchStopWatch_->elapsed();
+    }
+    windowReadiness_->watch( processId( multitouchProcess_ ), 
+                             utils::WindowReadiness::LARGE, 
+                             FIRST_FRAME_TIMEOUT_MILLISECONDS );
+}
+
+/***************************************************************************//**
+Every launch gets a LaunchTimeline, timed from the moment the app is launched
+(after the icon's gray-out delay).  The timeline is filled in as the app 
+starts, shows its first window, is focused, and is first touched, and it is 
+added to the LaunchStats when the app exits.
+*******************************************************************************/
+void AppLauncher::startLaunchTiming( app::AppInfo * appInfo )
+{
+    delete currentLaunch_;
+    currentLaunch_ = new app::LaunchTimeline();
+    currentLaunch_->directory = appInfo->directory();
+    currentLaunch_->launchedAt = QDateTime::currentDateTime();
+    currentLaunch_->prefetched = appPrefetcher_->wasPrefetched( appInfo->directory() );
+    launchStopWatch_->start();
+}
+
+/***************************************************************************//**
+An app that crashed or exited with a non-zero exit code counts as failed (in
+the appCrashes metric).
+*******************************************************************************/
+void AppLauncher::observeAppRunTime( bool failed )
+{
+    metrics::Metrics & metrics = metrics::Metrics::instance();
+
+    if( currentLaunch_ != NULL ) {
+        metrics.appRunTime.observeMicroseconds( (long long)(launchStopWatch_->elapsed() * 1000000.0) );
+    }
+    if( failed ) {
+        metrics.appCrashes.increment();
+    }
+}
+
+/***************************************************************************//**
+The name of the app's own folder, for the event journal.
+*******************************************************************************/
+std::string AppLauncher::appName( const QString & directory )
+{
+    return QFileInfo( directory ).fileName().toStdString();
+}
+
+unsigned long AppLauncher::processId( QProcess * process )
+{
+    return (process != NULL) ? (unsigned long)process->processId() : 0;
+}
+
+/***************************************************************************//**
+Only the LARGE watches are started here (the EdgeGesturesUtility handles 
+its own FULLSCREEN watches).  A TUIO generator is hidden as soon as its main
+window appears, and a multitouch app is focused as soon as its main window
+appears.
+*******************************************************************************/
+void AppLauncher::onWindowReady( unsigned long pid, int condition )
+{
+    if( condition == utils::WindowReadiness::LARGE ) {
+        actOnWindow( pid, true );
+    }
+}
+
+/***************************************************************************//**
+If a window never shows up, the action is tried anyway, as it was before 
+there was a WindowReadiness.
+*******************************************************************************/
+void AppLauncher::onWindowTimedOut( unsigned long pid, int condition )
+{
+    if( condition == utils::WindowReadiness::LARGE ) {
+        actOnWindow( pid, false );
+    }
+}
+
+void AppLauncher::actOnWindow( unsigned long pid, bool windowShown )
+{
+    if( pid == processId( multitouchProcess_ ) ) {
+        onMultitouchAppWindowReady( windowShown );
+    }
+    else if( pid == processId( bigBlobbyProcess_ ) ) {
+        hideBigBlobby();
+    }
+    else if( pid == processId( touchHooksProcess_ ) ) {
+        hideTouchHooks2Tuio();
+    }
+}
+
+void AppLauncher::onMultitouchAppWindowReady( bool windowShown )
+{
+    if( currentLaunch_ != NULL && currentLaunch_->firstWindow < 0 ) {
+        if( windowShown ) {
+            currentLaunch_->firstWindow = launchStopWatch_->elapsed();
+        }
+        logLaunchTime( windowShown ? "first frame" : "no visible window" );
+    }
+    focusOnMultitouchApp();
+}
+
+void AppLauncher::logLaunchTime( const QString & outcome )
+{
+    if( currentLaunch_ == NULL ) {
+        return;
+    }
+    QString message = QString( "AppLauncher: %1 launch to %2 in %3 s (%4)" )
+                          .arg( currentLaunch_->directory )
+                          .arg( outcome )
+                          .arg( launchStopWatch_->elapsed(), 0, 'f', 3 )
+                          .arg( currentLaunch_->prefetched ? "prefetched" : "not prefetched" );
+    logger::FileLogger::instance().writeInfo( message.toStdString() );
+}
+
+/***************************************************************************//**
+Called (through a queued connection from the TUIO thread) on the first touch 
+after a multitouch app was brought to the front.
+*******************************************************************************/
+void AppLauncher::onFirstTouchInApp()
+{
+    if( currentLaunch_ != NULL && currentLaunch_->firstTouch < 0 && multitouchProcess_ != NULL ) {
+        currentLaunch_->firstTouch = launchStopWatch_->elapsed();
+    }
+}
+
+void AppLauncher::finishLaunchTimeline( int exitCode, const QString & outcome )
+{
+    if( currentLaunch_ != NULL ) {
+        currentLaunch_->runTime = launchStopWatch_->elapsed();
+        currentLaunch_->exitCode = exitCode;
+        currentLaunch_->outcome = outcome;
+        launchStats_->add( *currentLaunch_ );
+        saveLaunchStats();
+        delete currentLaunch_;
+        currentLaunch_ = NULL;
+    }
+}
+
+/***************************************************************************//**
+The telemetry files are written on a worker thread from a copy of the 
+statistics.  If the previous save is still running, the launch is saved 
+with the next batch when it finishes (see onLaunchStatsSaved()).
+*******************************************************************************/
+void AppLauncher::saveLaunchStats()
+{
+    if( launchStatsWatcher_->isRunning() ) {
+        launchStatsChanged_ = true;
+    }
+    else {
+        launchStatsChanged_ = false;
+        launchStatsWatcher_->setFuture( QtConcurrent::run( &app::LaunchStats::saveCopy, 
+                                                           *launchStats_ ) );
+    }
+}
+
+void AppLauncher::onLaunchStatsSaved()
+{
+    if( !launchStatsWatcher_->result() ) {
+        logger::FileLogger::instance().writeWarning( "AppLauncher: could not save the launch statistics." );
+    }
+    if( launchStatsChanged_ ) {
+        saveLaunchStats();
+    }
 }
 
 void AppLauncher::disableEdgeGesturesForFullscreenApp()
@@ -592,6 +1116,10 @@ void AppLauncher::focusOnMultitouchApp()
     if( multitouchProcess_ != NULL && multitouchProcess_->state() == QProcess::Running ) {
         windowUtility_->focusOnWindow( multitouchProcess_->pid() );
 
+        if( currentLaunch_ != NULL && currentLaunch_->focused < 0 ) {
+            currentLaunch_->focused = launchStopWatch_->elapsed();
+        }
+
         // Some apps move mouse cursor to center, so move it out of the way.
         moveMouseToBottomCenter();
     }
@@ -602,6 +1130,8 @@ void AppLauncher::reportMultitouchAppError( QProcess::ProcessError processError
     emit multitouchAppClosed();
 
     if( processError == QProcess::FailedToStart ) {
+        finishLaunchTimeline( app::LaunchTimeline::NOT_REACHED, "failedToStart" );
+        windowReadiness_->unwatch( processId( multitouchProcess_ ) );
         dialogBoxUtils_->warnUserMultitouchAppFailedToStart();
         multitouchProcess_->disconnect();
         multitouchProcess_->close();
@@ -615,15 +1145,29 @@ void AppLauncher::killMultitouchAppProcess()
     emit multitouchAppClosed();
 
     if( multitouchProcess_ != NULL ) {
+        finishLaunchTimeline( app::LaunchTimeline::NOT_REACHED, "closedByLauncher" );
+        windowReadiness_->unwatch( processId( multitouchProcess_ ) );
         multitouchProcess_->disconnect();
         multitouchProcess_->close();
         delete multitouchProcess_;
         multitouchProcess_ = NULL;
+
+        // Picks up any warm-start apps dropped by prepareMultitouchApp().
+        prefetchWarmStartApps();
     }
 }
 
 void AppLauncher::reportMultitouchAppFinished( int exitCode, QProcess::ExitStatus exitStatus )
 {
+    bool crashed = (exitStatus == QProcess::CrashExit),
+         failed = crashed || (exitCode != 0);
+    QString directory = (currentLaunch_ != NULL) ? currentLaunch_->directory : QString();
+    logger::EventJournal::instance().recordText( failed ? logger::EventJournal::APP_CRASHED 
+                                                        : logger::EventJournal::APP_EXITED,
+                                                 exitCode, appName( directory ) );
+    observeAppRunTime( failed );
+    finishLaunchTimeline( exitCode, failed ? "crashed" : "exited" );
+
     if( exitCode != 0 ) {
         QProcess::ProcessError processError = QProcess::UnknownError;
 
@@ -37,15 +37,25 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #include <QObject>
 #include <QImage>
 #include <QProcess>
+#include <QStringList>
+#include <QFutureWatcher>
 #include <vector>
+#include <string>
 
 namespace playsurface { class Playsurface; }
 namespace io { class DirectoryReader; }
 namespace app { class AppInfoList; }
 namespace app { class AppInfo; }
+namespace app { class AppPrefetcher; }
+namespace app { class LaunchTimeline; }
+namespace app { class LaunchStats; }
+namespace app { class TuioGeneratorSupervisor; }
 namespace gui { class DialogBoxUtils; }
 namespace utils { class WindowUtility; }
 namespace utils { class EdgeGesturesUtility; }
+namespace utils { class StopWatch; }
+namespace utils { class WindowReadiness; }
+class QTimer;
 
 namespace app
 {
@@ -55,10 +65,12 @@ namespace app
 
     public:
         static const bool ASSUME_FLASHPLAYER_EXE_IS_IN_PATH;
-        static const int FOCUS_DELAY_MILLISECONDS,
-                         MOUSE_X,
+        static const int MOUSE_X,
                          MOUSE_Y,
-                         DELAY_FOR_CLOSING_TUIO_SERVER_APP;
+                         TUIO_SERVER_WINDOW_TIMEOUT_MILLISEC,
+                         SCAN_PROGRESS_MILLISECONDS,
+                         FIRST_FRAME_TIMEOUT_MILLISECONDS,
+                         WARM_START_RECENT_APPS;
 
         AppLauncher( playsurface::Playsurface * parent );
         virtual ~AppLauncher();
@@ -66,14 +78,18 @@ namespace app
         void launchTuioGenerator( enums::TuioSourceEnum::Enum tuioSource );
         void resetTuioGenerator( enums::TuioSourceEnum::Enum tuioSource );
         enums::TuioSourceEnum::Enum tuioGenerator();
+        app::TuioGeneratorSupervisor * tuioGeneratorSupervisor();
         void killMultitouchAppProcess();
-        std::vector<QImage> * multitouchAppIcons();
+        std::vector<QString> * multitouchAppIconPaths();
         bool hasMultitouchAppsDirectory( char driveLetter );
         bool isMultitouchAppsDirInUse( char driveLetter );
         void placeAllOtherWindowsInTaskbar();
         void hideBigBlobbyOnStartup();
         void hideTouchHooks2TuioOnStartup();
         void disablePlaysurfaceLauncherEdgeGestures();
+        void useWarmStart( bool b, const QStringList & appNames );
+        bool isWarmStartInUse();
+        void prepareMultitouchApp( int index );
         
         void killBigBlobbyIfAlreadyOpen();
         void killTouchHooks2TuioIfAlreadyOpen();
@@ -105,6 +121,19 @@ namespace app
         void disableEdgeGesturesForFullscreenApp();
         void reportMultitouchAppError( QProcess::ProcessError processError );
         void reportMultitouchAppFinished( int exitCode, QProcess::ExitStatus exitStatus );
+        void onMultitouchAppsReadStarted();
+        void onAppInfoRead( app::AppInfo * appInfo );
+        void onMultitouchAppsReadFinished();
+        void publishScannedAppInfo();
+        void onAppInfoInserted( int index, app::AppInfo * appInfo );
+        void onAppInfoReplaced( int index, app::AppInfo * appInfo );
+        void onAppInfoRemoved( int index );
+        void onWindowReady( unsigned long pid, int condition );
+        void onWindowTimedOut( unsigned long pid, int condition );
+        void onFirstTouchInApp();
+        void restartTuioGenerator();
+        void onTuioGeneratorWedged();
+        void onLaunchStatsSaved();
         
         void launchBigBlobby();
         void launchTouchHooks2Tuio();
@@ -112,6 +141,11 @@ namespace app
 
     signals:
         void multitouchAppClosed();
+        void multitouchAppsInfoChanged();
+        void multitouchAppsAppended( int index );
+        void multitouchAppInserted( int index );
+        void multitouchAppReplaced( int index );
+        void multitouchAppRemoved( int index );
 
     private:
         void killBigBlobbyProcess();
@@ -122,6 +156,17 @@ namespace app
         void launchFlashMultitouchApp( app::AppInfo * appInfo );
         void launchExeMultitouchApp( app::AppInfo * appInfo );
         void moveMouseToBottomCenter();
+        void startLaunchTiming( app::AppInfo * appInfo );
+        void logLaunchTime( const QString & outcome );
+        void actOnWindow( unsigned long pid, bool windowShown );
+        void onMultitouchAppWindowReady( bool windowShown );
+        void observeAppRunTime( bool failed );
+        std::string appName( const QString & directory );
+        unsigned long processId( QProcess * process );
+        void finishLaunchTimeline( int exitCode, const QString & outcome );
+        void saveLaunchStats();
+        void prefetchWarmStartApps();
+        QStringList warmStartDirectories();
 
         playsurface::Playsurface * parent_;
         io::DirectoryReader * directoryReader_;
@@ -130,16 +175,30 @@ namespace app
         app::AppInfo * bigBlobbyInfo_,
                      * touchHooksInfo_,
                      * flashPlayerInfo_;
-        app::AppInfoList * appInfoList_;
+        app::AppInfoList * appInfoList_,
+                         * scanAppInfoList_;
+        QTimer * scanProgressTimer_;
+        int publishedScanCount_;
+        app::AppPrefetcher * appPrefetcher_;
+        QStringList warmStartApps_;
+        utils::StopWatch * launchStopWatch_;
+        app::LaunchTimeline * currentLaunch_;
+        app::LaunchStats * launchStats_;
+        QFutureWatcher<bool> * launchStatsWatcher_;
+        app::TuioGeneratorSupervisor * tuioGeneratorSupervisor_;
 
         utils::WindowUtility * windowUtility_;
+        utils::WindowReadiness * windowReadiness_;
         utils::EdgeGesturesUtility * edgeGesturesUtility_;
         QProcess * bigBlobbyProcess_,
                  * touchHooksProcess_,
                  * multitouchProcess_;
         enums::TuioSourceEnum::Enum tuioGenerator_;
         bool hideBigBlobbyAfterStartup_,
-             hideTouchHooks2TuioAfterStartup_;
+             hideTouchHooks2TuioAfterStartup_,
+             reportErrorsWhenRead_,
+             warmStart_,
+             launchStatsChanged_;
     };
 }
 
@@ -0,0 +1,250 @@
+/*******************************************************************************
+AppPrefetcher
+
+PURPOSE: Reads the executables and DLLs of frequently used multitouch apps into
+         the file cache ahead of time, so that they start faster.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "app/AppPrefetcher.h"
+#include "logger/FileLogger.h"
+#include "utils/StopWatch.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QTimer>
+#include <QtConcurrentRun>
+
+using app::AppPrefetcher;
+
+const qint64 AppPrefetcher::MAX_BYTES_PER_APP = 512 * 1024 * 1024;
+const int AppPrefetcher::PAGE_SIZE = 4096,
+          AppPrefetcher::EXPIRY_MILLISEC = 30 * 60 * 1000,
+          AppPrefetcher::EXPIRY_CHECK_MILLISEC = 60 * 1000;
+const QStringList AppPrefetcher::PREFETCHED_SUFFIXES = QStringList() 
+    << "exe" << "dll" << "swf" << "assets" << "ress" << "unity3d";
+
+AppPrefetcher::Result::Result() :
+  directory(),
+  fileCount( 0 ),
+  bytes( 0 ),
+  seconds( 0.0 )
+{
+}
+
+AppPrefetcher::AppPrefetcher( QObject * parent ) :
+  QObject( parent ),
+  watcher_( new QFutureWatcher<QList<Result> >( this ) ),
+  queuedDirectories_(),
+  prefetchedDirectories_(),
+  clock_(),
+  expiryTimer_( new QTimer( this ) ),
+  cancelled_( false )
+{
+    clock_.start();
+    connect( watcher_, SIGNAL( finished() ), this, SLOT( onPrefetchFinished() ) );
+    connect( expiryTimer_, SIGNAL( timeout() ), this, SLOT( expireOldDirectories() ) );
+    expiryTimer_->start( EXPIRY_CHECK_MILLISEC );
+}
+
+/***************************************************************************//**
+The worker stops at the next file once it sees the cancel flag, so the wait
+here is short.
+*******************************************************************************/
+AppPrefetcher::~AppPrefetcher()
+{
+    cancel();
+    watcher_->disconnect( this );
+    watcher_->waitForFinished();
+}
+
+/***************************************************************************//**
+Starts prefetching the directories in the background.  If a prefetch is 
+already running, the directories are queued and prefetched after it.  A 
+directory that has been prefetched (and has not expired) is skipped.
+*******************************************************************************/
+void AppPrefetcher::prefetch( const QStringList & directories )
+{
+    for( int i = 0; i < directories.size(); ++i ) {
+        QString directory = directories.at( i );
+
+        if( !prefetchedDirectories_.contains( directory ) && !queuedDirectories_.contains( directory ) ) {
+            queuedDirectories_.append( directory );
+        }
+    }
+    if( !isRunning() && !queuedDirectories_.isEmpty() ) {
+        cancelled_ = false;
+        QStringList directoriesToPrefetch = queuedDirectories_;
+        queuedDirectories_.clear();
+        watcher_->setFuture( QtConcurrent::run( this, &AppPrefetcher::prefetchDirectories, 
+                                                directoriesToPrefetch ) );
+    }
+}
+
+/***************************************************************************//**
+Drops the queued directories and stops the running prefetch at the next file
+(e.g., so that an app being launched does not compete with the prefetch for 
+the disk).
+*******************************************************************************/
+void AppPrefetcher::cancel()
+{
+    cancelled_ = true;
+    queuedDirectories_.clear();
+}
+
+bool AppPrefetcher::isRunning()
+{
+    return watcher_->isRunning();
+}
+
+bool AppPrefetcher::wasPrefetched( const QString & directory )
+{
+    return prefetchedDirectories_.contains( directory );
+}
+
+/***************************************************************************//**
+Called when the files of the directory have changed, so that it is read 
+again the next time it is prefetched.
+*******************************************************************************/
+void AppPrefetcher::forget( const QString & directory )
+{
+    prefetchedDirectories_.remove( directory );
+}
+
+void AppPrefetcher::expireOldDirectories()
+{
+    qint64 now = clock_.elapsed();
+    QHash<QString, qint64>::iterator it = prefetchedDirectories_.begin();
+
+    while( it != prefetchedDirectories_.end() ) {
+        if( now - it.value() >= EXPIRY_MILLISEC ) {
+            it = prefetchedDirectories_.erase( it );
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+/***************************************************************************//**
+Runs on the worker thread.
+*******************************************************************************/
+QList<AppPrefetcher::Result> AppPrefetcher::prefetchDirectories( const QStringList & directories )
+{
+    QList<Result> results;
+
+    for( int i = 0; i < directories.size() && !cancelled_; ++i ) {
+        Result result = prefetchDirectory( directories.at( i ) );
+
+        if( !cancelled_ ) { // A directory cut short is not counted as prefetched.
+            results.append( result );
+        }
+    }
+    return results;
+}
+
+/***************************************************************************//**
+The executable is found first (it is usually at the top of the directory), 
+so it is the first thing read even if the byte limit is reached.
+*******************************************************************************/
+AppPrefetcher::Result AppPrefetcher::prefetchDirectory( const QString & directory )
+{
+    utils::StopWatch stopWatch;
+    stopWatch.start();
+    Result result;
+    result.directory = directory;
+    QDirIterator it( directory, QDir::Files | QDir::Readable, QDirIterator::Subdirectories );
+
+    while( it.hasNext() && result.bytes < MAX_BYTES_PER_APP && !cancelled_ ) {
+        it.next();
+        QFileInfo fileInfo = it.fileInfo();
+
+        if( PREFETCHED_SUFFIXES.contains( fileInfo.suffix().toLower() ) ) {
+            qint64 bytes = touchPages( fileInfo.filePath(), MAX_BYTES_PER_APP - result.bytes );
+
+            if( bytes > 0 ) {
+                result.bytes += bytes;
+                ++result.fileCount;
+            }
+        }
+    }
+    result.seconds = stopWatch.elapsed();
+    return result;
+}
+
+/***************************************************************************//**
+Maps the file and reads one byte from each page, which makes the operating 
+system bring the page into its file cache.  The pages stay cached after the
+file is unmapped.  Returns the number of bytes touched.
+*******************************************************************************/
+qint64 AppPrefetcher::touchPages( const QString & filename, qint64 maxBytes )
+{
+    QFile file( filename );
+
+    if( !file.open( QIODevice::ReadOnly ) ) {
+        return 0;
+    }
+    qint64 size = qMin( file.size(), maxBytes );
+    uchar * data = (size > 0) ? file.map( 0, size ) : NULL;
+
+    if( data == NULL ) {
+        return 0;
+    }
+    volatile uchar checksum = 0; // volatile, so the reads are not optimized away.
+
+    for( qint64 offset = 0; offset < size && !cancelled_; offset += PAGE_SIZE ) {
+        checksum ^= data[offset];
+    }
+    file.unmap( data );
+    return size;
+}
+
+void AppPrefetcher::onPrefetchFinished()
+{
+    QList<Result> results = watcher_->result();
+
+    for( int i = 0; i < results.size(); ++i ) {
+        const Result & result = results.at( i );
+        prefetchedDirectories_.insert( result.directory, clock_.elapsed() );
+        logResult( result );
+        emit directoryPrefetched( result.directory );
+    }
+    if( !queuedDirectories_.isEmpty() ) {
+        prefetch( QStringList() );
+    }
+}
+
+void AppPrefetcher::logResult( const Result & result )
+{
+    QString message = QString( "AppPrefetcher: prefetched %1 files (%2 MB) from %3 in %4 s" )
+                          .arg( result.fileCount )
+                          .arg( result.bytes / (1024.0 * 1024.0), 0, 'f', 1 )
+                          .arg( result.directory )
+                          .arg( result.seconds, 0, 'f', 2 );
+    logger::FileLogger::instance().writeInfo( message.toStdString() );
+}
@@ -0,0 +1,123 @@
+/*******************************************************************************
+AppPrefetcher
+
+PURPOSE: Reads the executables and DLLs of frequently used multitouch apps into
+         the file cache ahead of time, so that they start faster.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef APP_APPPREFETCHER_H
+#define APP_APPPREFETCHER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QList>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <atomic>
+
+class QTimer;
+
+namespace app
+{
+    /***********************************************************************//**
+    Warms up multitouch apps before they are launched by reading the pages
+    of their executables, DLLs, and large data files (Unity assets, Flash 
+    swf files) into the operating system's file cache.  Once the pages are 
+    cached, starting the app does not have to wait for the disk.
+
+    Each file is mapped into memory and one byte is read from every page, 
+    so the files are never copied.  The directories are prefetched one at a
+    time on a single QtConcurrent worker (reading several in parallel would
+    just make a hard drive seek back and forth), and no more than 
+    MAX_BYTES_PER_APP is read for any one app.  The apps themselves are not
+    started ahead of time, since a running app would take the TUIO port and 
+    the full screen.
+
+    A prefetched directory is remembered for EXPIRY_MILLISEC only, since the
+    operating system drops pages from its file cache as other files are 
+    read; after that it is prefetched again the next time it is asked for.
+    ***************************************************************************/
+    class AppPrefetcher : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        static const qint64 MAX_BYTES_PER_APP;
+        static const int PAGE_SIZE,
+                         EXPIRY_MILLISEC,
+                         EXPIRY_CHECK_MILLISEC;
+        static const QStringList PREFETCHED_SUFFIXES;
+
+        /*******************************************************************//**
+        What was read for one app directory.
+        ***********************************************************************/
+        class Result
+        {
+        public:
+            Result();
+
+            QString directory;
+            int fileCount;
+            qint64 bytes;
+            double seconds;
+        };
+
+        AppPrefetcher( QObject * parent = NULL );
+        virtual ~AppPrefetcher();
+
+        void prefetch( const QStringList & directories );
+        void cancel();
+        bool isRunning();
+        bool wasPrefetched( const QString & directory );
+        void forget( const QString & directory );
+
+    signals:
+        void directoryPrefetched( const QString & directory );
+
+    private slots:
+        void onPrefetchFinished();
+        void expireOldDirectories();
+
+    private:
+        QList<Result> prefetchDirectories( const QStringList & directories );
+        Result prefetchDirectory( const QString & directory );
+        qint64 touchPages( const QString & filename, qint64 maxBytes );
+        void logResult( const Result & result );
+
+        QFutureWatcher<QList<Result> > * watcher_;
+        QStringList queuedDirectories_;
+        QHash<QString, qint64> prefetchedDirectories_;
+        QElapsedTimer clock_;
+        QTimer * expiryTimer_;
+        std::atomic<bool> cancelled_;
+    };
+}
+
+#endif
@@ -0,0 +1,276 @@
+/*******************************************************************************
+LaunchStats
+
+PURPOSE: Keeps a rolling store of multitouch app launch timelines and summarizes
+         them as percentiles, exported as JSON and CSV.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "app/LaunchStats.h"
+#include <QFile>
+#include <QDir>
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+
+using app::LaunchStats;
+using app::LaunchTimeline;
+
+const QString LaunchStats::DATA_DIRECTORY = "Data/Telemetry",
+              LaunchStats::JSON_FILE = "LaunchStats.json",
+              LaunchStats::LAUNCHES_CSV_FILE = "Launches.csv",
+              LaunchStats::SUMMARY_CSV_FILE = "LaunchSummary.csv";
+const int LaunchStats::MAX_LAUNCHES_PER_APP = 100;
+
+LaunchStats::Summary::Summary() :
+  directory(),
+  phase(),
+  count( 0 ),
+  p50( 0.0 ),
+  p90( 0.0 ),
+  p99( 0.0 ),
+  maximum( 0.0 )
+{
+}
+
+/***************************************************************************//**
+Nearest-rank percentile (p from 0 to 100) of values that are already sorted.
+Returns 0 for an empty list.
+*******************************************************************************/
+double LaunchStats::percentile( const std::vector<double> & sortedValues, double p )
+{
+    if( sortedValues.empty() ) {
+        return 0.0;
+    }
+    int rank = (int)std::ceil( p / 100.0 * sortedValues.size() );
+    rank = qBound( 1, rank, (int)sortedValues.size() );
+    return sortedValues.at( rank - 1 );
+}
+
+LaunchStats::LaunchStats() :
+  launches_()
+{
+}
+
+LaunchStats::~LaunchStats()
+{
+}
+
+void LaunchStats::add( const app::LaunchTimeline & timeline )
+{
+    std::deque<LaunchTimeline> & appLaunches = launches_[timeline.directory];
+    appLaunches.push_back( timeline );
+
+    while( (int)appLaunches.size() > MAX_LAUNCHES_PER_APP ) {
+        appLaunches.pop_front();
+    }
+}
+
+int LaunchStats::size() const
+{
+    int n = 0;
+    QMap<QString, std::deque<LaunchTimeline> >::const_iterator it;
+
+    for( it = launches_.begin(); it != launches_.end(); ++it ) {
+        n += (int)it.value().size();
+    }
+    return n;
+}
+
+std::vector<LaunchStats::Summary> LaunchStats::summaries() const
+{
+    std::vector<Summary> summaries;
+    QMap<QString, std::deque<LaunchTimeline> >::const_iterator it;
+
+    for( it = launches_.begin(); it != launches_.end(); ++it ) {
+        for( int phase = 0; phase < LaunchTimeline::NUMBER_OF_PHASES; ++phase ) {
+            std::vector<double> values;
+
+            for( int i = 0; i < (int)it.value().size(); ++i ) {
+                double seconds = it.value().at( i ).seconds( (LaunchTimeline::Phase)phase );
+
+                if( seconds >= 0 ) {
+                    values.push_back( seconds );
+                }
+            }
+            std::sort( values.begin(), values.end() );
+            Summary summary;
+            summary.directory = it.key();
+            summary.phase = LaunchTimeline::phaseName( (LaunchTimeline::Phase)phase );
+            summary.count = (int)values.size();
+            summary.p50 = percentile( values, 50.0 );
+            summary.p90 = percentile( values, 90.0 );
+            summary.p99 = percentile( values, 99.0 );
+            summary.maximum = values.empty() ? 0.0 : values.back();
+            summaries.push_back( summary );
+        }
+    }
+    return summaries;
+}
+
+/***************************************************************************//**
+Returns the directories of (at most) the given number of apps, the most 
+recently launched app first.
+*******************************************************************************/
+QStringList LaunchStats::recentDirectories( int count ) const
+{
+    std::vector<std::pair<QDateTime, QString> > lastLaunches;
+    QMap<QString, std::deque<LaunchTimeline> >::const_iterator it;
+
+    for( it = launches_.begin(); it != launches_.end(); ++it ) {
+        if( !it.value().empty() ) {
+            lastLaunches.push_back( std::make_pair( it.value().back().launchedAt, it.key() ) );
+        }
+    }
+    std::sort( lastLaunches.rbegin(), lastLaunches.rend() );
+    QStringList directories;
+
+    for( int i = 0; i < (int)lastLaunches.size() && i < count; ++i ) {
+        directories.append( lastLaunches.at( i ).second );
+    }
+    return directories;
+}
+
+/***************************************************************************//**
+Runs on a worker thread.  The statistics are passed by value, so the caller 
+can go on adding launches while the files are written.
+*******************************************************************************/
+bool LaunchStats::saveCopy( app::LaunchStats copy )
+{
+    return copy.save();
+}
+
+/***************************************************************************//**
+Reads back the timelines saved by the last run.  Returns false (and leaves 
+the statistics empty) if there is no file or it cannot be parsed.
+*******************************************************************************/
+bool LaunchStats::load()
+{
+    launches_.clear();
+    QFile file( DATA_DIRECTORY + "/" + JSON_FILE );
+
+    if( !file.open( QIODevice::ReadOnly ) ) {
+        return false;
+    }
+    QJsonDocument document = QJsonDocument::fromJson( file.readAll() );
+
+    if( !document.isObject() ) {
+        return false;
+    }
+    QJsonArray launches = document.object().value( "launches" ).toArray();
+
+    for( int i = 0; i < launches.size(); ++i ) {
+        add( LaunchTimeline::fromJson( launches.at( i ).toObject() ) );
+    }
+    return true;
+}
+
+bool LaunchStats::save() const
+{
+    QDir().mkpath( DATA_DIRECTORY );
+    bool ok = writeFile( JSON_FILE, toJson() );
+    ok = writeFile( LAUNCHES_CSV_FILE, launchesCsv().toUtf8() ) && ok;
+    ok = writeFile( SUMMARY_CSV_FILE, summaryCsv().toUtf8() ) && ok;
+    return ok;
+}
+
+QByteArray LaunchStats::toJson() const
+{
+    QJsonArray launches,
+               summaries;
+    QMap<QString, std::deque<LaunchTimeline> >::const_iterator it;
+
+    for( it = launches_.begin(); it != launches_.end(); ++it ) {
+        for( int i = 0; i < (int)it.value().size(); ++i ) {
+            launches.append( it.value().at( i ).toJson() );
+        }
+    }
+    std::vector<Summary> appSummaries = this->summaries();
+
+    for( int i = 0; i < (int)appSummaries.size(); ++i ) {
+        const Summary & summary = appSummaries.at( i );
+        QJsonObject json;
+        json.insert( "directory", summary.directory );
+        json.insert( "phase", summary.phase );
+        json.insert( "count", summary.count );
+        json.insert( "p50", summary.p50 );
+        json.insert( "p90", summary.p90 );
+        json.insert( "p99", summary.p99 );
+        json.insert( "max", summary.maximum );
+        summaries.append( json );
+    }
+    QJsonObject root;
+    root.insert( "launches", launches );
+    root.insert( "summaries", summaries );
+    return QJsonDocument( root ).toJson();
+}
+
+QString LaunchStats::launchesCsv() const
+{
+    QString csv = LaunchTimeline::csvHeader() + "\n";
+    QMap<QString, std::deque<LaunchTimeline> >::const_iterator it;
+
+    for( it = launches_.begin(); it != launches_.end(); ++it ) {
+        for( int i = 0; i < (int)it.value().size(); ++i ) {
+            csv.append( it.value().at( i ).toCsvRow() + "\n" );
+        }
+    }
+    return csv;
+}
+
+QString LaunchStats::summaryCsv() const
+{
+    QString csv = "directory,phase,count,p50,p90,p99,max\n";
+    std::vector<Summary> appSummaries = summaries();
+
+    for( int i = 0; i < (int)appSummaries.size(); ++i ) {
+        const Summary & summary = appSummaries.at( i );
+        csv.append( "\"" + QString( summary.directory ).replace( "\"", "\"\"" ) + "\"," 
+                    + summary.phase + ","
+                    + QString::number( summary.count ) + ","
+                    + QString::number( summary.p50, 'f', 3 ) + ","
+                    + QString::number( summary.p90, 'f', 3 ) + ","
+                    + QString::number( summary.p99, 'f', 3 ) + ","
+                    + QString::number( summary.maximum, 'f', 3 ) + "\n" );
+    }
+    return csv;
+}
+
+bool LaunchStats::writeFile( const QString & filename, const QByteArray & data ) const
+{
+    QSaveFile file( DATA_DIRECTORY + "/" + filename );
+
+    if( !file.open( QIODevice::WriteOnly ) ) {
+        return false;
+    }
+    file.write( data );
+    return file.commit();
+}
@@ -0,0 +1,106 @@
+/*******************************************************************************
+LaunchStats
+
+PURPOSE: Keeps a rolling store of multitouch app launch timelines and summarizes
+         them as percentiles, exported as JSON and CSV.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef APP_LAUNCHSTATS_H
+#define APP_LAUNCHSTATS_H
+
+#include "app/LaunchTimeline.h"
+#include <QString>
+#include <QStringList>
+#include <QMap>
+#include <deque>
+#include <vector>
+
+namespace app
+{
+    /***********************************************************************//**
+    Keeps the timelines of the last MAX_LAUNCHES_PER_APP launches of each 
+    multitouch app (keyed by the app's directory), and summarizes each phase
+    of the launch as percentiles.
+
+    save() writes three files to the DATA_DIRECTORY: the timelines and 
+    summaries as JSON (which load() reads back on the next run, so the 
+    statistics roll over from run to run), the timelines as CSV, and the 
+    summaries as CSV.  saveCopy() does the same for a copy of the 
+    statistics, so that the files can be written on a worker thread.
+    ***************************************************************************/
+    class LaunchStats
+    {
+    public:
+        /*******************************************************************//**
+        The percentiles of one launch phase for one app, in seconds.  Only 
+        the launches that reached the phase are counted.
+        ***********************************************************************/
+        class Summary
+        {
+        public:
+            Summary();
+
+            QString directory,
+                    phase;
+            int count;
+            double p50,
+                   p90,
+                   p99,
+                   maximum;
+        };
+
+        static const QString DATA_DIRECTORY,
+                             JSON_FILE,
+                             LAUNCHES_CSV_FILE,
+                             SUMMARY_CSV_FILE;
+        static const int MAX_LAUNCHES_PER_APP;
+
+        static double percentile( const std::vector<double> & sortedValues, double p );
+        static bool saveCopy( app::LaunchStats copy );
+
+        LaunchStats();
+        virtual ~LaunchStats();
+
+        void add( const app::LaunchTimeline & timeline );
+        int size() const;
+        std::vector<Summary> summaries() const;
+        QStringList recentDirectories( int count ) const;
+        bool load();
+        bool save() const;
+
+    private:
+        QByteArray toJson() const;
+        QString launchesCsv() const;
+        QString summaryCsv() const;
+        bool writeFile( const QString & filename, const QByteArray & data ) const;
+
+        QMap<QString, std::deque<app::LaunchTimeline> > launches_;
+    };
+}
+
+#endif
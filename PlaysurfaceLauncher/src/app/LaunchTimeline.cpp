@@ -0,0 +1,140 @@
+/*******************************************************************************
+LaunchTimeline
+
+PURPOSE: The timeline of one multitouch app launch (process start, first window,
+         focus, first touch, and exit).
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "app/LaunchTimeline.h"
+#include <QStringList>
+
+using app::LaunchTimeline;
+
+const int LaunchTimeline::NOT_REACHED = -1;
+
+QString LaunchTimeline::phaseName( Phase phase )
+{
+    switch( phase ) {
+        case PROCESS_STARTED:    return "processStarted";
+        case FIRST_WINDOW:       return "firstWindow";
+        case WINDOW_AFTER_START: return "windowAfterStart";
+        case FOCUSED:            return "focused";
+        case FIRST_TOUCH:        return "firstTouch";
+        case RUN_TIME:           return "runTime";
+        default:                 return "unknown";
+    }
+}
+
+QString LaunchTimeline::csvHeader()
+{
+    return "directory,launchedAt,prefetched,processStarted,firstWindow,"
+           "focused,firstTouch,runTime,exitCode,outcome";
+}
+
+LaunchTimeline LaunchTimeline::fromJson( const QJsonObject & json )
+{
+    LaunchTimeline timeline;
+    timeline.directory = json.value( "directory" ).toString();
+    timeline.outcome = json.value( "outcome" ).toString();
+    timeline.launchedAt = QDateTime::fromString( json.value( "launchedAt" ).toString(), Qt::ISODate );
+    timeline.prefetched = json.value( "prefetched" ).toBool();
+    timeline.processStarted = json.value( "processStarted" ).toDouble( NOT_REACHED );
+    timeline.firstWindow = json.value( "firstWindow" ).toDouble( NOT_REACHED );
+    timeline.focused = json.value( "focused" ).toDouble( NOT_REACHED );
+    timeline.firstTouch = json.value( "firstTouch" ).toDouble( NOT_REACHED );
+    timeline.runTime = json.value( "runTime" ).toDouble( NOT_REACHED );
+    timeline.exitCode = json.value( "exitCode" ).toInt( NOT_REACHED );
+    return timeline;
+}
+
+LaunchTimeline::LaunchTimeline() :
+  directory(),
+  outcome(),
+  launchedAt(),
+  prefetched( false ),
+  processStarted( NOT_REACHED ),
+  firstWindow( NOT_REACHED ),
+  focused( NOT_REACHED ),
+  firstTouch( NOT_REACHED ),
+  runTime( NOT_REACHED ),
+  exitCode( NOT_REACHED )
+{
+}
+
+/***************************************************************************//**
+WINDOW_AFTER_START is the time from the process start to the first window,
+which is how long the launcher waits before it focuses on the app.
+*******************************************************************************/
+double LaunchTimeline::seconds( Phase phase ) const
+{
+    switch( phase ) {
+        case PROCESS_STARTED:    return processStarted;
+        case FIRST_WINDOW:       return firstWindow;
+        case FOCUSED:            return focused;
+        case FIRST_TOUCH:        return firstTouch;
+        case RUN_TIME:           return runTime;
+        case WINDOW_AFTER_START: 
+            if( processStarted < 0 || firstWindow < 0 ) {
+                return NOT_REACHED;
+            }
+            return firstWindow - processStarted;
+        default:                 return NOT_REACHED;
+    }
+}
+
+QJsonObject LaunchTimeline::toJson() const
+{
+    QJsonObject json;
+    json.insert( "directory", directory );
+    json.insert( "launchedAt", launchedAt.toString( Qt::ISODate ) );
+    json.insert( "prefetched", prefetched );
+    json.insert( "processStarted", processStarted );
+    json.insert( "firstWindow", firstWindow );
+    json.insert( "focused", focused );
+    json.insert( "firstTouch", firstTouch );
+    json.insert( "runTime", runTime );
+    json.insert( "exitCode", exitCode );
+    json.insert( "outcome", outcome );
+    return json;
+}
+
+QString LaunchTimeline::toCsvRow() const
+{
+    QStringList fields;
+    fields << "\"" + QString( directory ).replace( "\"", "\"\"" ) + "\""
+           << launchedAt.toString( Qt::ISODate )
+           << (prefetched ? "true" : "false")
+           << QString::number( processStarted, 'f', 3 )
+           << QString::number( firstWindow, 'f', 3 )
+           << QString::number( focused, 'f', 3 )
+           << QString::number( firstTouch, 'f', 3 )
+           << QString::number( runTime, 'f', 3 )
+           << QString::number( exitCode )
+           << outcome;
+    return fields.join( "," );
+}
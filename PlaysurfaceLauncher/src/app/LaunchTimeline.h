@@ -0,0 +1,92 @@
+/*******************************************************************************
+LaunchTimeline
+
+PURPOSE: The timeline of one multitouch app launch (process start, first window,
+         focus, first touch, and exit).
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef APP_LAUNCHTIMELINE_H
+#define APP_LAUNCHTIMELINE_H
+
+#include <QString>
+#include <QDateTime>
+#include <QJsonObject>
+
+namespace app
+{
+    /***********************************************************************//**
+    The timeline of one multitouch app launch.  All times are in seconds 
+    from the moment the AppLauncher launched the app, and a time of -1 means
+    that the launch never got that far (e.g., the app was closed before it
+    was touched).
+
+    The phases are: the process has started (QProcess::started()), the app
+    has shown its first visible window, the launcher has focused on the app
+    (as soon as the window appeared), and the first touch on the table after
+    the app was opened.
+    ***************************************************************************/
+    class LaunchTimeline
+    {
+    public:
+        enum Phase
+        {
+            PROCESS_STARTED,
+            FIRST_WINDOW,
+            WINDOW_AFTER_START,
+            FOCUSED,
+            FIRST_TOUCH,
+            RUN_TIME,
+            NUMBER_OF_PHASES
+        };
+
+        static const int NOT_REACHED;
+
+        static QString phaseName( Phase phase );
+        static QString csvHeader();
+        static LaunchTimeline fromJson( const QJsonObject & json );
+
+        LaunchTimeline();
+
+        double seconds( Phase phase ) const;
+        QJsonObject toJson() const;
+        QString toCsvRow() const;
+
+        QString directory,
+                outcome;
+        QDateTime launchedAt;
+        bool prefetched;
+        double processStarted,
+               firstWindow,
+               focused,
+               firstTouch,
+               runTime;
+        int exitCode;
+    };
+}
+
+#endif
@@ -0,0 +1,255 @@
+/*******************************************************************************
+TuioGeneratorSupervisor
+
+PURPOSE: Restarts the TUIO generator (BigBlobby or TouchHooks2Tuio) when it
+         crashes or stops sending TUIO frames, and logs how long touch input was
+         lost.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "app/TuioGeneratorSupervisor.h"
+#include "logger/FileLogger.h"
+#include "logger/EventJournal.h"
+#include <QTimer>
+
+using app::TuioGeneratorSupervisor;
+
+const int TuioGeneratorSupervisor::FIRST_RESTART_DELAY_MILLISECONDS = 1000,
+          TuioGeneratorSupervisor::MAX_RESTART_DELAY_MILLISECONDS = 30000,
+          TuioGeneratorSupervisor::MAX_CONSECUTIVE_RESTARTS = 6,
+          TuioGeneratorSupervisor::STABLE_RUN_MILLISECONDS = 60000,
+          TuioGeneratorSupervisor::FRAME_DEADLINE_MILLISECONDS = 5000,
+          TuioGeneratorSupervisor::FIRST_FRAME_DEADLINE_MILLISECONDS = 15000,
+          TuioGeneratorSupervisor::HEALTH_CHECK_MILLISECONDS = 1000;
+
+/***************************************************************************//**
+Returns the delay before restart number restartCount (counting from 0) in a
+row: 1, 2, 4, 8, 16, and then 30 seconds.
+*******************************************************************************/
+int TuioGeneratorSupervisor::restartDelay( int restartCount )
+{
+    int delay = FIRST_RESTART_DELAY_MILLISECONDS;
+
+    for( int i = 0; i < restartCount && delay < MAX_RESTART_DELAY_MILLISECONDS; ++i ) {
+        delay *= 2;
+    }
+    return qMin( delay, MAX_RESTART_DELAY_MILLISECONDS );
+}
+
+TuioGeneratorSupervisor::TuioGeneratorSupervisor( QObject * parent ) :
+  QObject( parent ),
+  clock_(),
+  lastFrameMilliseconds_( -1 ),
+  healthTimer_( new QTimer( this ) ),
+  restartTimer_( new QTimer( this ) ),
+  state_( STOPPED ),
+  name_(),
+  lossReason_(),
+  sendsFramesContinuously_( false ),
+  startedMilliseconds_( 0 ),
+  inputLostMilliseconds_( -1 ),
+  consecutiveRestarts_( 0 )
+{
+    clock_.start();
+    healthTimer_->setInterval( HEALTH_CHECK_MILLISECONDS );
+    restartTimer_->setSingleShot( true );
+    connect( healthTimer_, SIGNAL( timeout() ), this, SLOT( checkHealth() ) );
+    connect( restartTimer_, SIGNAL( timeout() ), this, SLOT( onRestartTimeout() ) );
+}
+
+TuioGeneratorSupervisor::~TuioGeneratorSupervisor()
+{
+}
+
+/***************************************************************************//**
+Called when the generator's process has started (the first time, or after a
+restart).  For a generator that does not send frames continuously, getting
+the process back is the best sign there is that input is back.
+*******************************************************************************/
+void TuioGeneratorSupervisor::generatorStarted( const QString & name, bool sendsFramesContinuously )
+{
+    name_ = name;
+    sendsFramesContinuously_ = sendsFramesContinuously;
+    startedMilliseconds_ = clock_.elapsed();
+    state_ = RUNNING;
+    restartTimer_->stop();
+    healthTimer_->start();
+    journalEvent( logger::EventJournal::TRACKER_STARTED, 0 );
+
+    if( !sendsFramesContinuously_ && inputLostMilliseconds_ >= 0 ) {
+        reportInputRestored( startedMilliseconds_ );
+    }
+}
+
+/***************************************************************************//**
+Called when the generator was stopped on purpose (for example, to switch to
+another generator), so it is not restarted.
+*******************************************************************************/
+void TuioGeneratorSupervisor::generatorStopped()
+{
+    state_ = STOPPED;
+    healthTimer_->stop();
+    restartTimer_->stop();
+    inputLostMilliseconds_ = -1;
+    consecutiveRestarts_ = 0;
+}
+
+/***************************************************************************//**
+Called when the generator crashed, was killed for being wedged, or failed to
+restart.  Schedules a restart and returns true, or returns false if the
+generator is not being supervised (it never started, or was stopped on
+purpose) or the supervisor has given up on it.
+*******************************************************************************/
+bool TuioGeneratorSupervisor::generatorLost( const QString & reason )
+{
+    if( state_ == STOPPED ) {
+        return false;
+    }
+    healthTimer_->stop();
+    markInputLost( clock_.elapsed(), reason );
+
+    if( consecutiveRestarts_ >= MAX_CONSECUTIVE_RESTARTS ) {
+        double downtime = (clock_.elapsed() - inputLostMilliseconds_) / 1000.0;
+        QString message = QString( "TuioGeneratorSupervisor: gave up on %1 after %2 restarts; "
+                                   "no touch input for %3 s" )
+                              .arg( name_ )
+                              .arg( consecutiveRestarts_ )
+                              .arg( downtime, 0, 'f', 1 );
+        logger::FileLogger::instance().writeError( message.toStdString() );
+        journalEvent( logger::EventJournal::TRACKER_GAVE_UP, consecutiveRestarts_ );
+        generatorStopped();
+        return false;
+    }
+    int delay = restartDelay( consecutiveRestarts_ );
+    ++consecutiveRestarts_;
+    state_ = RESTARTING;
+    restartTimer_->start( delay );
+    return true;
+}
+
+/***************************************************************************//**
+Called by the QTuio, on the thread that receives TUIO messages, for every
+TUIO frame.
+*******************************************************************************/
+void TuioGeneratorSupervisor::frameReceived()
+{
+    lastFrameMilliseconds_.store( clock_.elapsed() );
+}
+
+bool TuioGeneratorSupervisor::isInputLost()
+{
+    return inputLostMilliseconds_ >= 0;
+}
+
+int TuioGeneratorSupervisor::consecutiveRestarts()
+{
+    return consecutiveRestarts_;
+}
+
+void TuioGeneratorSupervisor::checkHealth()
+{
+    if( state_ != RUNNING ) {
+        return;
+    }
+    qint64 now = clock_.elapsed(),
+           lastFrame = lastFrameMilliseconds_.load();
+
+    if( sendsFramesContinuously_ ) {
+        bool hasSentFrame = (lastFrame >= startedMilliseconds_);
+
+        if( hasSentFrame && inputLostMilliseconds_ >= 0 ) {
+            reportInputRestored( lastFrame );
+        }
+        qint64 since = hasSentFrame ? lastFrame : startedMilliseconds_;
+        int deadline = hasSentFrame ? FRAME_DEADLINE_MILLISECONDS : FIRST_FRAME_DEADLINE_MILLISECONDS;
+
+        if( now - since > deadline ) {
+            healthTimer_->stop();
+            markInputLost( since, "stopped sending TUIO frames" );
+            emit generatorWedged();
+            return;
+        }
+    }
+    if( consecutiveRestarts_ > 0
+        && inputLostMilliseconds_ < 0
+        && now - startedMilliseconds_ > STABLE_RUN_MILLISECONDS )
+    {
+        consecutiveRestarts_ = 0;
+    }
+}
+
+void TuioGeneratorSupervisor::onRestartTimeout()
+{
+    if( state_ == RESTARTING ) {
+        QString message = QString( "TuioGeneratorSupervisor: restarting %1 (restart %2 of %3)" )
+                              .arg( name_ )
+                              .arg( consecutiveRestarts_ )
+                              .arg( MAX_CONSECUTIVE_RESTARTS );
+        logger::FileLogger::instance().writeInfo( message.toStdString() );
+        journalEvent( logger::EventJournal::TRACKER_RESTARTING, consecutiveRestarts_ );
+        emit restartDue();
+    }
+}
+
+/***************************************************************************//**
+Only the first loss counts, so that a restart that fails does not move the
+start of the downtime.
+*******************************************************************************/
+void TuioGeneratorSupervisor::markInputLost( qint64 sinceMilliseconds, const QString & reason )
+{
+    if( inputLostMilliseconds_ >= 0 ) {
+        return;
+    }
+    inputLostMilliseconds_ = sinceMilliseconds;
+    lossReason_ = reason;
+    QString message = QString( "TuioGeneratorSupervisor: touch input lost, %1 %2" )
+                          .arg( name_ )
+                          .arg( reason );
+    logger::FileLogger::instance().writeWarning( message.toStdString() );
+    journalEvent( logger::EventJournal::TRACKER_LOST, consecutiveRestarts_ );
+}
+
+void TuioGeneratorSupervisor::reportInputRestored( qint64 atMilliseconds )
+{
+    double downtime = (atMilliseconds - inputLostMilliseconds_) / 1000.0;
+    QString message = QString( "TuioGeneratorSupervisor: touch input restored after %1 s "
+                               "(%2 %3, %4 restarts)" )
+                          .arg( downtime, 0, 'f', 1 )
+                          .arg( name_ )
+                          .arg( lossReason_ )
+                          .arg( consecutiveRestarts_ );
+    logger::FileLogger::instance().writeInfo( message.toStdString() );
+    journalEvent( logger::EventJournal::TRACKER_RESTORED, (int)(atMilliseconds - inputLostMilliseconds_) );
+    inputLostMilliseconds_ = -1;
+    lossReason_.clear();
+}
+
+void TuioGeneratorSupervisor::journalEvent( int type, int value )
+{
+    logger::EventJournal::instance().recordText( (logger::EventJournal::EventType)type, value,
+                                                 name_.toStdString() );
+}
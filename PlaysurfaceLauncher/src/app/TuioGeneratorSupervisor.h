@@ -0,0 +1,129 @@
+/*******************************************************************************
+TuioGeneratorSupervisor
+
+PURPOSE: Restarts the TUIO generator (BigBlobby or TouchHooks2Tuio) when it
+         crashes or stops sending TUIO frames, and logs how long touch input was
+         lost.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef APP_TUIOGENERATORSUPERVISOR_H
+#define APP_TUIOGENERATORSUPERVISOR_H
+
+#include <QObject>
+#include <QString>
+#include <QElapsedTimer>
+#include <atomic>
+
+class QTimer;
+
+namespace app
+{
+    /***********************************************************************//**
+    Keeps the TUIO generator (BigBlobby or TouchHooks2Tuio) running, so that
+    the table does not stay dead until someone walks over with a mouse.
+
+    The supervisor does not own the generator's QProcess.  The AppLauncher
+    tells it when the generator has started, when it was stopped on purpose,
+    and when it was lost (crashed or failed to restart).  A lost generator
+    is restarted (with a restartDue() signal) after an exponential backoff
+    of FIRST_RESTART_DELAY_MILLISECONDS, doubled for each restart in a row
+    up to MAX_RESTART_DELAY_MILLISECONDS.  After MAX_CONSECUTIVE_RESTARTS
+    the supervisor gives up, and the AppLauncher falls back to its dialog
+    box.  A generator that stays up for STABLE_RUN_MILLISECONDS starts over
+    with the shortest delay.
+
+    A camera tracker (BigBlobby) sends a TUIO frame (an fseq message) for
+    every camera frame, even when nothing touches the table, so for it the
+    supervisor also checks that frames keep arriving.  The QTuio calls
+    frameReceived() on the thread that receives the TUIO messages, which
+    only stores the time in an atomic.  If no frame arrives for
+    FRAME_DEADLINE_MILLISECONDS (or FIRST_FRAME_DEADLINE_MILLISECONDS after
+    a start, since the camera takes a while to open), the generator is
+    reported as wedged (with a generatorWedged() signal), so that it can be
+    killed and restarted.  TouchHooks2Tuio only sends frames while there are
+    touches, so only its process is supervised.
+
+    The time from losing input (the crash, or the last frame of a wedged
+    tracker) until input is back (the first frame after the restart, or
+    the restart itself for TouchHooks2Tuio) is logged as the downtime.
+    ***************************************************************************/
+    class TuioGeneratorSupervisor : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        static const int FIRST_RESTART_DELAY_MILLISECONDS,
+                         MAX_RESTART_DELAY_MILLISECONDS,
+                         MAX_CONSECUTIVE_RESTARTS,
+                         STABLE_RUN_MILLISECONDS,
+                         FRAME_DEADLINE_MILLISECONDS,
+                         FIRST_FRAME_DEADLINE_MILLISECONDS,
+                         HEALTH_CHECK_MILLISECONDS;
+
+        static int restartDelay( int restartCount );
+
+        TuioGeneratorSupervisor( QObject * parent = NULL );
+        virtual ~TuioGeneratorSupervisor();
+
+        void generatorStarted( const QString & name, bool sendsFramesContinuously );
+        void generatorStopped();
+        bool generatorLost( const QString & reason );
+        void frameReceived();
+        bool isInputLost();
+        int consecutiveRestarts();
+
+    signals:
+        void restartDue();
+        void generatorWedged();
+
+    private slots:
+        void checkHealth();
+        void onRestartTimeout();
+
+    private:
+        enum State { STOPPED, RUNNING, RESTARTING };
+
+        void markInputLost( qint64 sinceMilliseconds, const QString & reason );
+        void reportInputRestored( qint64 atMilliseconds );
+        void journalEvent( int type, int value );
+
+        QElapsedTimer clock_;
+        std::atomic<qint64> lastFrameMilliseconds_;
+        QTimer * healthTimer_,
+               * restartTimer_;
+        State state_;
+        QString name_,
+                lossReason_;
+        bool sendsFramesContinuously_;
+        qint64 startedMilliseconds_,
+               inputLostMilliseconds_;
+        int consecutiveRestarts_;
+    };
+}
+
+#endif
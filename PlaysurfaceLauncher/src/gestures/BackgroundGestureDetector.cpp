@@ -0,0 +1,126 @@
+/*******************************************************************************
+BackgroundGestureDetector
+
+PURPOSE: Detects the plus sign (quit) gesture on the TUIO receive thread while a
+         multitouch app is open.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "gestures/BackgroundGestureDetector.h"
+#include "gestures/GestureDetector.h"
+#include "logger/EventJournal.h"
+#include "metrics/Metrics.h"
+
+using gestures::BackgroundGestureDetector;
+
+BackgroundGestureDetector::BackgroundGestureDetector( QObject * parent ) :
+  QObject( parent ),
+  gestureDetector_( new gestures::GestureDetector() ),
+  enabled_( false ),
+  clearRequested_( false ),
+  firstTouchPending_( false ),
+  detectingPlusSign_( false )
+{
+}
+
+BackgroundGestureDetector::~BackgroundGestureDetector()
+{
+    gestureDetector_->clear();
+    delete gestureDetector_;
+}
+
+/***************************************************************************//**
+Any lines left over from an earlier app session are thrown away (by the 
+receiving thread, the next time it hands over a touch), so they cannot be 
+combined with new lines to make a plus sign.
+*******************************************************************************/
+void BackgroundGestureDetector::setEnabled( bool b )
+{
+    if( b && !enabled_.load() ) {
+        clearRequested_.store( true );
+        firstTouchPending_.store( true );
+    }
+    enabled_.store( b );
+}
+
+bool BackgroundGestureDetector::isEnabled()
+{
+    return enabled_.load();
+}
+
+void BackgroundGestureDetector::setDetectingPlusSign( bool b )
+{
+    detectingPlusSign_.store( b );
+}
+
+/***************************************************************************//**
+Whether a stroke is recognized is decided when it starts.  The updates and 
+the finish of a stroke that was never started are ignored by the 
+GestureDetector, so turning detection on or off never splits a stroke.
+*******************************************************************************/
+void BackgroundGestureDetector::startGesture( int id, double x, double y )
+{
+    clearIfRequested();
+
+    if( firstTouchPending_.exchange( false ) ) {
+        emit firstTouch();
+    }
+    if( detectingPlusSign_.load() ) {
+        gestureDetector_->startGesture( id, x, y );
+    }
+}
+
+void BackgroundGestureDetector::updateGesture( int id, double x, double y )
+{
+    clearIfRequested();
+    gestureDetector_->updateGesture( id, x, y );
+}
+
+/***************************************************************************//**
+The detector turns itself off when the plus sign is found, so that the next 
+touches go to the GUI thread (where the confirm exit box will be showing).
+*******************************************************************************/
+void BackgroundGestureDetector::finishGesture( int id, double x, double y )
+{
+    clearIfRequested();
+
+    if( gestureDetector_->finishGestureAndTestForPlusSign( id, x, y ) ) {
+        enabled_.store( false );
+        logger::EventJournal::instance().record( logger::EventJournal::GESTURE, 
+                                                 logger::EventJournal::PLUS_SIGN_GESTURE, 
+                                                 (int)x, (int)y );
+        metrics::Metrics::instance().plusSignGestures.increment();
+        emit quitGestureRecognized();
+    }
+}
+
+void BackgroundGestureDetector::clearIfRequested()
+{
+    if( clearRequested_.exchange( false ) ) {
+        gestureDetector_->clear();
+    }
+}
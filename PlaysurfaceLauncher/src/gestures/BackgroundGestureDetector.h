@@ -0,0 +1,91 @@
+/*******************************************************************************
+BackgroundGestureDetector
+
+PURPOSE: Detects the plus sign (quit) gesture on the TUIO receive thread while a
+         multitouch app is open.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef GESTURES_BACKGROUNDGESTUREDETECTOR_H
+#define GESTURES_BACKGROUNDGESTUREDETECTOR_H
+
+#include <QObject>
+#include <atomic>
+
+namespace gestures { class GestureDetector; }
+
+namespace gestures
+{
+    /***********************************************************************//**
+    Looks for the plus sign (quit) gesture while a multitouch app is open.  
+    The start/update/finish functions are called directly by the thread that
+    receives TUIO messages, so no QTouchEvent has to be built, posted, and 
+    handled on the GUI thread while the launcher sits behind a fullscreen app.
+    The only things that cross over to the GUI thread are the 
+    quitGestureRecognized() signal and the firstTouch() signal (emitted 
+    once each time the detector is turned on), through queued connections.
+    
+    While the plus sign is not being used to quit apps, the touches are still
+    taken off the GUI thread (and firstTouch() is still emitted), but no 
+    lines are recognized.
+
+    setEnabled() and setDetectingPlusSign() may be called from any thread.
+    All other functions must be called from the one thread that feeds 
+    touches to the detector.
+    ***************************************************************************/
+    class BackgroundGestureDetector : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        BackgroundGestureDetector( QObject * parent = 0 );
+        virtual ~BackgroundGestureDetector();
+
+        void setEnabled( bool b );
+        bool isEnabled();
+        void setDetectingPlusSign( bool b );
+
+        void startGesture( int id, double x, double y );
+        void updateGesture( int id, double x, double y );
+        void finishGesture( int id, double x, double y );
+
+    signals:
+        void quitGestureRecognized();
+        void firstTouch();
+
+    private:
+        void clearIfRequested();
+
+        gestures::GestureDetector * gestureDetector_;
+        std::atomic<bool> enabled_,
+                          clearRequested_,
+                          firstTouchPending_,
+                          detectingPlusSign_;
+    };
+}
+
+#endif
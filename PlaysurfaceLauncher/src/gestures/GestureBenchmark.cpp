@@ -0,0 +1,391 @@
+/*******************************************************************************
+GestureBenchmark
+
+PURPOSE: Measures the accuracy and speed of the GestureDetector by replaying a
+         corpus of labelled strokes.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "gestures/GestureBenchmark.h"
+#include "gestures/GestureDetector.h"
+#include "gestures/GestureParams.h"
+#include "gui/XmlSettings.h"
+#include "xml/SettingsXmlReader.h"
+#include "xml/SettingsValidator.h"
+#include "exceptions/FileNotFoundException.h"
+#include "exceptions/SettingsXmlReaderException.h"
+#include "exceptions/UnknownXmlTagException.h"
+#include <QFile>
+#include <QIODevice>
+#include <QElapsedTimer>
+#include <QtXml/QDomDocument>
+#include <QtXml/QDomNode>
+#include <iomanip>
+
+using gestures::GestureBenchmark;
+using exceptions::FileNotFoundException;
+using exceptions::SettingsXmlReaderException;
+using exceptions::UnknownXmlTagException;
+using exceptions::IOException;
+
+const QString GestureBenchmark::COMMAND_LINE_ARG = "-benchmarkgestures",
+              GestureBenchmark::DEFAULT_CORPUS_FILE = "Data/Gestures/GestureCorpus.xml";
+
+const int GestureBenchmark::DEFAULT_ITERATIONS = 1000;
+
+bool GestureBenchmark::isBenchmarkRequested( int argc, char * argv[] )
+{
+    if( argc > 1 ) {
+        QString arg = argv[1];
+        return (arg.compare( COMMAND_LINE_ARG, Qt::CaseInsensitive ) == 0);
+    }
+    return false;
+}
+
+/***************************************************************************//**
+Command line usage:
+
+    PlaysurfaceLauncher.exe -benchmarkgestures [corpusFile] [iterations]
+
+The <Gestures> thresholds from the settings file are used, so the effect of
+a change to the XML file can be measured before it goes onto a table.
+Returns 0 on success, or 1 if the corpus could not be read.
+*******************************************************************************/
+int GestureBenchmark::run( int argc, char * argv[], std::ostream & out )
+{
+    QString corpusFile = (argc > 2) ? QString( argv[2] ) : DEFAULT_CORPUS_FILE;
+    int iterations = (argc > 3) ? QString( argv[3] ).toInt() : DEFAULT_ITERATIONS;
+    if( iterations < 1 ) { iterations = DEFAULT_ITERATIONS; }
+    useGestureParamsFromSettingsFile( gui::XmlSettings::DEFAULT_CONFIG_FILE );
+
+    GestureBenchmark benchmark;
+
+    try {
+        benchmark.readCorpusFile( corpusFile );
+    }
+    catch( IOException & e ) {
+        out << "Unable to read gesture corpus " << corpusFile.toStdString() << "\n"
+            << e.getMessage().toStdString() << " (" << e.getSource().toStdString() << ")\n";
+        return 1;
+    }
+    benchmark.measureAccuracy();
+    benchmark.measureSpeed( iterations );
+    benchmark.printReport( out );
+    return 0;
+}
+
+/***************************************************************************//**
+Any problem with the settings file is ignored here (the launcher itself will 
+report it), and the values that could be validated are still used.
+*******************************************************************************/
+void GestureBenchmark::useGestureParamsFromSettingsFile( const QString & xmlFile )
+{
+    xml::SettingsXmlReader reader;
+    xml::SettingsValidator validator;
+
+    try {
+        reader.read( xmlFile, &validator );
+    }
+    catch( IOException & ) {
+    }
+    gestures::GestureParams params( validator.gestureMinNumPoints(),
+                                    validator.gestureExpirationMilliseconds(),
+                                    validator.gestureValidLineAspectRatio(),
+                                    validator.gestureToleranceFactor() );
+    gestures::GestureParams::publish( params );
+}
+
+GestureBenchmark::GestureBenchmark() :
+  samples_(),
+  iterations_( 0 ),
+  numStrokes_( 0 ),
+  numPoints_( 0 ),
+  totalNanoseconds_( 0.0 ),
+  xmlFile_( "unknown" )
+{
+    for( int i = 0; i < NUMBER_OF_LABELS; ++i ) {
+        for( int j = 0; j < NUMBER_OF_LABELS; ++j ) {
+            confusion_[i][j] = 0;
+        }
+    }
+}
+
+GestureBenchmark::~GestureBenchmark()
+{
+}
+
+void GestureBenchmark::readCorpusFile( const QString & xmlFile )
+{
+    xmlFile_ = xmlFile;
+    samples_.clear();
+    numStrokes_ = 0;
+    numPoints_ = 0;
+
+    QFile file( xmlFile_ );
+    QDomDocument doc;
+    QString err;
+    int line = 0,
+        col = 0;
+
+    if( !file.open( QIODevice::ReadOnly ) ) {
+        QString msg( "The gesture corpus file could not be found." );
+        throw FileNotFoundException( msg, "GestureBenchmark::readCorpusFile()", xmlFile_ );
+    }
+    if( !doc.setContent( file.readAll(), &err, &line, &col ) ) {
+        QString msg( "An error occurred while reading the gesture corpus file." );
+        throw SettingsXmlReaderException( msg, "GestureBenchmark::readCorpusFile()",
+                                          err, line, col, xmlFile_ );
+    }
+    QDomElement root = doc.documentElement();
+
+    if( root.tagName().trimmed().compare( "GestureCorpus", Qt::CaseInsensitive ) != 0 ) {
+        QString msg( "Unrecognized XML tag found." );
+        throw UnknownXmlTagException( msg, "GestureBenchmark::readCorpusFile()",
+                                      root.tagName(), xmlFile_ );
+    }
+    for( QDomNode node = root.firstChild(); !node.isNull(); node = node.nextSibling() ) {
+        if( node.isElement() ) {
+            QDomElement element = node.toElement();
+            readSample( element );
+        }
+    }
+}
+
+void GestureBenchmark::readSample( QDomElement & element )
+{
+    if( element.tagName().trimmed().compare( "Sample", Qt::CaseInsensitive ) != 0 ) {
+        QString msg( "Unrecognized XML tag found." );
+        throw UnknownXmlTagException( msg, "GestureBenchmark::readSample()",
+                                      element.tagName(), xmlFile_ );
+    }
+    Sample sample;
+    sample.label = convertToLabel( element.attribute( "label" ) );
+
+    for( QDomNode node = element.firstChild(); !node.isNull(); node = node.nextSibling() ) {
+        if( node.isElement() ) {
+            QDomElement strokeElement = node.toElement();
+            sample.strokes.push_back( readStroke( strokeElement ) );
+        }
+    }
+    if( !sample.strokes.empty() ) {
+        samples_.push_back( sample );
+    }
+}
+
+GestureBenchmark::Stroke GestureBenchmark::readStroke( QDomElement & element )
+{
+    if( element.tagName().trimmed().compare( "Stroke", Qt::CaseInsensitive ) != 0 ) {
+        QString msg( "Unrecognized XML tag found." );
+        throw UnknownXmlTagException( msg, "GestureBenchmark::readStroke()",
+                                      element.tagName(), xmlFile_ );
+    }
+    Stroke stroke;
+
+    for( QDomNode node = element.firstChild(); !node.isNull(); node = node.nextSibling() ) {
+        if( node.isElement() ) {
+            QDomElement point = node.toElement();
+            stroke.xs.push_back( point.attribute( "x" ).toDouble() );
+            stroke.ys.push_back( point.attribute( "y" ).toDouble() );
+        }
+    }
+    if( stroke.xs.empty() ) {
+        QString msg( "A <Stroke> element must contain at least one <Point>." );
+        throw UnknownXmlTagException( msg, "GestureBenchmark::readStroke()",
+                                      element.tagName(), xmlFile_ );
+    }
+    ++numStrokes_;
+    numPoints_ += (int)stroke.xs.size();
+    return stroke;
+}
+
+GestureBenchmark::Label GestureBenchmark::convertToLabel( const QString & text )
+{
+    QString label = text.trimmed().toLower();
+
+    if( label == "horizontal" ) { return HORIZONTAL; }
+    if( label == "vertical" ) { return VERTICAL; }
+    if( label == "plus" ) { return PLUS_SIGN; }
+    if( label == "neither" ) { return NEITHER; }
+
+    QString msg( "A <Sample> label must be horizontal, vertical, plus, or neither." );
+    throw UnknownXmlTagException( msg, "GestureBenchmark::convertToLabel()",
+                                  "label=\"" + text + "\"", xmlFile_ );
+}
+
+void GestureBenchmark::measureAccuracy()
+{
+    for( int i = 0; i < NUMBER_OF_LABELS; ++i ) {
+        for( int j = 0; j < NUMBER_OF_LABELS; ++j ) {
+            confusion_[i][j] = 0;
+        }
+    }
+    for( size_t i = 0; i < samples_.size(); ++i ) {
+        Label predicted = replaySample( samples_[i] );
+        ++confusion_[samples_[i].label][predicted];
+    }
+}
+
+/***************************************************************************//**
+Replays the whole corpus the given number of times and keeps the total time.
+Each sample gets its own detector, so that a stroke from one sample can
+never combine with a stroke from another sample to make a plus sign.
+*******************************************************************************/
+void GestureBenchmark::measureSpeed( int iterations )
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    for( int n = 0; n < iterations; ++n ) {
+        for( size_t i = 0; i < samples_.size(); ++i ) {
+            replaySample( samples_[i] );
+        }
+    }
+    totalNanoseconds_ = (double)timer.nsecsElapsed();
+    iterations_ = iterations;
+}
+
+GestureBenchmark::Label GestureBenchmark::replaySample( Sample & sample )
+{
+    gestures::GestureDetector detector;
+    gestures::GestureResult result;
+    int numStrokes = (int)sample.strokes.size();
+
+    for( int id = 0; id < numStrokes; ++id ) {
+        Stroke & stroke = sample.strokes[id];
+        int last = (int)stroke.xs.size() - 1;
+
+        detector.startGesture( id, stroke.xs[0], stroke.ys[0] );
+
+        for( int i = 1; i < last; ++i ) {
+            detector.updateGesture( id, stroke.xs[i], stroke.ys[i] );
+        }
+        result = detector.finishGestureAndCalculateResult( id, stroke.xs[last], stroke.ys[last] );
+    }
+    detector.clear();
+    return classify( result );
+}
+
+GestureBenchmark::Label GestureBenchmark::classify( gestures::GestureResult & result )
+{
+    if( result.isPlusSign() ) { return PLUS_SIGN; }
+    if( result.isHorizontalLine() ) { return HORIZONTAL; }
+    if( result.isVerticalLine() ) { return VERTICAL; }
+    return NEITHER;
+}
+
+double GestureBenchmark::precision( int label )
+{
+    int truePositives = confusion_[label][label],
+        predicted = 0;
+
+    for( int i = 0; i < NUMBER_OF_LABELS; ++i ) {
+        predicted += confusion_[i][label];
+    }
+    return (predicted > 0) ? (double)truePositives / predicted : 0.0;
+}
+
+double GestureBenchmark::recall( int label )
+{
+    int truePositives = confusion_[label][label],
+        actual = 0;
+
+    for( int i = 0; i < NUMBER_OF_LABELS; ++i ) {
+        actual += confusion_[label][i];
+    }
+    return (actual > 0) ? (double)truePositives / actual : 0.0;
+}
+
+const char * GestureBenchmark::labelName( int label )
+{
+    switch( label ) {
+        case HORIZONTAL: return "horizontal";
+        case VERTICAL:   return "vertical";
+        case PLUS_SIGN:  return "plus";
+        default:         return "neither";
+    }
+}
+
+void GestureBenchmark::printReport( std::ostream & out )
+{
+    std::shared_ptr<const gestures::GestureParams> params = gestures::GestureParams::current();
+
+    out << "\nGesture benchmark: " << xmlFile_.toStdString() << "\n"
+        << "samples = " << numberOfSamples()
+        << "; strokes = " << numberOfStrokes()
+        << "; points = " << numberOfPoints() << "\n"
+        << "MinNumPoints = " << params->minNumPoints()
+        << "; ValidLineAspectRatio = " << params->validLineAspectRatio()
+        << "; ToleranceFactor = " << params->toleranceFactor() << "\n\n"
+        << std::left << std::setw( 12 ) << "label"
+        << std::right << std::setw( 8 ) << "count"
+        << std::setw( 12 ) << "precision"
+        << std::setw( 10 ) << "recall" << "\n"
+        << std::fixed << std::setprecision( 3 );
+
+    for( int label = 0; label < NUMBER_OF_LABELS; ++label ) {
+        int count = 0;
+        for( int i = 0; i < NUMBER_OF_LABELS; ++i ) { count += confusion_[label][i]; }
+
+        out << std::left << std::setw( 12 ) << labelName( label )
+            << std::right << std::setw( 8 ) << count
+            << std::setw( 12 ) << precision( label )
+            << std::setw( 10 ) << recall( label ) << "\n";
+    }
+    out << "\nconfusion (rows = expected, columns = detected)\n" << std::setw( 12 ) << "";
+    for( int j = 0; j < NUMBER_OF_LABELS; ++j ) { out << std::setw( 12 ) << labelName( j ); }
+    out << "\n";
+
+    for( int i = 0; i < NUMBER_OF_LABELS; ++i ) {
+        out << std::left << std::setw( 12 ) << labelName( i ) << std::right;
+        for( int j = 0; j < NUMBER_OF_LABELS; ++j ) { out << std::setw( 12 ) << confusion_[i][j]; }
+        out << "\n";
+    }
+    if( iterations_ > 0 && numPoints_ > 0 ) {
+        double totalStrokes = (double)numStrokes_ * iterations_,
+               totalPoints = (double)numPoints_ * iterations_;
+
+        out << "\niterations = " << iterations_ << std::setprecision( 1 )
+            << "\nns/point  = " << totalNanoseconds_ / totalPoints
+            << "\nns/stroke = " << totalNanoseconds_ / totalStrokes << "\n";
+    }
+    out.flush();
+}
+
+int GestureBenchmark::numberOfSamples()
+{
+    return (int)samples_.size();
+}
+
+int GestureBenchmark::numberOfStrokes()
+{
+    return numStrokes_;
+}
+
+int GestureBenchmark::numberOfPoints()
+{
+    return numPoints_;
+}
@@ -0,0 +1,121 @@
+/*******************************************************************************
+GestureBenchmark
+
+PURPOSE: Measures the accuracy and speed of the GestureDetector by replaying a
+         corpus of labelled strokes.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef GESTURES_GESTUREBENCHMARK_H
+#define GESTURES_GESTUREBENCHMARK_H
+
+#include "gestures/GestureResult.h"
+#include <QString>
+#include <QtXml/QDomElement>
+#include <ostream>
+#include <vector>
+
+namespace gestures
+{
+    /***********************************************************************//**
+    Replays a corpus of recorded strokes through a GestureDetector and reports
+    precision/recall for each label, along with the cost of recognition in
+    nanoseconds per point and per stroke.  The corpus is an XML file in which
+    each <Sample> holds one or more <Stroke> elements, and the label of the
+    sample is the expected result for its last stroke (horizontal, vertical,
+    plus, or neither).
+    ***************************************************************************/
+    class GestureBenchmark
+    {
+    public:
+        enum Label {
+            HORIZONTAL,
+            VERTICAL,
+            PLUS_SIGN,
+            NEITHER,
+            NUMBER_OF_LABELS
+        };
+
+        static const QString COMMAND_LINE_ARG,
+                             DEFAULT_CORPUS_FILE;
+        static const int DEFAULT_ITERATIONS;
+
+        static bool isBenchmarkRequested( int argc, char * argv[] );
+        static int run( int argc, char * argv[], std::ostream & out );
+        static void useGestureParamsFromSettingsFile( const QString & xmlFile );
+
+        GestureBenchmark();
+        virtual ~GestureBenchmark();
+
+        void readCorpusFile( const QString & xmlFile );
+        void measureAccuracy();
+        void measureSpeed( int iterations );
+        void printReport( std::ostream & out );
+
+        int numberOfSamples();
+        int numberOfStrokes();
+        int numberOfPoints();
+
+    private:
+        /*******************************************************************//**
+        The points are kept in two flat arrays so that replaying the corpus
+        in the speed test touches as little memory as possible.
+        ***********************************************************************/
+        class Stroke
+        {
+        public:
+            std::vector<double> xs,
+                                ys;
+        };
+
+        class Sample
+        {
+        public:
+            Label label;
+            std::vector<Stroke> strokes;
+        };
+
+        void readSample( QDomElement & element );
+        Stroke readStroke( QDomElement & element );
+        Label convertToLabel( const QString & text );
+        Label replaySample( Sample & sample );
+        Label classify( gestures::GestureResult & result );
+        double precision( int label );
+        double recall( int label );
+        const char * labelName( int label );
+
+        std::vector<Sample> samples_;
+        int confusion_[NUMBER_OF_LABELS][NUMBER_OF_LABELS];
+        int iterations_,
+            numStrokes_,
+            numPoints_;
+        double totalNanoseconds_;
+        QString xmlFile_;
+    };
+}
+
+#endif
@@ -32,6 +32,7 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 */
 #include "gestures/GestureDetector.h"
 #include "gestures/LineGesture.h"
+#include "gestures/GestureParams.h"
 #include <QMessageBox>
 #include <QFileDialog>
 #include <iostream>
@@ -90,7 +91,8 @@ than once for a touch begin.
 bool GestureDetector::startGesture( int id, double x, double y )
 {
     if( !isIdFoundInGestureList( id ) ) {
-        gestures::LineGesture * gesture = new gestures::LineGesture( id, x, y );
+        std::shared_ptr<const gestures::GestureParams> params = gestures::GestureParams::current();
+        gestures::LineGesture * gesture = new gestures::LineGesture( id, x, y, *params );
         inProgressGestures_.push_back( gesture );
         //std::cout << "id = " << id << " was added to the gesture list.\n";
         return true;
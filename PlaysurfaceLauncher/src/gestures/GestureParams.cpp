@@ -0,0 +1,97 @@
+/*******************************************************************************
+GestureParams
+
+PURPOSE: An immutable snapshot of the gesture detection thresholds that can be
+         swapped atomically at runtime.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "gestures/GestureParams.h"
+
+using gestures::GestureParams;
+
+const int GestureParams::DEFAULT_MIN_NUM_POINTS = 10,
+          GestureParams::DEFAULT_EXPIRATION_MILLISECONDS = 5000;
+
+const double GestureParams::DEFAULT_VALID_LINE_ASPECT_RATIO = 10.0,
+             GestureParams::DEFAULT_TOLERANCE_FACTOR = 0.25;
+
+std::shared_ptr<const GestureParams> GestureParams::current_( new GestureParams() );
+
+/***************************************************************************//**
+Safe to call from any thread.  The returned snapshot stays valid for as long
+as the caller holds on to it, even if a newer one is published meanwhile.
+*******************************************************************************/
+std::shared_ptr<const GestureParams> GestureParams::current()
+{
+    return std::atomic_load( &current_ );
+}
+
+void GestureParams::publish( const GestureParams & params )
+{
+    std::shared_ptr<const GestureParams> snapshot( new GestureParams( params ) );
+    std::atomic_store( &current_, snapshot );
+}
+
+GestureParams::GestureParams() :
+  minNumPoints_( DEFAULT_MIN_NUM_POINTS ),
+  expirationMilliseconds_( DEFAULT_EXPIRATION_MILLISECONDS ),
+  validLineAspectRatio_( DEFAULT_VALID_LINE_ASPECT_RATIO ),
+  toleranceFactor_( DEFAULT_TOLERANCE_FACTOR )
+{
+}
+
+GestureParams::GestureParams( int minNumPoints,
+                              int expirationMilliseconds,
+                              double validLineAspectRatio,
+                              double toleranceFactor ) :
+  minNumPoints_( minNumPoints ),
+  expirationMilliseconds_( expirationMilliseconds ),
+  validLineAspectRatio_( validLineAspectRatio ),
+  toleranceFactor_( toleranceFactor )
+{
+}
+
+int GestureParams::minNumPoints() const
+{
+    return minNumPoints_;
+}
+
+int GestureParams::expirationMilliseconds() const
+{
+    return expirationMilliseconds_;
+}
+
+double GestureParams::validLineAspectRatio() const
+{
+    return validLineAspectRatio_;
+}
+
+double GestureParams::toleranceFactor() const
+{
+    return toleranceFactor_;
+}
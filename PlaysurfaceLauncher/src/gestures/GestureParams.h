@@ -0,0 +1,80 @@
+/*******************************************************************************
+GestureParams
+
+PURPOSE: An immutable snapshot of the gesture detection thresholds that can be
+         swapped atomically at runtime.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef GESTURES_GESTUREPARAMS_H
+#define GESTURES_GESTUREPARAMS_H
+
+#include <memory>
+
+namespace gestures
+{
+    /***********************************************************************//**
+    An immutable snapshot of the thresholds used for line and plus sign 
+    detection.  The settings code publishes a new snapshot whenever the XML
+    config file is (re)read, and the gesture code takes the current snapshot
+    with a single atomic load.  A LineGesture copies the values when it is 
+    created, so that a gesture in progress is never judged against a mix of
+    old and new thresholds.
+    ***************************************************************************/
+    class GestureParams
+    {
+    public:
+        static const int DEFAULT_MIN_NUM_POINTS,
+                         DEFAULT_EXPIRATION_MILLISECONDS;
+        static const double DEFAULT_VALID_LINE_ASPECT_RATIO,
+                            DEFAULT_TOLERANCE_FACTOR;
+
+        static std::shared_ptr<const gestures::GestureParams> current();
+        static void publish( const gestures::GestureParams & params );
+
+        GestureParams();
+        GestureParams( int minNumPoints,
+                       int expirationMilliseconds,
+                       double validLineAspectRatio,
+                       double toleranceFactor );
+
+        int minNumPoints() const;
+        int expirationMilliseconds() const;
+        double validLineAspectRatio() const;
+        double toleranceFactor() const;
+
+    private:
+        static std::shared_ptr<const gestures::GestureParams> current_;
+
+        int minNumPoints_,
+            expirationMilliseconds_;
+        double validLineAspectRatio_,
+               toleranceFactor_;
+    };
+}
+
+#endif
@@ -33,23 +33,17 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
  Boston, MA  02111-1307  USA
 */
 #include "gestures/LineGesture.h"
-#include <QTimer>
 #include <iostream>
 #include <iomanip>
 #include <cmath>
 
 using gestures::LineGesture;
 
-const int LineGesture::MIN_NUM_POINTS = 10,
-          LineGesture::EXPIRATION_MILLISECONDS = 5000;
-
-const double LineGesture::VALID_LINE_ASPECT_RATIO = 10.0,
-             LineGesture::TOLERANCE_FACTOR = 0.25;
-
 const double LineGesture::HORIZONTAL_LINE_ANGLE_IN_DEGREES = 0.0,
              LineGesture::VERTICAL_LINE_ANGLE_IN_DEGREES = 90.0;
 
-LineGesture::LineGesture( int id, double x, double y ) :
+LineGesture::LineGesture( int id, double x, double y, const gestures::GestureParams & params ) :
+  params_( params ),
   id_( id ),
   numPoints_( 1 ),
   minX_( x ),
@@ -65,10 +59,11 @@ LineGesture::LineGesture( int id, double x, double y ) :
   xTolerance_( 0.0 ),
   yTolerance_( 0.0 ),
   angleInDegrees_( -1.0 ),
+  expirationClock_(),
   isValidLine_( false ),
-  isExpired_( false ),
   debug_( false )
 {
+    expirationClock_.invalidate();
 }
 
 LineGesture::~LineGesture()
@@ -99,7 +94,7 @@ void LineGesture::finish( double x, double y )
 {
     update( x, y );
 
-    if( numPoints_ >= MIN_NUM_POINTS ) {
+    if( numPoints_ >= params_.minNumPoints() ) {
          calculateBoundingBox();
 
         if( isBoundingBoxForHorizontalLine() ) {
@@ -118,7 +113,7 @@ void LineGesture::finish( double x, double y )
         if( isValidLine_ ) {
             calculateCentroid();
             calculateIntersectionTolerance();
-            startExpirationTimer();
+            startExpirationClock();
         }
     }
 }
@@ -140,12 +135,12 @@ void LineGesture::calculateBoundingBox()
 
 bool LineGesture::isBoundingBoxForHorizontalLine()
 {
-    return (widthHeightAspect_ >= VALID_LINE_ASPECT_RATIO);
+    return (widthHeightAspect_ >= params_.validLineAspectRatio());
 }
 
 bool LineGesture::isBoundingBoxForVerticalLine()
 {
-    return (heightWidthAspect_ >= VALID_LINE_ASPECT_RATIO);
+    return (heightWidthAspect_ >= params_.validLineAspectRatio());
 }
 
 void LineGesture::calculateCentroid()
@@ -157,19 +152,14 @@ void LineGesture::calculateCentroid()
 
 void LineGesture::calculateIntersectionTolerance()
 {
-    xTolerance_ = boxWidth_ * TOLERANCE_FACTOR;
-    yTolerance_ = boxHeight_ * TOLERANCE_FACTOR;
+    xTolerance_ = boxWidth_ * params_.toleranceFactor();
+    yTolerance_ = boxHeight_ * params_.toleranceFactor();
     //if( debug_ ) { debugPrintIntersectionTolerance(); }
 }
 
-void LineGesture::startExpirationTimer()
+void LineGesture::startExpirationClock()
 {
-    QTimer::singleShot( EXPIRATION_MILLISECONDS, this, SLOT( setExpired() ) );
-}
-
-void LineGesture::setExpired()
-{
-    isExpired_ = true;
+    expirationClock_.start();
 }
 
 bool LineGesture::isValidLine()
@@ -177,9 +167,14 @@ bool LineGesture::isValidLine()
     return isValidLine_;
 }
 
+/***************************************************************************//**
+A valid line expires a fixed number of milliseconds (from the GestureParams) 
+after it was finished.  A gesture that never started the clock does not expire.
+*******************************************************************************/
 bool LineGesture::isExpired()
 {
-    return isExpired_;
+    return expirationClock_.isValid()
+        && expirationClock_.hasExpired( params_.expirationMilliseconds() );
 }
 
 gestures::GestureResult LineGesture::calculateResult( LineGesture * other )
@@ -219,12 +214,12 @@ bool LineGesture::isPerpendicular( LineGesture * other )
 
 bool LineGesture::isHorizontal()
 {
-    return (widthHeightAspect_ >= VALID_LINE_ASPECT_RATIO);
+    return (widthHeightAspect_ >= params_.validLineAspectRatio());
 }
 
 bool LineGesture::isVertical()
 {
-    return (heightWidthAspect_ >= VALID_LINE_ASPECT_RATIO);
+    return (heightWidthAspect_ >= params_.validLineAspectRatio());
 }
 
 bool LineGesture::isWithinTolerance( double deltaX, double deltaY )
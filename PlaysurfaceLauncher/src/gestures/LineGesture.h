@@ -36,25 +36,25 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #define GESTURES_LINEGESTURE_H
 
 #include "gestures/GestureResult.h"
-#include <QObject>
+#include "gestures/GestureParams.h"
+#include <QElapsedTimer>
 
 namespace gestures { class GestureResult; }
 
 namespace gestures
 {
-    class LineGesture : public QObject
+    /***********************************************************************//**
+    A LineGesture is not a QObject and does not use a QTimer for expiration,
+    so it can be used on a thread that has no Qt event loop (such as the 
+    thread that receives TUIO messages).
+    ***************************************************************************/
+    class LineGesture
     {
-        Q_OBJECT
-
     public:
-        static const int MIN_NUM_POINTS,
-                         EXPIRATION_MILLISECONDS;
-        static const double VALID_LINE_ASPECT_RATIO,
-                            TOLERANCE_FACTOR;
         static const double HORIZONTAL_LINE_ANGLE_IN_DEGREES,
                             VERTICAL_LINE_ANGLE_IN_DEGREES;
 
-        LineGesture( int id, double x, double y );
+        LineGesture( int id, double x, double y, const gestures::GestureParams & params );
         virtual ~LineGesture();
 
         int id();
@@ -67,16 +67,13 @@ namespace gestures
         bool isHorizontal();
         bool isVertical();
 
-    public slots:
-        void setExpired();
-
     private:
         void calculateBoundingBox();
         bool isBoundingBoxForHorizontalLine();
         bool isBoundingBoxForVerticalLine();
         void calculateCentroid();
         void calculateIntersectionTolerance();
-        void startExpirationTimer();
+        void startExpirationClock();
         bool isPerpendicular( LineGesture * other );
         bool isWithinTolerance( double deltaX, double deltaY );
 
@@ -84,6 +81,7 @@ namespace gestures
         void debugPrintCentroid();
         void debugPrintIntersectionTolerance();
 
+        gestures::GestureParams params_;
         int id_,
             numPoints_;
         double minX_,
@@ -99,8 +97,8 @@ namespace gestures
                xTolerance_,
                yTolerance_,
                angleInDegrees_;
+        QElapsedTimer expirationClock_;
         bool isValidLine_,
-             isExpired_,
              debug_;
     };
 }
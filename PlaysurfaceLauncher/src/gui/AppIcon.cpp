@@ -38,8 +38,56 @@ using gui::AppIcon;
 const int AppIcon::DEFAULT_WIDTH = 200,
           AppIcon::DEFAULT_HEIGHT = 200;
 
+/***************************************************************************//**
+Creates an icon with no image yet.  The PaintWidget draws a placeholder for
+it until the image for its iconPath() has been decoded and set.
+*******************************************************************************/
+AppIcon::AppIcon() :
+  iconImage_(),
+  atlasPage_(),
+  atlasRect_(),
+  iconPath_(),
+  atlasKey_(),
+  scaledPixmaps_(),
+  nullPixmap_(),
+  rect_( 0, 0, 200, 200 ),
+  xMin_( 0 ),
+  xMax_( 200 ),
+  yMin_( 0 ),
+  yMax_( 200 )
+{
+
+}
+
 AppIcon::AppIcon( const QImage & iconImage ) :
   iconImage_( iconImage ),
+  atlasPage_(),
+  atlasRect_(),
+  iconPath_(),
+  atlasKey_(),
+  scaledPixmaps_(),
+  nullPixmap_(),
+  rect_( 0, 0, 200, 200 ),
+  xMin_( 0 ),
+  xMax_( 200 ),
+  yMin_( 0 ),
+  yMax_( 200 )
+{
+
+}
+
+/***************************************************************************//**
+Creates an icon whose image is the given rectangle of an IconAtlas page.  
+The page is implicitly shared, so the icon does not hold its own copy.
+*******************************************************************************/
+AppIcon::AppIcon( const QImage & atlasPage, const QRect & atlasRect ) :
+  iconImage_(),
+  atlasPage_( atlasPage ),
+  atlasRect_( atlasRect ),
+  iconPath_(),
+  atlasKey_(),
+  scaledPixmaps_(),
+  nullPixmap_(),
   rect_( 0, 0, 200, 200 ),
   xMin_( 0 ),
   xMax_( 200 ),
@@ -56,11 +104,115 @@ AppIcon::~AppIcon()
 void AppIcon::setImage( const QImage & image )
 {
     iconImage_ = image;
+    atlasPage_ = QImage();
+    atlasRect_ = QRect();
+    scaledPixmaps_.clear();
+}
+
+/***************************************************************************//**
+Replaces the icon's own image with a view of an IconAtlas page (once the
+atlas has been packed), so the separate image can be freed.
+*******************************************************************************/
+void AppIcon::setAtlasImage( const QImage & atlasPage, const QRect & atlasRect )
+{
+    iconImage_ = QImage();
+    atlasPage_ = atlasPage;
+    atlasRect_ = atlasRect;
+}
+
+bool AppIcon::hasImage()
+{
+    return !iconImage_.isNull() || (!atlasPage_.isNull() && !atlasRect_.isEmpty());
+}
+
+void AppIcon::setIconPath( const QString & iconPath )
+{
+    iconPath_ = iconPath;
 }
 
+QString AppIcon::iconPath()
+{
+    return iconPath_;
+}
+
+/***************************************************************************//**
+For an icon that lives in an atlas, the image returned is a read-only view of
+the atlas page's pixels (no copy is made).
+*******************************************************************************/
 QImage AppIcon::iconImage()
 {
-    return iconImage_;
+    if( atlasPage_.isNull() || atlasRect_.isEmpty() ) {
+        return iconImage_;
+    }
+    const uchar * bits = atlasPage_.constBits() 
+                       + atlasRect_.y() * atlasPage_.bytesPerLine()
+                       + atlasRect_.x() * (atlasPage_.depth() / 8);
+    return QImage( bits, 
+                   atlasRect_.width(), 
+                   atlasRect_.height(), 
+                   atlasPage_.bytesPerLine(), 
+                   atlasPage_.format() );
+}
+
+/***************************************************************************//**
+The key of the icon file in the IconAtlas (see IconAtlas::iconKey()).
+*******************************************************************************/
+void AppIcon::setAtlasKey( const QString & atlasKey )
+{
+    atlasKey_ = atlasKey;
+}
+
+QString AppIcon::atlasKey()
+{
+    return atlasKey_;
+}
+
+QImage AppIcon::atlasPage()
+{
+    return atlasPage_;
+}
+
+QRect AppIcon::atlasRect()
+{
+    return atlasRect_;
+}
+
+/***************************************************************************//**
+Returns the icon image scaled (once, with smooth filtering) to the given size
+in device pixels, and converted to a premultiplied ARGB32 pixmap, so it can be
+painted with a straight copy.  The scaled pixmaps are kept for each size that
+has been asked for, which is usually just one.  An icon with no image yet
+(or asked for an empty size) returns a null pixmap.
+*******************************************************************************/
+const QPixmap & AppIcon::pixmap( const QSize & size, int devicePixelRatio )
+{
+    QSize deviceSize = size * devicePixelRatio;
+
+    if( !hasImage() || deviceSize.isEmpty() ) {
+        return nullPixmap_; // Nothing to scale, so nothing is cached.
+    }
+    for( int i = 0; i < scaledPixmaps_.size(); ++i ) {
+        if( scaledPixmaps_.at( i ).size() == deviceSize ) {
+            return scaledPixmaps_.at( i );
+        }
+    }
+    QImage scaledImage = iconImage().scaled( deviceSize, 
+                                             Qt::IgnoreAspectRatio, 
+                                             Qt::SmoothTransformation );
+    QPixmap scaledPixmap = QPixmap::fromImage( 
+        scaledImage.convertToFormat( QImage::Format_ARGB32_Premultiplied ) );
+    scaledPixmap.setDevicePixelRatio( devicePixelRatio );
+    scaledPixmaps_.append( scaledPixmap );
+    return scaledPixmaps_.last();
+}
+
+/***************************************************************************//**
+Frees the scaled pixmaps.  Called by the PaintWidget when the icon has been
+scrolled well out of view.
+*******************************************************************************/
+void AppIcon::releasePixmaps()
+{
+    scaledPixmaps_.clear();
 }
 
 void AppIcon::setRect( int x, int y, int width, int height )
@@ -35,6 +35,9 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #define GUI_APPICON_H
 
 #include <QImage>
+#include <QPixmap>
+#include <QList>
+#include <QString>
 
 namespace gui
 {
@@ -44,18 +47,36 @@ namespace gui
         static const int DEFAULT_WIDTH,
                          DEFAULT_HEIGHT;
 
+        AppIcon();
         AppIcon( const QImage & iconImage );
+        AppIcon( const QImage & atlasPage, const QRect & atlasRect );
         virtual ~AppIcon();
 
         void setImage( const QImage & image );
+        void setAtlasImage( const QImage & atlasPage, const QRect & atlasRect );
+        bool hasImage();
+        void setIconPath( const QString & iconPath );
+        QString iconPath();
         QImage iconImage();
+        void setAtlasKey( const QString & atlasKey );
+        QString atlasKey();
+        QImage atlasPage();
+        QRect atlasRect();
+        const QPixmap & pixmap( const QSize & size, int devicePixelRatio );
+        void releasePixmaps();
 
         void setRect( int x, int y, int width, int height );
         QRect rect();
         bool containsPoint( double x, double y );
 
     private:
-        QImage iconImage_;
+        QImage iconImage_,
+               atlasPage_;
+        QRect atlasRect_;
+        QString iconPath_,
+                atlasKey_;
+        QList<QPixmap> scaledPixmaps_;
+        QPixmap nullPixmap_;
         QRect rect_;
         int xMin_,
             xMax_,
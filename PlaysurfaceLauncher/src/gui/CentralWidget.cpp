@@ -38,9 +38,14 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #include "gui/ConfirmExitBox.h"
 #include "gui/ConfirmShutdownBox.h"
 #include "gui/TouchDetector.h"
+#include "gui/TouchTable.h"
 #include "gui/AppIcon.h"
+#include "gui/IconGridIndex.h"
+#include "gui/GLIconView.h"
+#include "gestures/BackgroundGestureDetector.h"
 #include "sound/IconSound.h"
 #include "app/AppLauncher.h"
+#include "metrics/Metrics.h"
 #include <QApplication>
 #include <QtGui>
 #include <QScrollBar>
@@ -56,7 +61,7 @@ const QColor CentralWidget::BACKGROUND_COLOR( 134, 201, 222 );
 
 CentralWidget::CentralWidget( app::AppLauncher * appLauncher, 
                               gui::FullScreenWindow * parent ) : 
-  QScrollArea( parent ),
+  QAbstractScrollArea( parent ),
   parent_( parent ),
   appLauncher_( appLauncher ),
   paintWidget_( new PaintWidget( parent, appLauncher->tuioGenerator() ) ),
@@ -64,13 +69,18 @@ CentralWidget::CentralWidget( app::AppLauncher * appLauncher,
   confirmShutdownBox_( new gui::ConfirmShutdownBox( this ) ),
   iconSound_( new sound::IconSound() ),
   touchDetector_( NULL ),
+  touchTables_(),
+  touchEventDepth_( 0 ),
+  glIconView_( NULL ),
+  backgroundGestureDetector_( new gestures::BackgroundGestureDetector( this ) ),
   multitouchAppOpen_( false ),
   usePlusGestureToQuitApps_( false ),
   confirmExitBoxOpen_( false ),
   confirmShutdownBoxOpen_( false ),
   quietPeriod_( false ),
   showGesturePanel_( false ),
-  scrollBarVisible_( false )
+  scrollBarVisible_( false ),
+  useOpenGLRenderer_( false )
 {
     setUpPaintWidgetScrolling();
     createTouchDetector();
@@ -87,11 +97,30 @@ CentralWidget::CentralWidget( app::AppLauncher * appLauncher,
 
     connect( appLauncher_, SIGNAL( multitouchAppClosed( ) ),
              this, SLOT( onMultitouchAppClosed() ) );
+    connect( appLauncher_, SIGNAL( multitouchAppsInfoChanged() ),
+             this, SLOT( onMultitouchAppsInfoChanged() ) );
+    connect( appLauncher_, SIGNAL( multitouchAppsAppended( int ) ),
+             this, SLOT( onMultitouchAppsAppended( int ) ) );
+    connect( appLauncher_, SIGNAL( multitouchAppInserted( int ) ),
+             this, SLOT( onMultitouchAppInserted( int ) ) );
+    connect( appLauncher_, SIGNAL( multitouchAppReplaced( int ) ),
+             this, SLOT( onMultitouchAppReplaced( int ) ) );
+    connect( appLauncher_, SIGNAL( multitouchAppRemoved( int ) ),
+             this, SLOT( onMultitouchAppRemoved( int ) ) );
+    connect( backgroundGestureDetector_, SIGNAL( quitGestureRecognized() ),
+             this, SLOT( onQuitGestureRecognized() ), Qt::QueuedConnection );
+    connect( backgroundGestureDetector_, SIGNAL( firstTouch() ),
+             appLauncher_, SLOT( onFirstTouchInApp() ), Qt::QueuedConnection );
 }
 
 CentralWidget::~CentralWidget()
 {
+    delete glIconView_;
     delete touchDetector_;
+
+    for( size_t i = 0; i < touchTables_.size(); ++i ) {
+        delete touchTables_[i];
+    }
     delete iconSound_;
     delete confirmExitBox_;
     delete confirmShutdownBox_;
@@ -101,26 +130,30 @@ CentralWidget::~CentralWidget()
 void CentralWidget::setTuioGeneratorIcon( enums::TuioSourceEnum::Enum tuioSource )
 {
     paintWidget_->setTuioGeneratorIcon( tuioSource );
-    paintWidget_->update();
 }
 
+/***************************************************************************//**
+The PaintWidget is kept the size of the viewport rather than being as wide as
+the whole icon layout.  The scroll bar range comes from the width of the 
+layout, and moving the scroll bar just changes the PaintWidget's scroll 
+offset (see scrollContentsBy()).
+*******************************************************************************/
 void CentralWidget::setUpPaintWidgetScrolling()
 {
-    setWidget( paintWidget_ );
-    setWidgetResizable( false );
+    paintWidget_->setParent( viewport() );
+    paintWidget_->move( 0, 0 );
     setFrameStyle( QFrame::NoFrame );
     setVerticalScrollBarPolicy( Qt::ScrollBarAlwaysOff );
     setHorizontalScrollBarPolicy( Qt::ScrollBarAsNeeded );
+    connect( paintWidget_, SIGNAL( contentWidthChanged() ), 
+             this, SLOT( updateScrollBarRange() ) );
 }
 
 void CentralWidget::createTouchDetector()
 {
     touchDetector_ = new gui::TouchDetector( confirmExitBox_, 
                                              confirmShutdownBox_,
-                                             paintWidget_->appIcons() );
-    touchDetector_->setTuioGeneratorIcon( paintWidget_->tuioGeneratorAppIcon() );
-    touchDetector_->setReloadIcon( paintWidget_->reloadAppIcon() );
-    touchDetector_->setShutdownIcon( paintWidget_->shutdownAppIcon() );
+                                             paintWidget_->iconGridIndex() );
 }
 
 void CentralWidget::setBackgroundColor()
@@ -136,16 +169,51 @@ sound::IconSound * CentralWidget::iconSound()
     return iconSound_;
 }
 
+gestures::BackgroundGestureDetector * CentralWidget::backgroundGestureDetector()
+{
+    return backgroundGestureDetector_;
+}
+
+/***************************************************************************//**
+Starts reading the multitouch apps in the background.  The icons are added
+by onMultitouchAppsAppended() as the apps are found, and are set once more by
+onMultitouchAppsInfoChanged() when the read is done.
+*******************************************************************************/
 void CentralWidget::readMultitouchAppsInfo()
 {
     appLauncher_->readMultitouchAppsInfo();
-    paintWidget_->setFileIcons( appLauncher_->multitouchAppIcons() );
+}
+
+void CentralWidget::onMultitouchAppsInfoChanged()
+{
+    paintWidget_->setFileIcons( appLauncher_->multitouchAppIconPaths() );
+}
+
+void CentralWidget::onMultitouchAppsAppended( int index )
+{
+    paintWidget_->appendFileIcons( appLauncher_->multitouchAppIconPaths(), index );
+}
+
+void CentralWidget::onMultitouchAppInserted( int index )
+{
+    paintWidget_->insertFileIcon( index, appLauncher_->multitouchAppIconPaths()->at( index ) );
+}
+
+void CentralWidget::onMultitouchAppReplaced( int index )
+{
+    paintWidget_->replaceFileIcon( index, appLauncher_->multitouchAppIconPaths()->at( index ) );
+}
+
+void CentralWidget::onMultitouchAppRemoved( int index )
+{
+    paintWidget_->removeFileIcon( index );
 }
 
 void CentralWidget::hideConfirmExitBox()
 {
     confirmExitBox_->hide();
     confirmExitBoxOpen_ = false;
+    updateBackgroundGestureDetection();
 }
 
 void CentralWidget::hideConfirmShutdownBox()
@@ -158,7 +226,6 @@ void CentralWidget::onDeviceArrival( char driveLetter )
 {
     if( appLauncher_->hasMultitouchAppsDirectory( driveLetter ) ) {
         readMultitouchAppsInfo();
-        paintWidget_->update();
     }
 }
 
@@ -166,7 +233,6 @@ void CentralWidget::onDeviceRemoval( char driveLetter )
 {
     if( appLauncher_->isMultitouchAppsDirInUse( driveLetter ) ) {
         readMultitouchAppsInfo();
-        paintWidget_->update();
     }
 }
 
@@ -174,31 +240,28 @@ void CentralWidget::onMultitouchAppClosed()
 {
     paintWidget_->drawBlackScreen( false );
     multitouchAppOpen_ = false;
-    paintWidget_->update();
+    updateBackgroundGestureDetection();
+    updateGLIconView();
 }
 
 void CentralWidget::stopGrayTuioGeneratorIcon()
 {
     paintWidget_->setTuioGeneratorIconToGray( false );
-    paintWidget_->update();
 }
 
 void CentralWidget::stopGrayReloadIcon()
 {  
     paintWidget_->setReloadIconToGray( false );
-    paintWidget_->update();
 }
 
 void CentralWidget::stopGrayShutdownIcon()
 {  
     paintWidget_->setShutdownIconToGray( false );
-    paintWidget_->update();
 }
 
 void CentralWidget::stopGrayActivatedIcon()
 {
     paintWidget_->setActivatedAppIconToGray( false );
-    paintWidget_->update();
 }
 
 void CentralWidget::launchMultitouchApp()
@@ -206,7 +269,8 @@ void CentralWidget::launchMultitouchApp()
     paintWidget_->drawBlackScreen( true );
     multitouchAppOpen_ = true;
     quietPeriod_ = false;
-    paintWidget_->update();
+    updateBackgroundGestureDetection();
+    updateGLIconView();
     appLauncher_->launchMultitouchApp( paintWidget_->activatedAppIconIndex() );
     paintWidget_->setActivatedAppIconIndex( -1 );
 }
@@ -219,18 +283,26 @@ void CentralWidget::stopQuietPeriod()
 void CentralWidget::usePlusGestureToQuitApps( bool b )
 {
     usePlusGestureToQuitApps_ = b;
+    backgroundGestureDetector_->setDetectingPlusSign( b );
     //std::cout << "CentralWidget::usePlusGestureToQuitApps(" << usePlusGestureToQuitApps_ << ")\n";
 }
 
 void CentralWidget::showGesturePanel( bool b )
 {
     showGesturePanel_ = b;
+    updateBackgroundGestureDetection();
+    updateGLIconView();
     paintWidget_->drawGesturePanel( showGesturePanel_ );
-    paintWidget_->update();
 }
 
+/***************************************************************************//**
+The painter the TouchDetector keeps open on the gesture panel image during a
+touch event is closed before the image is cleared or resized (a modal dialog
+can run this in the middle of a touch event).
+*******************************************************************************/
 void CentralWidget::clearGesturePanelImage()
 {
+    touchDetector_->endPainting();
     touchDetector_->clearGestures();
     paintWidget_->clearGesturePanelImage();
 }
@@ -239,7 +311,16 @@ void CentralWidget::showShutdownComputerIcon( bool b )
 {
     //std::cout << "CentralWidget::showShutdownComputerIcon(" << b << ")\n";
     paintWidget_->showShutdownComputerIcon( b );
-    paintWidget_->update();
+}
+
+void CentralWidget::showTuioStats( bool b )
+{
+    paintWidget_->showTuioStats( b );
+}
+
+void CentralWidget::setTuioStatsText( const QString & text )
+{
+    paintWidget_->setTuioStatsText( text );
 }
 
 void CentralWidget::resizeEvent( QResizeEvent * event )
@@ -247,51 +328,122 @@ void CentralWidget::resizeEvent( QResizeEvent * event )
     //std::cout << "CentralWidget w x h = " << width() << " x " << height() << "\n";
     int centralWidgetWidth = width(),
         centralWidgetHeight = height();
+    touchDetector_->endPainting(); // The gesture panel image is resized.
     paintWidget_->setWidthAndHeightOfParent( centralWidgetWidth, centralWidgetHeight );
-    
-    // If the PaintWidget is wider than the viewport, the scrollbar should be visible.
-    int differenceInWidths = paintWidget_->width() - viewport()->width();
+    updateScrollBarRange();
+
+    if( glIconView_ != NULL ) {
+        glIconView_->setGeometry( viewport()->rect() );
+    }
+    QWidget::resizeEvent( event );
+}
+
+/***************************************************************************//**
+Called on a resize and whenever the PaintWidget's icon layout changes width.
+*******************************************************************************/
+void CentralWidget::updateScrollBarRange()
+{
+    // If the icon layout is wider than the viewport, the scrollbar should be visible.
+    int differenceInWidths = paintWidget_->contentWidth() - viewport()->width();
     scrollBarVisible_ = (differenceInWidths > 0);
 
     int maxScrollBarValue = (differenceInWidths > 0) ? differenceInWidths : 0;
     horizontalScrollBar()->setRange( 0, maxScrollBarValue );
-    touchDetector_->setScrollBarParams( 0, maxScrollBarValue, centralWidgetWidth );
+    horizontalScrollBar()->setPageStep( viewport()->width() );
+    touchDetector_->setScrollBarParams( 0, maxScrollBarValue, width() );
     //debugPrintResizeEvent( maxScrollBarValue );
-    QWidget::resizeEvent( event );
+}
+
+/***************************************************************************//**
+The deltas are not needed, since the PaintWidget just takes the new scroll 
+bar value as its scroll offset.
+*******************************************************************************/
+void CentralWidget::scrollContentsBy( int, int )
+{
+    paintWidget_->setScrollOffset( horizontalScrollBar()->value() );
+}
+
+/***************************************************************************//**
+The GLIconView is created the first time the OpenGL renderer is turned on.
+It covers the viewport and follows the horizontal scroll bar, while the 
+PaintWidget underneath stops drawing icons (but still draws the gesture 
+panel and the black screen, during which the GLIconView is hidden).
+*******************************************************************************/
+void CentralWidget::useOpenGLRenderer( bool b )
+{
+    useOpenGLRenderer_ = b;
+
+    if( useOpenGLRenderer_ && glIconView_ == NULL ) {
+        glIconView_ = new gui::GLIconView( paintWidget_, viewport() );
+        glIconView_->setGeometry( viewport()->rect() );
+        glIconView_->setScrollOffset( horizontalScrollBar()->value() );
+        connect( horizontalScrollBar(), SIGNAL( valueChanged( int ) ),
+                 glIconView_, SLOT( setScrollOffset( int ) ) );
+        connect( glIconView_, SIGNAL( openGLFailed() ),
+                 this, SLOT( onOpenGLFailed() ), Qt::QueuedConnection );
+    }
+    updateGLIconView();
+}
+
+/***************************************************************************//**
+The GLIconView could not draw (and has logged why), so it is thrown away and
+the PaintWidget goes back to drawing the icons itself.  The signal is queued,
+since it comes from inside the GLIconView's own initializeGL() or paintGL().
+*******************************************************************************/
+void CentralWidget::onOpenGLFailed()
+{
+    useOpenGLRenderer_ = false;
+
+    if( glIconView_ != NULL ) {
+        glIconView_->hide();
+        glIconView_->deleteLater();
+        glIconView_ = NULL;
+    }
+    paintWidget_->setIconsDrawnByOpenGL( false );
+}
+
+void CentralWidget::updateGLIconView()
+{
+    if( glIconView_ != NULL ) {
+        bool show = useOpenGLRenderer_ && !multitouchAppOpen_ && !showGesturePanel_;
+        glIconView_->setVisible( show );
+
+        if( show ) {
+            glIconView_->raise();
+        }
+        paintWidget_->setIconsDrawnByOpenGL( show );
+    }
 }
 
 void CentralWidget::mousePressEvent( QMouseEvent * e )
 {
     if( !confirmShutdownBoxOpen_ && !multitouchAppOpen_ && !showGesturePanel_ && !quietPeriod_ ) {
-        touchDetector_->setScrollOffsetX( paintWidget_->x() );
+        touchDetector_->setScrollOffsetX( -paintWidget_->scrollOffset() );
         int x = e->x(),
-            y = e->y();
+            y = e->y(),
+            iconIndex = touchDetector_->iconAt( x, y );
 
-        if( touchDetector_->isClickOnTuioGeneratorIcon( x, y ) ) {
+        if( iconIndex == gui::IconGridIndex::TUIO_GENERATOR_ICON ) {
             onTuioGeneratorIconActivated();
         }
-        else if( touchDetector_->isClickOnReloadIcon( x, y ) ) {
+        else if( iconIndex == gui::IconGridIndex::RELOAD_ICON ) {
             onReloadIconActivated();
         }
-        else if( touchDetector_->isClickOnShutdownIcon( x, y ) ) {
+        else if( iconIndex == gui::IconGridIndex::SHUTDOWN_ICON ) {
             startQuietPeriod( 1000 );
             onShutdownIconActivated();
         }
+        else if( iconIndex >= 0 ) {
+            onMultitouchAppIconActivated( iconIndex );
+        }
         else {
-            int iconIndex = touchDetector_->indexOfAppIcon( x, y );
-        
-            if( iconIndex >= 0 ) {
-                onMultitouchAppIconActivated( iconIndex );
+            //std::cout << "CentralWidget(x, y) = " << x << ", " << y << ")\n";
+
+            if( y < 20 ) {
+                parent_->showMenuBar();
             }
             else {
-                //std::cout << "CentralWidget(x, y) = " << x << ", " << y << ")\n";
-
-                if( y < 20 ) {
-                    parent_->showMenuBar();
-                }
-                else {
-                    parent_->hideMenuBar();
-                }
+                parent_->hideMenuBar();
             }
         }
     }
@@ -300,7 +452,6 @@ void CentralWidget::mousePressEvent( QMouseEvent * e )
 void CentralWidget::onTuioGeneratorIconActivated()
 {
     paintWidget_->setTuioGeneratorIconToGray( true );
-    paintWidget_->update();
     iconSound_->play();
     QTimer::singleShot( GRAYOUT_ICON_MILLISEC, this, SLOT( stopGrayTuioGeneratorIcon() ) );
     appLauncher_->onTuioGeneratorIconTouched();
@@ -309,7 +460,6 @@ void CentralWidget::onTuioGeneratorIconActivated()
 void CentralWidget::onReloadIconActivated()
 {
     paintWidget_->setReloadIconToGray( true );
-    paintWidget_->update();
     iconSound_->play();
     QTimer::singleShot( GRAYOUT_ICON_MILLISEC, this, SLOT( stopGrayReloadIcon() ) );
     QTimer::singleShot( GRAYOUT_ICON_MILLISEC + 200, this, SLOT( readMultitouchAppsInfoAndUpdate() ) );
@@ -318,7 +468,6 @@ void CentralWidget::onReloadIconActivated()
 void CentralWidget::onShutdownIconActivated()
 {
     paintWidget_->setShutdownIconToGray( true );
-    paintWidget_->update();
     iconSound_->play();
     QTimer::singleShot( GRAYOUT_ICON_MILLISEC, this, SLOT( stopGrayShutdownIcon() ) );
     QTimer::singleShot( GRAYOUT_ICON_MILLISEC + 200, this, SLOT( openConfirmShutdownBox() ) );
@@ -327,7 +476,6 @@ void CentralWidget::onShutdownIconActivated()
 void CentralWidget::readMultitouchAppsInfoAndUpdate()
 {
     readMultitouchAppsInfo();
-    paintWidget_->update();
     appLauncher_->placeAllOtherWindowsInTaskbar();
 }
 
@@ -336,8 +484,8 @@ void CentralWidget::onMultitouchAppIconActivated( int index )
     quietPeriod_ = true;
     paintWidget_->setActivatedAppIconToGray( true );
     paintWidget_->setActivatedAppIconIndex( index );
-    paintWidget_->update();
     iconSound_->play();
+    appLauncher_->prepareMultitouchApp( index );
     QTimer::singleShot( GRAYOUT_ICON_MILLISEC, this, SLOT( stopGrayActivatedIcon() ) );
     QTimer::singleShot( 2 * GRAYOUT_ICON_MILLISEC, this, SLOT( launchMultitouchApp() ) );
 }
@@ -379,84 +527,109 @@ bool CentralWidget::event( QEvent * e )
 /***************************************************************************//**
 Before calling this function, the QEvent object given as an arg should be tested
 to make sure that it is really a QTouchEvent object.  That is necessary because 
-this function does a static cast from QEvent to QTouchEvent.
+this function does a static cast from QEvent to QTouchEvent.  This is the only
+place the TouchPoint objects are read; the values the launcher needs are copied
+into a TouchTable, and the handlers below refer to a touch by its row number.
+
+A handler can open a modal dialog, which runs a nested event loop that may 
+deliver the next touch event before this one is finished.  Each level of 
+nesting therefore gets its own TouchTable (kept for reuse), so a nested event
+never overwrites the table that is still being read.
 *******************************************************************************/
 void CentralWidget::handleTouchEvent( QEvent * e )
 {
     e->accept();
-    QTouchEvent * touchEvent = static_cast<QTouchEvent *>(e);
-    QList<QTouchEvent::TouchPoint> touchPoints = touchEvent->touchPoints();
-    //debugPrintTouchEvent( e );
-    touchDetector_->setScrollOffsetX( paintWidget_->x() );
 
-    foreach( const QTouchEvent::TouchPoint & touchPoint, touchPoints ) {
-        switch( touchPoint.state() ) {
-            case Qt::TouchPointPressed:    handleTouchPointPressed( touchPoint );  break;
-            case Qt::TouchPointStationary: handleTouchPointUpdate( touchPoint );   break;
-            case Qt::TouchPointMoved:      handleTouchPointUpdate( touchPoint );   break;
-            case Qt::TouchPointReleased:   handleTouchPointReleased( touchPoint ); break;
+    if( touchEventDepth_ == (int)touchTables_.size() ) {
+        touchTables_.push_back( new gui::TouchTable() );
+    }
+    const gui::TouchTable & touches = *touchTables_[touchEventDepth_];
+    touchTables_[touchEventDepth_]->fill( static_cast<QTouchEvent *>(e) );
+    ++touchEventDepth_;
+    //debugPrintTouchEvent( e );
+    touchDetector_->setScrollOffsetX( -paintWidget_->scrollOffset() );
+
+    for( int i = 0; i < touches.size(); ++i ) {
+        switch( touches.state( i ) ) {
+            case Qt::TouchPointPressed:    handleTouchPointPressed( touches, i );  break;
+            case Qt::TouchPointStationary: handleTouchPointUpdate( touches, i );   break;
+            case Qt::TouchPointMoved:      handleTouchPointUpdate( touches, i );   break;
+            case Qt::TouchPointReleased:   handleTouchPointReleased( touches, i ); break;
             default:  break;
         }   
     }
+    --touchEventDepth_;
+    // All of the strokes for this event have been painted on the gesture
+    // panel image, so the painter is closed and the area is repainted once.
+    touchDetector_->endPainting();
+    paintWidget_->invalidate( touchDetector_->takeDirtyRect() );
+    observeTouchLatency( static_cast<QTouchEvent *>(e)->timestamp() );
 }
 
-void CentralWidget::handleTouchPointPressed( const QTouchEvent::TouchPoint & touchPoint )
+/***************************************************************************//**
+QTuio stamps each touch event with metrics::Metrics::microseconds() (cut to
+an unsigned long, so the subtraction is done the same way to survive the
+wrap-around).
+*******************************************************************************/
+void CentralWidget::observeTouchLatency( unsigned long postedAt )
+{
+    if( postedAt != 0 ) {
+        unsigned long latency = (unsigned long)metrics::Metrics::microseconds() - postedAt;
+        metrics::Metrics::instance().touchLatency.observeMicroseconds( latency );
+    }
+}
+
+void CentralWidget::handleTouchPointPressed( const gui::TouchTable & touches, int i )
 {
     if( !quietPeriod_ ) {
         if( confirmExitBoxOpen_ ) {
-            if( touchDetector_->touchOnYesButton( touchPoint ) ) {
+            if( touchDetector_->touchOnYesButton( touches, i ) ) {
                 onMultitouchAppConfirmExitYes();
             }
-            else if( touchDetector_->touchOnNoButton( touchPoint ) ) {
+            else if( touchDetector_->touchOnNoButton( touches, i ) ) {
                 onMultitouchAppConfirmExitNo();
             }
         }
         else if( confirmShutdownBoxOpen_ ) {
-            if( touchDetector_->touchOnShutdownComputerButton( touchPoint ) ) {
+            if( touchDetector_->touchOnShutdownComputerButton( touches, i ) ) {
                 onShutdownComputerRequest();
             }
-            else if( touchDetector_->touchOnShutdownPlaysurfaceButton( touchPoint ) ) {
+            else if( touchDetector_->touchOnShutdownPlaysurfaceButton( touches, i ) ) {
                 onShutdownPlaysurfaceRequest();
             }
-            else if( touchDetector_->touchOnCancelShutdownButton( touchPoint ) ) {
+            else if( touchDetector_->touchOnCancelShutdownButton( touches, i ) ) {
                 onCancelShutdownRequest();
             }
         }
         else if( showGesturePanel_ ) {
             QImage * image = paintWidget_->gesturePanelImage();
-            touchDetector_->startGesture( touchPoint, image );
-            
-            if( touchDetector_->isPaintingUpdated() ) {
-                paintWidget_->update();
-            }
+            touchDetector_->startGesture( touches, i, image );
         }
         else if( multitouchAppOpen_ ) {
-            touchDetector_->startGesture( touchPoint );
+            touchDetector_->startGesture( touches, i );
         }
         else {
-            if( touchDetector_->isTouchOnTuioGeneratorIcon( touchPoint ) ) {
+            int iconIndex = touchDetector_->iconAt( touches, i );
+
+            if( iconIndex == gui::IconGridIndex::TUIO_GENERATOR_ICON ) {
                 startQuietPeriod( 1000 );
                 onTuioGeneratorIconActivated();
             }
-            else if( touchDetector_->isTouchOnReloadIcon( touchPoint ) ) {
+            else if( iconIndex == gui::IconGridIndex::RELOAD_ICON ) {
                 startQuietPeriod( 1000 );
                 onReloadIconActivated();
             }
-            else if( touchDetector_->isTouchOnShutdownIcon( touchPoint ) ) {
+            else if( iconIndex == gui::IconGridIndex::SHUTDOWN_ICON ) {
                 startQuietPeriod( 1000 );
                 onShutdownIconActivated();
             }
-            else { // Playsurface icons are showing.
-                int iconIndex = touchDetector_->indexOfAppIcon( touchPoint );
-            
-                if( iconIndex >= 0 ) { // Launch an app.
-                    onMultitouchAppIconActivated( iconIndex );
-                }
-                else if( scrollBarVisible_ ) {
-                    // The PaintWidget is wider than CentralWidget, so start 
-                    // a sideways swipe (if one is not already in progress).
-                    touchDetector_->startSidewaysSwipe( touchPoint );
-                }
+            else if( iconIndex >= 0 ) { // Launch an app.
+                onMultitouchAppIconActivated( iconIndex );
+            }
+            else if( scrollBarVisible_ ) {
+                // The PaintWidget is wider than CentralWidget, so start 
+                // a sideways swipe (if one is not already in progress).
+                touchDetector_->startSidewaysSwipe( touches, i );
             }
         }
     }
@@ -498,23 +671,19 @@ void CentralWidget::onCancelShutdownRequest()
     startQuietPeriod( 500 );
 }
 
-void CentralWidget::handleTouchPointUpdate( const QTouchEvent::TouchPoint & touchPoint )
+void CentralWidget::handleTouchPointUpdate( const gui::TouchTable & touches, int i )
 {
     //std::cout << "\nCentralWidget::handleTouchPointUpdate() called...\n";
 
     if( showGesturePanel_ ) {
         QImage * image = paintWidget_->gesturePanelImage();
-        touchDetector_->updateGesture( touchPoint, image );
-        
-        if( touchDetector_->isPaintingUpdated() ) {
-            paintWidget_->update();
-        }
+        touchDetector_->updateGesture( touches, i, image );
     }
     else if( multitouchAppOpen_ ) {
-        touchDetector_->updateGesture( touchPoint );
+        touchDetector_->updateGesture( touches, i );
     }
     else if( scrollBarVisible_ ) {
-        int deltaX = touchDetector_->updateSidewaysSwipe( touchPoint );
+        int deltaX = touchDetector_->updateSidewaysSwipe( touches, i );
 
         if( deltaX != 0 ) {
             QScrollBar * scrollBar = horizontalScrollBar();
@@ -527,20 +696,16 @@ void CentralWidget::handleTouchPointUpdate( const QTouchEvent::TouchPoint & touc
     }
 }
 
-void CentralWidget::handleTouchPointReleased( const QTouchEvent::TouchPoint & touchPoint )
+void CentralWidget::handleTouchPointReleased( const gui::TouchTable & touches, int i )
 {
     //std::cout << "\nCentralWidget::handleTouchEnd() called...\n";
 
     if( showGesturePanel_ ) {
         QImage * image = paintWidget_->gesturePanelImage();
-        touchDetector_->finishGestureAndTestForPlusSign( touchPoint, image );
-
-        if( touchDetector_->isPaintingUpdated() ) {
-            paintWidget_->update();
-        }
+        touchDetector_->finishGestureAndTestForPlusSign( touches, i, image );
     }
     else if( multitouchAppOpen_ && !confirmExitBoxOpen_   ) {
-        bool isPlusSign = touchDetector_->finishGestureAndTestForPlusSign( touchPoint );
+        bool isPlusSign = touchDetector_->finishGestureAndTestForPlusSign( touches, i );
 
         if( isPlusSign ) {
             if( usePlusGestureToQuitApps_ ) {
@@ -550,7 +715,7 @@ void CentralWidget::handleTouchPointReleased( const QTouchEvent::TouchPoint & to
         }
     }
     else if( scrollBarVisible_ ) {
-        touchDetector_->finishSidewaysSwipe( touchPoint );
+        touchDetector_->finishSidewaysSwipe( touches, i );
     }
 }
 
@@ -559,7 +724,8 @@ void CentralWidget::killCurrentMultitouchApp()
     appLauncher_->killMultitouchAppProcess();
     paintWidget_->drawBlackScreen( false );
     multitouchAppOpen_ = false;
-    paintWidget_->update();
+    updateBackgroundGestureDetection();
+    updateGLIconView();
 }
 
 void CentralWidget::startQuietPeriod( int milliseconds )
@@ -573,11 +739,39 @@ void CentralWidget::openConfirmExitBox()
     paintWidget_->hideLoadingIconIfVisible();
     update();
     confirmExitBoxOpen_ = true;
+    updateBackgroundGestureDetection();
     appLauncher_->hideMultitouchApp();
     confirmExitBox_->show();
     QApplication::setActiveWindow( confirmExitBox_ );
 }
 
+/***************************************************************************//**
+Touches are only handed to the background gesture detector (on the TUIO 
+receive thread) while a multitouch app is in front.  Whenever the launcher has
+something on screen to touch (confirm exit box, gesture panel, icons), the
+touches come to the GUI thread as QTouchEvents instead.
+*******************************************************************************/
+void CentralWidget::updateBackgroundGestureDetection()
+{
+    bool headless = multitouchAppOpen_ && !confirmExitBoxOpen_ && !showGesturePanel_;
+    backgroundGestureDetector_->setEnabled( headless );
+}
+
+/***************************************************************************//**
+Called (through a queued connection) when the background gesture detector 
+finds a plus sign.  The detector has already turned itself off, so it is
+turned back on if the plus sign is not being used to quit apps.
+*******************************************************************************/
+void CentralWidget::onQuitGestureRecognized()
+{
+    if( multitouchAppOpen_ && !confirmExitBoxOpen_ && usePlusGestureToQuitApps_ ) {
+        openConfirmExitBox();
+    }
+    else {
+        updateBackgroundGestureDetection();
+    }
+}
+
 void CentralWidget::openConfirmShutdownBox()
 {
     paintWidget_->hideLoadingIconIfVisible();
@@ -36,7 +36,7 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #define GUI_CENTRAL_WIDGET_H
 
 #include "enums/TuioSourceEnum.h"
-#include <QScrollArea>
+#include <QAbstractScrollArea>
 #include <QImage>
 #include <QColor>
 #include <QRect>
@@ -48,13 +48,16 @@ namespace gui { class PaintWidget; }
 namespace gui { class ConfirmExitBox; }
 namespace gui { class ConfirmShutdownBox; }
 namespace gui { class TouchDetector; }
+namespace gui { class TouchTable; }
 namespace gui { class AppIcon; }
+namespace gui { class GLIconView; }
+namespace gestures { class BackgroundGestureDetector; }
 namespace app { class AppLauncher; }
 namespace sound { class IconSound; }
 
 namespace gui 
 {
-    class CentralWidget : public QScrollArea
+    class CentralWidget : public QAbstractScrollArea
     {
         Q_OBJECT
 
@@ -68,11 +71,13 @@ namespace gui
 
         void setTuioGeneratorIcon( enums::TuioSourceEnum::Enum tuioSource );
         sound::IconSound * iconSound();
+        gestures::BackgroundGestureDetector * backgroundGestureDetector();
         void readMultitouchAppsInfo();
         void hideConfirmExitBox();
         void hideConfirmShutdownBox();
         void onDeviceArrival( char driveLetter );
         void onDeviceRemoval( char driveLetter );
+        void useOpenGLRenderer( bool b );
 
     public slots:
         void readMultitouchAppsInfoAndUpdate();
@@ -87,7 +92,10 @@ namespace gui
         void showGesturePanel( bool b );
         void clearGesturePanelImage();
         void showShutdownComputerIcon( bool b );
+        void showTuioStats( bool b );
+        void setTuioStatsText( const QString & text );
         void openConfirmShutdownBox();
+        void onQuitGestureRecognized();
 
         void onMultitouchAppConfirmExitYes();
         void onMultitouchAppConfirmExitNo();
@@ -95,8 +103,18 @@ namespace gui
         void onShutdownPlaysurfaceRequest();
         void onCancelShutdownRequest();
 
+    private slots:
+        void updateScrollBarRange();
+        void onMultitouchAppsInfoChanged();
+        void onMultitouchAppsAppended( int index );
+        void onMultitouchAppInserted( int index );
+        void onMultitouchAppReplaced( int index );
+        void onMultitouchAppRemoved( int index );
+        void onOpenGLFailed();
+
     protected:
         void resizeEvent( QResizeEvent * event );
+        void scrollContentsBy( int dx, int dy );
         void mousePressEvent( QMouseEvent * e );
         bool event( QEvent * event );
 
@@ -109,12 +127,15 @@ namespace gui
         void onShutdownIconActivated();
         void onMultitouchAppIconActivated( int index );
         void handleTouchEvent( QEvent * e );
-        void handleTouchPointPressed( const QTouchEvent::TouchPoint & touchPoint );
-        void handleTouchPointUpdate( const QTouchEvent::TouchPoint & touchPoint );
-        void handleTouchPointReleased( const QTouchEvent::TouchPoint & touchPoint );
+        void observeTouchLatency( unsigned long postedAt );
+        void handleTouchPointPressed( const gui::TouchTable & touches, int i );
+        void handleTouchPointUpdate( const gui::TouchTable & touches, int i );
+        void handleTouchPointReleased( const gui::TouchTable & touches, int i );
         void killCurrentMultitouchApp();
         void startQuietPeriod( int milliseconds );
         void openConfirmExitBox();
+        void updateBackgroundGestureDetection();
+        void updateGLIconView();
         void debugPrintTouchEvent( QEvent * e );
         void debugPrintResizeEvent( int maxScrollBarValue );
 
@@ -125,13 +146,18 @@ namespace gui
         gui::ConfirmShutdownBox * confirmShutdownBox_;
         sound::IconSound * iconSound_;
         gui::TouchDetector * touchDetector_;
+        std::vector<gui::TouchTable *> touchTables_; // One per nested touch event.
+        int touchEventDepth_;
+        gui::GLIconView * glIconView_;
+        gestures::BackgroundGestureDetector * backgroundGestureDetector_;
         bool multitouchAppOpen_,
              usePlusGestureToQuitApps_,
              confirmExitBoxOpen_,
              confirmShutdownBoxOpen_,
              quietPeriod_,
              showGesturePanel_,
-             scrollBarVisible_;
+             scrollBarVisible_,
+             useOpenGLRenderer_;
     };
 }
 
@@ -42,6 +42,8 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #include "localclient/BigBlobbyClient.h"
 #include "localclient/TouchHooksClient.h"
 #include "playsurface/Playsurface.h"
+#include "logger/EventJournal.h"
+#include "metrics/MetricsServer.h"
 #include <QtGui>
 #include <QMenu>
 #include <QMenuBar>
@@ -76,6 +78,7 @@ FullScreenWindow::FullScreenWindow( playsurface::Playsurface * parent,
   windows8TouchAct_( NULL ),
   touchDetectorGroup_( NULL ),
   showShutdownComputerAct_( NULL ),
+  showTuioStatsAct_( NULL ),
   gesturesMenu_( NULL ),
   usePlusGestureToQuitApps_( NULL ),
   gesturesModeAct_( NULL ),
@@ -89,7 +92,8 @@ FullScreenWindow::FullScreenWindow( playsurface::Playsurface * parent,
   isMenuBarVisible_( false ),
   bigBlobbyClient_( new localclient::BigBlobbyClient() ),
   touchHooksClient_( new localclient::TouchHooksClient() ),
-  xmlSettings_( xmlSettings )
+  xmlSettings_( xmlSettings ),
+  metricsServer_( NULL )
 {
     connect( bigBlobbyClient_, 
              SIGNAL( bigBlobbySavedSettingsToXmlFiles() ),
@@ -148,11 +152,16 @@ void FullScreenWindow::createOptionsMenu()
     showShutdownComputerAct_ = new QAction( tr( "&Show Shutdown Computer Icon" ), this );
     showShutdownComputerAct_->setCheckable( true );
     showShutdownComputerAct_->setChecked( false );
+    showTuioStatsAct_ = new QAction( tr( "Show TUIO S&tatistics" ), this );
+    showTuioStatsAct_->setCheckable( true );
+    showTuioStatsAct_->setChecked( false );
 
     connect( showTaskbarAct_, SIGNAL( triggered( )), this, SLOT( showTaskbar() ) );
     connect( hideTaskbarAct_, SIGNAL( triggered() ), this, SLOT( hideTaskbar() ) );
     connect( showShutdownComputerAct_, SIGNAL( toggled( bool ) ), 
              centralWidget_, SLOT( showShutdownComputerIcon( bool ) ) );
+    connect( showTuioStatsAct_, SIGNAL( toggled( bool ) ), 
+             centralWidget_, SLOT( showTuioStats( bool ) ) );
 
     touchDetectorMenu_ = new QMenu( tr( "&Touch Detector" ), this );
     touchDetectorGroup_ = new QActionGroup( this );
@@ -187,6 +196,7 @@ void FullScreenWindow::createOptionsMenu()
     optionsMenu_->addMenu( touchDetectorMenu_ );
     optionsMenu_->addSeparator();
     optionsMenu_->addAction( showShutdownComputerAct_ );
+    optionsMenu_->addAction( showTuioStatsAct_ );
     menuBar()->addMenu( optionsMenu_ );
 }
 
@@ -228,6 +238,11 @@ enums::TuioSourceEnum::Enum FullScreenWindow::tuioGenerator()
     return appLauncher_->tuioGenerator();
 }
 
+gestures::BackgroundGestureDetector * FullScreenWindow::backgroundGestureDetector()
+{
+    return centralWidget_->backgroundGestureDetector();
+}
+
 void FullScreenWindow::createGesturesMenu()
 {
     gesturesMenu_ = new QMenu( tr( "&Gestures" ), this );
@@ -385,11 +400,13 @@ bool FullScreenWindow::winEvent( MSG * msg, long * result )
         switch( msg->wParam ) {
             case DBT_DEVICEARRIVAL:
                 driveLetter = getDriveLetterFromMsg( msg );
+                logger::EventJournal::instance().record( logger::EventJournal::DEVICE_ARRIVED, driveLetter );
                 centralWidget_->onDeviceArrival( driveLetter );
                 //std::cout << "Device arrival detected: drive = " << driveLetter << "\n";
                 break;
             case DBT_DEVICEREMOVECOMPLETE:
                 driveLetter = getDriveLetterFromMsg( msg );
+                logger::EventJournal::instance().record( logger::EventJournal::DEVICE_REMOVED, driveLetter );
                 centralWidget_->onDeviceRemoval( driveLetter );
                 //std::cout << "Device removal detected: drive = " << driveLetter << "\n";
                 break;
@@ -456,6 +473,11 @@ bool FullScreenWindow::isPlusSignGestureInUse()
     return usePlusGestureToQuitApps_->isChecked();
 }
 
+void FullScreenWindow::setTuioStatsText( const QString & text )
+{
+    centralWidget_->setTuioStatsText( text );
+}
+
 void FullScreenWindow::setOptionsMenuShowShutdownComputerIcon( bool b )
 {
     showShutdownComputerAct_->setChecked( b );
@@ -465,3 +487,29 @@ bool FullScreenWindow::isShutdownComputerIconShowing()
 {
     return showShutdownComputerAct_->isChecked();
 }
+
+void FullScreenWindow::useOpenGLRenderer( bool b )
+{
+    centralWidget_->useOpenGLRenderer( b );
+}
+
+void FullScreenWindow::useWarmStart( bool b, const QStringList & appNames )
+{
+    appLauncher_->useWarmStart( b, appNames );
+}
+
+/***************************************************************************//**
+A port of 0 turns the metrics endpoint off.
+*******************************************************************************/
+void FullScreenWindow::useMetricsPort( int port )
+{
+    if( port > 0 ) {
+        if( metricsServer_ == NULL ) {
+            metricsServer_ = new metrics::MetricsServer( this );
+        }
+        metricsServer_->listen( port );
+    }
+    else if( metricsServer_ != NULL ) {
+        metricsServer_->close();
+    }
+}
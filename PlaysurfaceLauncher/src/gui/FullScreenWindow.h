@@ -37,6 +37,7 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 
 #include "enums/TuioSourceEnum.h"
 #include <QMainWindow>
+#include <QStringList>
 #include <Windows.h>
 
 namespace playsurface { class Playsurface; }
@@ -45,9 +46,11 @@ namespace utils { class TaskbarUtility; }
 namespace gui { class CentralWidget; }
 namespace gui { class Help; }
 namespace gui { class XmlSettings; }
+namespace gestures { class BackgroundGestureDetector; }
 namespace sound { class IconSound; }
 namespace localclient { class BigBlobbyClient; }
 namespace localclient { class TouchHooksClient; }
+namespace metrics { class MetricsServer; }
 class QActionGroup;
 
 namespace gui
@@ -65,12 +68,16 @@ namespace gui
         virtual ~FullScreenWindow();
 
         enums::TuioSourceEnum::Enum tuioGenerator();
+        gestures::BackgroundGestureDetector * backgroundGestureDetector();
         void readMultitouchAppsInfo();
         void showFullScreenWindow();
         void setGesturesMenuPlusSignOption( bool usePlusSign );
         bool isPlusSignGestureInUse();
         void setOptionsMenuShowShutdownComputerIcon( bool b );
         bool isShutdownComputerIconShowing();
+        void useOpenGLRenderer( bool b );
+        void useWarmStart( bool b, const QStringList & appNames );
+        void useMetricsPort( int port );
         
     public slots:
         void shutdownComputer();
@@ -83,6 +90,7 @@ namespace gui
         void showMenuBar();
         bool isMenuBarOpen();
         void updateMainWindowSettings();
+        void setTuioStatsText( const QString & text );
 
         void onBigBlobbyGeneratorSelected( bool b );
         void onTouchHooks2TuioGeneratorSelected( bool b );
@@ -123,6 +131,7 @@ namespace gui
         QActionGroup * touchDetectorGroup_;
         
         QAction * showShutdownComputerAct_;
+        QAction * showTuioStatsAct_;
 
         QMenu * gesturesMenu_;
         QAction * usePlusGestureToQuitApps_,
@@ -143,6 +152,7 @@ namespace gui
         localclient::BigBlobbyClient * bigBlobbyClient_;
         localclient::TouchHooksClient * touchHooksClient_;
         gui::XmlSettings * xmlSettings_;
+        metrics::MetricsServer * metricsServer_;
     };
 }
 
@@ -0,0 +1,562 @@
+/*******************************************************************************
+GLIconView
+
+PURPOSE: Draws the launcher background and icons with OpenGL, using the
+         shared IconAtlas pages and a few batched draw calls per page.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "gui/GLIconView.h"
+#include "gui/PaintWidget.h"
+#include "gui/AppIcon.h"
+#include "logger/FileLogger.h"
+#include <QOpenGLShaderProgram>
+#include <QOpenGLTexture>
+#include <QOpenGLBuffer>
+#include <QImage>
+#include <QPainter>
+
+using gui::GLIconView;
+
+const int GLIconView::SPRITE_PAGE_SIZE = 2048,
+          GLIconView::FLOATS_PER_VERTEX = 4,
+          GLIconView::VERTICES_PER_QUAD = 6;
+
+static const char * VERTEX_SHADER =
+    "attribute highp vec2 position;\n"
+    "attribute highp vec2 texCoord;\n"
+    "uniform highp mat4 matrix;\n"
+    "varying highp vec2 uv;\n"
+    "void main()\n"
+    "{\n"
+    "    uv = texCoord;\n"
+    "    gl_Position = matrix * vec4( position, 0.0, 1.0 );\n"
+    "}\n";
+
+static const char * FRAGMENT_SHADER =
+    "uniform sampler2D texture;\n"
+    "varying highp vec2 uv;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_FragColor = texture2D( texture, uv );\n"
+    "}\n";
+
+GLIconView::GLIconView( gui::PaintWidget * paintWidget, QWidget * parent ) :
+  QOpenGLWidget( parent ),
+  paintWidget_( paintWidget ),
+  program_( NULL ),
+  backgroundTexture_( NULL ),
+  backgroundBuffer_( NULL ),
+  backgroundVertexCount_( 0 ),
+  spritePages_(),
+  iconPages_(),
+  atlasEntries_(),
+  pageSize_( SPRITE_PAGE_SIZE, SPRITE_PAGE_SIZE ),
+  maxTextureSize_( 0 ),
+  atlasMinX_( 0 ),
+  atlasMaxX_( 0 ),
+  spriteX_( 0 ),
+  spriteY_( 0 ),
+  spriteRowHeight_( 0 ),
+  projection_(),
+  scrollOffset_( 0 ),
+  atlasDirty_( true ),
+  verticesDirty_( true ),
+  failed_( false )
+{
+    setAttribute( Qt::WA_TransparentForMouseEvents );
+    connect( paintWidget_, SIGNAL( iconLayerChanged() ), this, SLOT( onIconLayerChanged() ) );
+    connect( paintWidget_, SIGNAL( grayIconsChanged() ), this, SLOT( onGrayIconsChanged() ) );
+}
+
+/***************************************************************************//**
+The textures and buffers belong to this widget's context, so the context is
+made current while they are deleted.
+*******************************************************************************/
+GLIconView::~GLIconView()
+{
+    makeCurrent();
+    deleteAtlas();
+
+    for( int i = 0; i < (int)iconPages_.size(); ++i ) {
+        deletePage( iconPages_.at( i ) );
+    }
+    deleteBackground();
+    delete program_;
+    doneCurrent();
+}
+
+void GLIconView::setScrollOffset( int x )
+{
+    scrollOffset_ = x;
+    updateProjection( width(), height() );
+    update();
+}
+
+void GLIconView::onIconLayerChanged()
+{
+    atlasDirty_ = true;
+    update();
+}
+
+void GLIconView::onGrayIconsChanged()
+{
+    verticesDirty_ = true;
+    update();
+}
+
+void GLIconView::initializeGL()
+{
+    initializeOpenGLFunctions();
+    GLint maxTextureSize = 0;
+    glGetIntegerv( GL_MAX_TEXTURE_SIZE, &maxTextureSize );
+    maxTextureSize_ = maxTextureSize;
+
+    if( maxTextureSize_ > 0 && maxTextureSize_ < SPRITE_PAGE_SIZE ) {
+        pageSize_ = QSize( maxTextureSize_, maxTextureSize_ );
+    }
+    createShaderProgram();
+    QColor color = PaintWidget::BACKGROUND_COLOR;
+    glClearColor( color.redF(), color.greenF(), color.blueF(), 1.0f );
+    glEnable( GL_BLEND );
+    glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+    atlasDirty_ = true;
+}
+
+void GLIconView::createShaderProgram()
+{
+    program_ = new QOpenGLShaderProgram();
+    program_->addShaderFromSourceCode( QOpenGLShader::Vertex, VERTEX_SHADER );
+    program_->addShaderFromSourceCode( QOpenGLShader::Fragment, FRAGMENT_SHADER );
+    program_->bindAttributeLocation( "position", 0 );
+    program_->bindAttributeLocation( "texCoord", 1 );
+
+    if( !program_->link() ) {
+        fail( "could not link the shader program: " + program_->log() );
+    }
+}
+
+/***************************************************************************//**
+Logs the problem and asks (once) to be replaced by the raster PaintWidget, 
+since this view cannot draw anything but the background color.
+*******************************************************************************/
+void GLIconView::fail( const QString & problem )
+{
+    if( !failed_ ) {
+        failed_ = true;
+        QString message = "GLIconView " + problem.trimmed() 
+                        + " (going back to drawing the icons without OpenGL)";
+        logger::FileLogger::instance().writeError( message.toStdString() );
+        emit openGLFailed();
+    }
+}
+
+void GLIconView::resizeGL( int w, int h )
+{
+    updateProjection( w, h );
+}
+
+/***************************************************************************//**
+The projection maps PaintWidget coordinates (y pointing down) to the screen,
+shifted left by the scroll bar value.
+*******************************************************************************/
+void GLIconView::updateProjection( int w, int h )
+{
+    projection_.setToIdentity();
+    projection_.ortho( scrollOffset_, scrollOffset_ + w, h, 0, -1, 1 );
+}
+
+void GLIconView::paintGL()
+{
+    glClear( GL_COLOR_BUFFER_BIT );
+
+    if( failed_ ) {
+        return;
+    }
+    if( !program_->bind() ) {
+        fail( "could not bind the shader program" );
+        return;
+    }
+    if( scrollOffset_ < atlasMinX_ || scrollOffset_ + width() > atlasMaxX_ ) {
+        atlasDirty_ = true;
+    }
+    if( atlasDirty_ ) {
+        rebuildAtlas();
+        rebuildBackground();
+        atlasDirty_ = false;
+        verticesDirty_ = true;
+    }
+    if( verticesDirty_ ) {
+        rebuildVertexBuffers();
+        verticesDirty_ = false;
+    }
+    program_->setUniformValue( "matrix", projection_ );
+    program_->setUniformValue( "texture", 0 );
+    drawQuads( backgroundTexture_, backgroundBuffer_, backgroundVertexCount_ );
+
+    for( int i = 0; i < (int)spritePages_.size(); ++i ) {
+        Page & page = spritePages_.at( i );
+        drawQuads( page.texture, page.underBuffer, page.underVertexCount );
+    }
+    for( int i = 0; i < (int)iconPages_.size(); ++i ) {
+        Page & page = iconPages_.at( i );
+        drawQuads( page.texture, page.underBuffer, page.underVertexCount );
+    }
+    for( int i = 0; i < (int)spritePages_.size(); ++i ) {
+        Page & page = spritePages_.at( i );
+        drawQuads( page.texture, page.overBuffer, page.overVertexCount );
+    }
+    program_->release();
+}
+
+/***************************************************************************//**
+An app icon whose image is in one of the PaintWidget's IconAtlas pages only
+needs its frame and gray overlay in the sprite pages (one pair for each icon
+size); every other icon is drawn whole.  Only the icons in the PaintWidget's
+decode window are included, so the cost of a rebuild does not grow with the
+number of apps.  The IconAtlas pages already uploaded are kept, so a change 
+to the icon layer only uploads pages that are new.
+*******************************************************************************/
+void GLIconView::rebuildAtlas()
+{
+    deleteAtlas();
+    std::vector<Page> oldIconPages;
+    oldIconPages.swap( iconPages_ );
+    std::vector<gui::AppIcon *> icons = paintWidget_->iconsInDecodeWindow( atlasMinX_, atlasMaxX_ );
+    std::vector<AtlasEntry> frameEntries; // One for each icon size.
+    std::vector<QImage> pageImages;
+    QPainter painter;
+    spriteX_ = 0;
+    spriteY_ = 0;
+    spriteRowHeight_ = 0;
+
+    for( int i = 0; i < (int)icons.size(); ++i ) {
+        gui::AppIcon * icon = icons.at( i );
+        AtlasEntry entry;
+        entry.icon = icon;
+        entry.page = -1;
+        entry.iconPage = iconPageFor( icon, oldIconPages );
+
+        if( entry.iconPage >= 0 ) {
+            QSize pageSize = icon->atlasPage().size();
+            QRect rect = icon->atlasRect();
+            entry.iconTexRect = QRectF( rect.x() / (double)pageSize.width(),
+                                        rect.y() / (double)pageSize.height(),
+                                        rect.width() / (double)pageSize.width(),
+                                        rect.height() / (double)pageSize.height() );
+            int frame = 0;
+
+            while( frame < (int)frameEntries.size() 
+                   && frameEntries.at( frame ).icon->rect().size() != icon->rect().size() ) {
+                ++frame;
+            }
+            if( frame == (int)frameEntries.size() ) {
+                AtlasEntry frameEntry = entry;
+                addSprites( pageImages,
+                            painter,
+                            paintWidget_->appIconFrameSprite( icon->rect().size(), false ),
+                            paintWidget_->appIconFrameSprite( icon->rect().size(), true ),
+                            frameEntry );
+                frameEntries.push_back( frameEntry );
+            }
+            entry.page = frameEntries.at( frame ).page;
+            entry.normalTexRect = frameEntries.at( frame ).normalTexRect;
+            entry.grayTexRect = frameEntries.at( frame ).grayTexRect;
+        }
+        else {
+            addSprites( pageImages,
+                        painter,
+                        paintWidget_->iconSprite( icon, false ),
+                        paintWidget_->iconSprite( icon, true ),
+                        entry );
+        }
+        if( entry.page >= 0 ) {
+            atlasEntries_.push_back( entry );
+        }
+    }
+    if( painter.isActive() ) {
+        painter.end();
+    }
+    for( int i = 0; i < (int)pageImages.size(); ++i ) {
+        spritePages_.push_back( createPage( pageImages.at( i ) ) );
+    }
+    for( int i = 0; i < (int)oldIconPages.size(); ++i ) {
+        deletePage( oldIconPages.at( i ) );
+    }
+}
+
+/***************************************************************************//**
+Returns the index in iconPages_ of the texture for the IconAtlas page that
+holds the icon's image (taking it from the old pages, or uploading it, if it
+is not there yet), or -1 if the icon is not in an IconAtlas page or the page
+is too large for a texture.
+*******************************************************************************/
+int GLIconView::iconPageFor( gui::AppIcon * icon, std::vector<Page> & oldIconPages )
+{
+    QImage atlasPage = icon->atlasPage();
+
+    if( atlasPage.isNull() 
+        || icon->atlasRect().isEmpty()
+        || (maxTextureSize_ > 0 && (atlasPage.width() > maxTextureSize_ 
+                                    || atlasPage.height() > maxTextureSize_)) ) {
+        return -1;
+    }
+    for( int i = 0; i < (int)iconPages_.size(); ++i ) {
+        if( iconPages_.at( i ).imageKey == atlasPage.cacheKey() ) {
+            return i;
+        }
+    }
+    Page page;
+    page.texture = NULL;
+
+    for( int i = 0; i < (int)oldIconPages.size(); ++i ) {
+        if( oldIconPages.at( i ).imageKey == atlasPage.cacheKey() ) {
+            page = oldIconPages.at( i );
+            oldIconPages.erase( oldIconPages.begin() + i );
+            break;
+        }
+    }
+    if( page.texture == NULL ) {
+        page = createPage( atlasPage );
+    }
+    iconPages_.push_back( page );
+    return (int)iconPages_.size() - 1;
+}
+
+/***************************************************************************//**
+Puts the normal sprite with the gray sprite just to its right into the next
+cell of the sprite pages, and records where they went in the entry.  Cells 
+are packed left to right in rows, and a new page is started when a page is 
+full.  A pair too large for a page is left out (the entry's page stays -1).
+*******************************************************************************/
+void GLIconView::addSprites( std::vector<QImage> & pageImages, 
+                             QPainter & painter,
+                             const QImage & normal, 
+                             const QImage & gray, 
+                             AtlasEntry & entry )
+{
+    int w = normal.width() + gray.width(),
+        h = qMax( normal.height(), gray.height() );
+
+    if( w > pageSize_.width() || h > pageSize_.height() ) {
+        return;
+    }
+    if( spriteX_ + w > pageSize_.width() ) {
+        spriteX_ = 0;
+        spriteY_ += spriteRowHeight_;
+        spriteRowHeight_ = 0;
+    }
+    if( pageImages.empty() || spriteY_ + h > pageSize_.height() ) {
+        if( painter.isActive() ) {
+            painter.end();
+        }
+        pageImages.push_back( QImage( pageSize_, QImage::Format_ARGB32_Premultiplied ) );
+        pageImages.back().fill( Qt::transparent );
+        painter.begin( &pageImages.back() );
+        painter.setCompositionMode( QPainter::CompositionMode_Source );
+        spriteX_ = 0;
+        spriteY_ = 0;
+        spriteRowHeight_ = 0;
+    }
+    painter.drawImage( spriteX_, spriteY_, normal );
+    painter.drawImage( spriteX_ + normal.width(), spriteY_, gray );
+
+    double pw = pageSize_.width(),
+           ph = pageSize_.height();
+    entry.page = (int)pageImages.size() - 1;
+    entry.normalTexRect = QRectF( spriteX_ / pw, spriteY_ / ph, normal.width() / pw, normal.height() / ph );
+    entry.grayTexRect = QRectF( (spriteX_ + normal.width()) / pw, spriteY_ / ph, gray.width() / pw, gray.height() / ph );
+
+    spriteX_ += w;
+    spriteRowHeight_ = qMax( spriteRowHeight_, h );
+}
+
+/***************************************************************************//**
+The background image is uploaded once at the size of one screen and drawn
+as many times as needed to cover the width of the PaintWidget.
+*******************************************************************************/
+void GLIconView::rebuildBackground()
+{
+    deleteBackground();
+    QImage tile = paintWidget_->backgroundTile();
+    backgroundTexture_ = new QOpenGLTexture( tile, QOpenGLTexture::DontGenerateMipMaps );
+    backgroundTexture_->setMinMagFilters( QOpenGLTexture::Linear, QOpenGLTexture::Linear );
+    backgroundTexture_->setWrapMode( QOpenGLTexture::ClampToEdge );
+
+    std::vector<float> vertices;
+    int tileWidth = qMax( tile.width(), 1 );
+
+    for( int x = 0; x < paintWidget_->contentWidth(); x += tileWidth ) {
+        addQuad( vertices, QRectF( x, 0, tile.width(), tile.height() ), QRectF( 0, 0, 1, 1 ) );
+    }
+    backgroundBuffer_ = new QOpenGLBuffer( QOpenGLBuffer::VertexBuffer );
+    backgroundBuffer_->create();
+    uploadVertices( backgroundBuffer_, vertices );
+    backgroundVertexCount_ = (int)vertices.size() / FLOATS_PER_VERTEX;
+}
+
+/***************************************************************************//**
+Writes the quads for every page into that page's vertex buffers: the whole
+normal or gray sprite for an icon drawn from the sprite pages, or else the
+frame, the image from its IconAtlas page, and (when gray) the overlay.
+*******************************************************************************/
+void GLIconView::rebuildVertexBuffers()
+{
+    std::vector<std::vector<float> > underVertices( spritePages_.size() ),
+                                     overVertices( spritePages_.size() ),
+                                     iconVertices( iconPages_.size() );
+
+    for( int i = 0; i < (int)atlasEntries_.size(); ++i ) {
+        AtlasEntry & entry = atlasEntries_.at( i );
+        QRectF rect = QRectF( entry.icon->rect() ),
+               spriteRect = rect.adjusted( -1, -1, 1, 1 );
+        bool gray = paintWidget_->isIconGray( entry.icon );
+
+        if( entry.iconPage < 0 ) {
+            addQuad( underVertices.at( entry.page ), 
+                     spriteRect, 
+                     gray ? entry.grayTexRect : entry.normalTexRect );
+        }
+        else {
+            addQuad( underVertices.at( entry.page ), spriteRect, entry.normalTexRect );
+            addQuad( iconVertices.at( entry.iconPage ), rect, entry.iconTexRect );
+
+            if( gray ) {
+                addQuad( overVertices.at( entry.page ), spriteRect, entry.grayTexRect );
+            }
+        }
+    }
+    for( int i = 0; i < (int)spritePages_.size(); ++i ) {
+        Page & page = spritePages_.at( i );
+        uploadVertices( page.underBuffer, underVertices.at( i ) );
+        uploadVertices( page.overBuffer, overVertices.at( i ) );
+        page.underVertexCount = (int)underVertices.at( i ).size() / FLOATS_PER_VERTEX;
+        page.overVertexCount = (int)overVertices.at( i ).size() / FLOATS_PER_VERTEX;
+    }
+    for( int i = 0; i < (int)iconPages_.size(); ++i ) {
+        Page & page = iconPages_.at( i );
+        uploadVertices( page.underBuffer, iconVertices.at( i ) );
+        page.underVertexCount = (int)iconVertices.at( i ).size() / FLOATS_PER_VERTEX;
+    }
+}
+
+/***************************************************************************//**
+Appends two triangles (x, y, s, t for each corner) covering the rectangle.
+*******************************************************************************/
+void GLIconView::addQuad( std::vector<float> & vertices, const QRectF & rect, const QRectF & texRect )
+{
+    float x1 = rect.left(),
+          y1 = rect.top(),
+          x2 = rect.right(),
+          y2 = rect.bottom(),
+          s1 = texRect.left(),
+          t1 = texRect.top(),
+          s2 = texRect.right(),
+          t2 = texRect.bottom();
+    float quad[] = { x1, y1, s1, t1,
+                     x2, y1, s2, t1,
+                     x1, y2, s1, t2,
+                     x2, y1, s2, t1,
+                     x2, y2, s2, t2,
+                     x1, y2, s1, t2 };
+    vertices.insert( vertices.end(), quad, quad + VERTICES_PER_QUAD * FLOATS_PER_VERTEX );
+}
+
+void GLIconView::uploadVertices( QOpenGLBuffer * buffer, const std::vector<float> & vertices )
+{
+    buffer->bind();
+    buffer->allocate( vertices.empty() ? NULL : &vertices.at( 0 ),
+                      (int)(vertices.size() * sizeof( float )) );
+    buffer->release();
+}
+
+void GLIconView::drawQuads( QOpenGLTexture * texture, QOpenGLBuffer * buffer, int vertexCount )
+{
+    if( texture == NULL || buffer == NULL || vertexCount == 0 ) {
+        return;
+    }
+    int stride = FLOATS_PER_VERTEX * sizeof( float );
+    texture->bind();
+    buffer->bind();
+    program_->enableAttributeArray( 0 );
+    program_->enableAttributeArray( 1 );
+    program_->setAttributeBuffer( 0, GL_FLOAT, 0, 2, stride );
+    program_->setAttributeBuffer( 1, GL_FLOAT, 2 * sizeof( float ), 2, stride );
+    glDrawArrays( GL_TRIANGLES, 0, vertexCount );
+    program_->disableAttributeArray( 0 );
+    program_->disableAttributeArray( 1 );
+    buffer->release();
+    texture->release();
+}
+
+GLIconView::Page GLIconView::createPage( const QImage & image )
+{
+    Page page;
+    page.texture = new QOpenGLTexture( image, QOpenGLTexture::DontGenerateMipMaps );
+    page.texture->setMinMagFilters( QOpenGLTexture::Linear, QOpenGLTexture::Linear );
+    page.texture->setWrapMode( QOpenGLTexture::ClampToEdge );
+    page.imageKey = image.cacheKey();
+    page.underBuffer = new QOpenGLBuffer( QOpenGLBuffer::VertexBuffer );
+    page.underBuffer->create();
+    page.overBuffer = new QOpenGLBuffer( QOpenGLBuffer::VertexBuffer );
+    page.overBuffer->create();
+    page.underVertexCount = 0;
+    page.overVertexCount = 0;
+    return page;
+}
+
+void GLIconView::deletePage( Page & page )
+{
+    delete page.texture;
+    delete page.underBuffer;
+    delete page.overBuffer;
+    page.texture = NULL;
+    page.underBuffer = NULL;
+    page.overBuffer = NULL;
+}
+
+/***************************************************************************//**
+Deletes the sprite pages.  The IconAtlas page textures are kept until 
+rebuildAtlas() finds out which of them are still in use.
+*******************************************************************************/
+void GLIconView::deleteAtlas()
+{
+    for( int i = 0; i < (int)spritePages_.size(); ++i ) {
+        deletePage( spritePages_.at( i ) );
+    }
+    spritePages_.clear();
+    atlasEntries_.clear();
+}
+
+void GLIconView::deleteBackground()
+{
+    delete backgroundTexture_;
+    delete backgroundBuffer_;
+    backgroundTexture_ = NULL;
+    backgroundBuffer_ = NULL;
+    backgroundVertexCount_ = 0;
+}
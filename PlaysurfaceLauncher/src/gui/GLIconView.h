@@ -0,0 +1,182 @@
+/*******************************************************************************
+GLIconView
+
+PURPOSE: Draws the launcher background and icons with OpenGL, using the
+         shared IconAtlas pages and a few batched draw calls per page.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef GUI_GLICONVIEW_H
+#define GUI_GLICONVIEW_H
+
+#include <QOpenGLWidget>
+#include <QOpenGLFunctions>
+#include <QMatrix4x4>
+#include <QRectF>
+#include <QSize>
+#include <vector>
+
+namespace gui { class PaintWidget; }
+namespace gui { class AppIcon; }
+class QOpenGLShaderProgram;
+class QOpenGLTexture;
+class QOpenGLBuffer;
+
+namespace gui
+{
+    /***********************************************************************//**
+    Draws the background and icons of the PaintWidget with OpenGL.  The view
+    sits on top of the CentralWidget's viewport (it does not scroll with the
+    PaintWidget), and scrolling is just a translation of the projection
+    matrix, so moving the scroll bar costs the same no matter how many icons
+    there are.
+
+    The app icon images are drawn straight from the PaintWidget's IconAtlas
+    pages, which are uploaded as textures once and shared with the raster
+    PaintWidget.  Only the parts that are not in the IconAtlas (the white
+    frame and gray overlay of an app icon, the TUIO generator, reload, and
+    shutdown icons, and any app icon that has not been packed yet) are drawn
+    into small sprite pages of this view's own.  The quads for each page are
+    kept in vertex buffers, so a frame is one draw call for the tiled 
+    background plus a few draw calls per page.  The pages only hold the 
+    icons in the PaintWidget's decode window (the view plus 
+    DECODE_AHEAD_SCREENS view widths on either side), and are rebuilt when
+    the PaintWidget reports that its icon layer changed or when the view is
+    scrolled out of that window; a change in which icons are gray only 
+    rewrites the vertex buffers.
+
+    If the shader program cannot be linked, the problem is logged and 
+    openGLFailed() is emitted, so the CentralWidget can go back to the 
+    raster PaintWidget.
+
+    Touches and mouse clicks pass straight through to the widgets below.
+    ***************************************************************************/
+    class GLIconView : public QOpenGLWidget, protected QOpenGLFunctions
+    {
+        Q_OBJECT
+
+    public:
+        static const int SPRITE_PAGE_SIZE,
+                         FLOATS_PER_VERTEX,
+                         VERTICES_PER_QUAD;
+
+        GLIconView( gui::PaintWidget * paintWidget, QWidget * parent );
+        virtual ~GLIconView();
+
+    signals:
+        void openGLFailed();
+
+    public slots:
+        void setScrollOffset( int x );
+        void onIconLayerChanged();
+        void onGrayIconsChanged();
+
+    protected:
+        void initializeGL();
+        void resizeGL( int w, int h );
+        void paintGL();
+
+    private:
+        /*******************************************************************//**
+        Where an icon's pieces were placed.  For an icon drawn from an 
+        IconAtlas page, the sprite page holds its frame (normalTexRect) and 
+        gray overlay (grayTexRect), and iconPage/iconTexRect locate its image.
+        Otherwise iconPage is -1 and the sprite page holds the whole icon in
+        its normal and gray versions.  The texture rectangles are in 
+        normalized (0 to 1) units.
+        ***********************************************************************/
+        class AtlasEntry
+        {
+        public:
+            gui::AppIcon * icon;
+            int page;
+            QRectF normalTexRect,
+                   grayTexRect;
+            int iconPage;
+            QRectF iconTexRect;
+        };
+
+        /*******************************************************************//**
+        A texture with the vertex buffers of the quads drawn from it.  The 
+        quads in underBuffer are drawn before the IconAtlas pages, and the 
+        ones in overBuffer (the gray overlays) after them.
+        ***********************************************************************/
+        class Page
+        {
+        public:
+            QOpenGLTexture * texture;
+            qint64 imageKey;
+            QOpenGLBuffer * underBuffer,
+                          * overBuffer;
+            int underVertexCount,
+                overVertexCount;
+        };
+
+        void createShaderProgram();
+        void fail( const QString & problem );
+        void rebuildAtlas();
+        int iconPageFor( gui::AppIcon * icon, std::vector<Page> & oldIconPages );
+        void addSprites( std::vector<QImage> & pageImages, 
+                         QPainter & painter,
+                         const QImage & normal, 
+                         const QImage & gray, 
+                         AtlasEntry & entry );
+        void rebuildBackground();
+        void rebuildVertexBuffers();
+        void addQuad( std::vector<float> & vertices, const QRectF & rect, const QRectF & texRect );
+        void uploadVertices( QOpenGLBuffer * buffer, const std::vector<float> & vertices );
+        void drawQuads( QOpenGLTexture * texture, QOpenGLBuffer * buffer, int vertexCount );
+        void updateProjection( int w, int h );
+        Page createPage( const QImage & image );
+        void deletePage( Page & page );
+        void deleteAtlas();
+        void deleteBackground();
+
+        gui::PaintWidget * paintWidget_;
+        QOpenGLShaderProgram * program_;
+        QOpenGLTexture * backgroundTexture_;
+        QOpenGLBuffer * backgroundBuffer_;
+        int backgroundVertexCount_;
+        std::vector<Page> spritePages_,
+                          iconPages_;
+        std::vector<AtlasEntry> atlasEntries_;
+        QSize pageSize_;
+        int maxTextureSize_,
+            atlasMinX_,
+            atlasMaxX_,
+            spriteX_,
+            spriteY_,
+            spriteRowHeight_;
+        QMatrix4x4 projection_;
+        int scrollOffset_;
+        bool atlasDirty_,
+             verticesDirty_,
+             failed_;
+    };
+}
+
+#endif
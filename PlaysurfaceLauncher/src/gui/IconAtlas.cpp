@@ -0,0 +1,428 @@
+/*******************************************************************************
+IconAtlas
+
+PURPOSE: Packs the app icon images into a few large atlas pages with a skyline
+         packer, and caches the pages between runs.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "gui/IconAtlas.h"
+#include "logger/FileLogger.h"
+#include <QPainter>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDataStream>
+#include <QDateTime>
+#include <algorithm>
+
+using gui::IconAtlas;
+
+const QString IconAtlas::CACHE_DIRECTORY = "Data/Cache/IconAtlas",
+              IconAtlas::INDEX_FILE = "IconAtlas.dat",
+              IconAtlas::PAGE_FILE_PREFIX = "IconAtlasPage_";
+const int IconAtlas::PAGE_WIDTH = 2048,
+          IconAtlas::PAGE_HEIGHT = 2048,
+          IconAtlas::MAX_ICON_SIZE = 200,
+          IconAtlas::PADDING = 1,
+          IconAtlas::FILE_VERSION = 2;
+
+/***************************************************************************//**
+Builds the key for one icon from the path, size, and modification time of
+its file, so an edited icon file gets a new key.
+*******************************************************************************/
+QString IconAtlas::iconKey( const QString & iconPath )
+{
+    QFileInfo fileInfo( iconPath );
+    return fileInfo.absoluteFilePath() + "|"
+         + QString::number( fileInfo.size() ) + "|"
+         + QString::number( fileInfo.lastModified().toMSecsSinceEpoch() );
+}
+
+/***************************************************************************//**
+Packs and saves a new atlas.  Meant to be run on a worker thread (the caller
+owns the atlas that is returned), so the GUI thread never waits for the 
+packing or for the PNG pages to be written.  If the atlas cannot be saved, 
+that is logged, and it is packed again the next time the launcher starts.
+*******************************************************************************/
+gui::IconAtlas * IconAtlas::buildAndSave( const std::vector<QImage> & images, 
+                                          const std::vector<QString> & keys,
+                                          const QString & directory )
+{
+    gui::IconAtlas * atlas = new gui::IconAtlas();
+    atlas->build( images, keys );
+
+    if( !atlas->save( directory ) ) {
+        QString message = "IconAtlas: could not save the icon atlas to " + directory;
+        logger::FileLogger::instance().writeWarning( message.toStdString() );
+    }
+    return atlas;
+}
+
+IconAtlas::IconAtlas() :
+  pages_(),
+  skylines_(),
+  pageIndices_(),
+  rects_(),
+  keys_(),
+  indexByKey_()
+{
+}
+
+IconAtlas::~IconAtlas()
+{
+}
+
+void IconAtlas::clear()
+{
+    pages_.clear();
+    skylines_.clear();
+    pageIndices_.clear();
+    rects_.clear();
+    keys_.clear();
+    indexByKey_.clear();
+}
+
+/***************************************************************************//**
+Packs the images, tallest first, into as many pages as needed.  When the
+packing is done, each page is cropped to the height actually used, so a
+launcher with only a few apps does not hold a full 2048 x 2048 page.  The
+keys give the key of each image (see iconKey()).
+*******************************************************************************/
+void IconAtlas::build( const std::vector<QImage> & images, const std::vector<QString> & keys )
+{
+    clear();
+
+    for( int i = 0; i < (int)keys.size() && i < (int)images.size(); ++i ) {
+        keys_.push_back( keys.at( i ) );
+        indexByKey_.insert( keys.at( i ), i );
+    }
+    keys_.resize( images.size() );
+    std::vector<QImage> scaledImages;
+    std::vector<int> order;
+
+    for( int i = 0; i < (int)images.size(); ++i ) {
+        scaledImages.push_back( fitToMaxIconSize( images.at( i ) ) );
+        order.push_back( i );
+    }
+    std::stable_sort( order.begin(), order.end(),
+        [&scaledImages]( int a, int b ) {
+            return scaledImages.at( a ).height() > scaledImages.at( b ).height();
+        } );
+    pageIndices_.resize( images.size(), -1 );
+    rects_.resize( images.size() );
+
+    for( int i = 0; i < (int)order.size(); ++i ) {
+        int index = order.at( i );
+        const QImage & image = scaledImages.at( index );
+        int w = image.width() + 2 * PADDING,
+            h = image.height() + 2 * PADDING,
+            pageIndex = 0,
+            nodeIndex = -1,
+            x = 0,
+            y = 0;
+
+        if( image.isNull() ) {
+            continue;
+        }
+        while( pageIndex < (int)pages_.size()
+               && !findPosition( pageIndex, w, h, nodeIndex, x, y ) )
+        {
+            ++pageIndex;
+        }
+        if( pageIndex == (int)pages_.size() ) {
+            addPage();
+
+            if( !findPosition( pageIndex, w, h, nodeIndex, x, y ) ) {
+                continue;
+            }
+        }
+        addSkylineLevel( pageIndex, nodeIndex, x, y, w, h );
+        QPainter painter( &pages_.at( pageIndex ) );
+        painter.setCompositionMode( QPainter::CompositionMode_Source );
+        painter.drawImage( x + PADDING, y + PADDING, image );
+        painter.end();
+        pageIndices_.at( index ) = pageIndex;
+        rects_.at( index ) = QRect( x + PADDING, y + PADDING, image.width(), image.height() );
+    }
+    for( int p = 0; p < (int)pages_.size(); ++p ) {
+        int usedHeight = 0;
+
+        for( int n = 0; n < (int)skylines_.at( p ).size(); ++n ) {
+            usedHeight = std::max( usedHeight, skylines_.at( p ).at( n ).y );
+        }
+        pages_.at( p ) = pages_.at( p ).copy( 0, 0, PAGE_WIDTH, usedHeight );
+    }
+    skylines_.clear();
+}
+
+QImage IconAtlas::fitToMaxIconSize( const QImage & image )
+{
+    QImage argbImage = image.convertToFormat( QImage::Format_ARGB32_Premultiplied );
+
+    if( image.width() > MAX_ICON_SIZE || image.height() > MAX_ICON_SIZE ) {
+        return argbImage.scaled( MAX_ICON_SIZE, MAX_ICON_SIZE,
+                                 Qt::KeepAspectRatio,
+                                 Qt::SmoothTransformation );
+    }
+    return argbImage;
+}
+
+void IconAtlas::addPage()
+{
+    QImage page( PAGE_WIDTH, PAGE_HEIGHT, QImage::Format_ARGB32_Premultiplied );
+    page.fill( Qt::transparent );
+    pages_.push_back( page );
+
+    SkylineNode node;
+    node.x = 0;
+    node.y = 0;
+    node.width = PAGE_WIDTH;
+    skylines_.push_back( std::vector<SkylineNode>( 1, node ) );
+}
+
+/***************************************************************************//**
+Finds the lowest place on the skyline where a width x height rectangle fits
+(breaking ties by the leftmost place).  Returns false if it does not fit
+anywhere on the page.
+*******************************************************************************/
+bool IconAtlas::findPosition( int pageIndex, int width, int height,
+                              int & nodeIndex, int & x, int & y )
+{
+    std::vector<SkylineNode> & skyline = skylines_.at( pageIndex );
+    int bestY = PAGE_HEIGHT + 1;
+    nodeIndex = -1;
+
+    for( int i = 0; i < (int)skyline.size(); ++i ) {
+        int fitY = fitAtNode( pageIndex, i, width, height );
+
+        if( fitY >= 0 && fitY < bestY ) {
+            bestY = fitY;
+            nodeIndex = i;
+            x = skyline.at( i ).x;
+            y = fitY;
+        }
+    }
+    return nodeIndex >= 0;
+}
+
+/***************************************************************************//**
+Returns the y value at which a rectangle starting at the left edge of the
+node would rest on the skyline, or -1 if it would stick out of the page.
+*******************************************************************************/
+int IconAtlas::fitAtNode( int pageIndex, int nodeIndex, int width, int height )
+{
+    std::vector<SkylineNode> & skyline = skylines_.at( pageIndex );
+    int x = skyline.at( nodeIndex ).x,
+        y = 0,
+        widthLeft = width;
+
+    if( x + width > PAGE_WIDTH ) {
+        return -1;
+    }
+    for( int i = nodeIndex; widthLeft > 0; ++i ) {
+        if( i >= (int)skyline.size() ) {
+            return -1;
+        }
+        y = std::max( y, skyline.at( i ).y );
+
+        if( y + height > PAGE_HEIGHT ) {
+            return -1;
+        }
+        widthLeft -= skyline.at( i ).width;
+    }
+    return y;
+}
+
+/***************************************************************************//**
+Raises the skyline over the newly placed rectangle, trimming (or removing)
+the nodes that it now covers.
+*******************************************************************************/
+void IconAtlas::addSkylineLevel( int pageIndex, int nodeIndex,
+                                 int x, int y, int width, int height )
+{
+    std::vector<SkylineNode> & skyline = skylines_.at( pageIndex );
+    SkylineNode node;
+    node.x = x;
+    node.y = y + height;
+    node.width = width;
+    skyline.insert( skyline.begin() + nodeIndex, node );
+
+    for( int i = nodeIndex + 1; i < (int)skyline.size(); ) {
+        SkylineNode & previous = skyline.at( i - 1 );
+        SkylineNode & current = skyline.at( i );
+        int overlap = previous.x + previous.width - current.x;
+
+        if( overlap <= 0 ) {
+            break;
+        }
+        current.x += overlap;
+        current.width -= overlap;
+
+        if( current.width <= 0 ) {
+            skyline.erase( skyline.begin() + i );
+        }
+        else {
+            break;
+        }
+    }
+    mergeSkyline( pageIndex );
+}
+
+void IconAtlas::mergeSkyline( int pageIndex )
+{
+    std::vector<SkylineNode> & skyline = skylines_.at( pageIndex );
+
+    for( int i = 0; i + 1 < (int)skyline.size(); ) {
+        if( skyline.at( i ).y == skyline.at( i + 1 ).y ) {
+            skyline.at( i ).width += skyline.at( i + 1 ).width;
+            skyline.erase( skyline.begin() + i + 1 );
+        }
+        else {
+            ++i;
+        }
+    }
+}
+
+/***************************************************************************//**
+Reads the atlas saved by save().  Returns false (and leaves the atlas empty)
+if there is no cache, or it was written by a different version.  Which of 
+the icons are still current is up to the caller (see indexOf()).
+*******************************************************************************/
+bool IconAtlas::load( const QString & directory )
+{
+    clear();
+    QFile file( directory + "/" + INDEX_FILE );
+
+    if( !file.open( QIODevice::ReadOnly ) ) {
+        return false;
+    }
+    QDataStream in( &file );
+    qint32 version = 0,
+           numPages = 0,
+           numIcons = 0;
+    in >> version >> numPages >> numIcons;
+
+    if( in.status() != QDataStream::Ok || version != FILE_VERSION ) {
+        return false;
+    }
+    for( int p = 0; p < numPages; ++p ) {
+        QImage page;
+
+        if( !page.load( directory + "/" + PAGE_FILE_PREFIX + QString::number( p ) + ".png" ) ) {
+            clear();
+            return false;
+        }
+        pages_.push_back( page.convertToFormat( QImage::Format_ARGB32_Premultiplied ) );
+    }
+    for( int i = 0; i < numIcons; ++i ) {
+        QString key;
+        qint32 pageIndex = -1;
+        QRect rect;
+        in >> key >> pageIndex >> rect;
+
+        if( pageIndex >= numPages
+            || (pageIndex >= 0 && !pages_.at( pageIndex ).rect().contains( rect )) ) 
+        {
+            clear();
+            return false;
+        }
+        pageIndices_.push_back( pageIndex );
+        rects_.push_back( rect );
+        keys_.push_back( key );
+        indexByKey_.insert( key, i );
+    }
+    if( in.status() != QDataStream::Ok ) {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+/***************************************************************************//**
+Writes the pages as PNG files, then the index.  The index is written last,
+so an interrupted save leaves no index.
+*******************************************************************************/
+bool IconAtlas::save( const QString & directory )
+{
+    QDir().mkpath( directory );
+    QFile::remove( directory + "/" + INDEX_FILE );
+
+    for( int p = 0; p < (int)pages_.size(); ++p ) {
+        if( !pages_.at( p ).save( directory + "/" + PAGE_FILE_PREFIX + QString::number( p ) + ".png" ) ) {
+            return false;
+        }
+    }
+    QFile file( directory + "/" + INDEX_FILE );
+
+    if( !file.open( QIODevice::WriteOnly ) ) {
+        return false;
+    }
+    QDataStream out( &file );
+    out << (qint32)FILE_VERSION << (qint32)pages_.size() << (qint32)rects_.size();
+
+    for( int i = 0; i < (int)rects_.size(); ++i ) {
+        out << keys_.at( i ) << (qint32)pageIndices_.at( i ) << rects_.at( i );
+    }
+    return out.status() == QDataStream::Ok;
+}
+
+int IconAtlas::size()
+{
+    return (int)rects_.size();
+}
+
+/***************************************************************************//**
+Returns the index of the icon packed under the key, or -1 if there is none.
+*******************************************************************************/
+int IconAtlas::indexOf( const QString & key )
+{
+    return indexByKey_.value( key, -1 );
+}
+
+int IconAtlas::numberOfPages()
+{
+    return (int)pages_.size();
+}
+
+const QImage & IconAtlas::page( int pageIndex )
+{
+    return pages_.at( pageIndex );
+}
+
+/***************************************************************************//**
+Returns -1 if the icon was not packed (a null image).
+*******************************************************************************/
+int IconAtlas::pageOf( int index )
+{
+    return pageIndices_.at( index );
+}
+
+QRect IconAtlas::rectOf( int index )
+{
+    return rects_.at( index );
+}
@@ -0,0 +1,121 @@
+/*******************************************************************************
+IconAtlas
+
+PURPOSE: Packs the app icon images into a few large atlas pages with a skyline
+         packer, and caches the pages between runs.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef GUI_ICONATLAS_H
+#define GUI_ICONATLAS_H
+
+#include <QImage>
+#include <QRect>
+#include <QString>
+#include <QHash>
+#include <vector>
+
+namespace gui
+{
+    /***********************************************************************//**
+    Packs the app icon images into one or a few large atlas pages, so that
+    the AppIcons can share the page images instead of each owning a separate
+    QImage.  The icons are packed with a skyline (bottom-left) packer, tallest
+    first, with a pixel of padding around each one so that neighbouring icons
+    never bleed into each other when a page is drawn with filtering.
+
+    Icons larger than MAX_ICON_SIZE are scaled down before packing, since the
+    PaintWidget never draws them larger than that.
+
+    Each icon is packed under its own key, built from the path, size, and
+    modification time of its icon file.  The pages can be saved to (and 
+    loaded from) a cache directory along with the keys, so every icon whose
+    file has not changed is reused from the last run, even when other apps
+    were added, changed, or removed.
+    ***************************************************************************/
+    class IconAtlas
+    {
+    public:
+        static const QString CACHE_DIRECTORY,
+                             INDEX_FILE,
+                             PAGE_FILE_PREFIX;
+        static const int PAGE_WIDTH,
+                         PAGE_HEIGHT,
+                         MAX_ICON_SIZE,
+                         PADDING,
+                         FILE_VERSION;
+
+        static QString iconKey( const QString & iconPath );
+        static IconAtlas * buildAndSave( const std::vector<QImage> & images, 
+                                         const std::vector<QString> & keys,
+                                         const QString & directory );
+
+        IconAtlas();
+        virtual ~IconAtlas();
+
+        void clear();
+        void build( const std::vector<QImage> & images, const std::vector<QString> & keys );
+        bool load( const QString & directory );
+        bool save( const QString & directory );
+
+        int size();
+        int indexOf( const QString & key );
+        int numberOfPages();
+        const QImage & page( int pageIndex );
+        int pageOf( int index );
+        QRect rectOf( int index );
+
+    private:
+        /*******************************************************************//**
+        One horizontal segment of the skyline: the top edge of everything
+        packed so far between x and x + width is at y.
+        ***********************************************************************/
+        class SkylineNode
+        {
+        public:
+            int x,
+                y,
+                width;
+        };
+
+        QImage fitToMaxIconSize( const QImage & image );
+        void addPage();
+        bool findPosition( int pageIndex, int width, int height, int & nodeIndex, int & x, int & y );
+        int fitAtNode( int pageIndex, int nodeIndex, int width, int height );
+        void addSkylineLevel( int pageIndex, int nodeIndex, int x, int y, int width, int height );
+        void mergeSkyline( int pageIndex );
+
+        std::vector<QImage> pages_;
+        std::vector<std::vector<SkylineNode> > skylines_;
+        std::vector<int> pageIndices_;
+        std::vector<QRect> rects_;
+        std::vector<QString> keys_;
+        QHash<QString, int> indexByKey_;
+    };
+}
+
+#endif
@@ -0,0 +1,150 @@
+/*******************************************************************************
+IconGridIndex
+
+PURPOSE: Finds the desktop icon under a screen point in constant time, using the
+         fact that the PaintWidget lays the icons out on a regular grid.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "gui/IconGridIndex.h"
+#include <cmath>
+
+using gui::IconGridIndex;
+
+const int IconGridIndex::NO_ICON = -1,
+          IconGridIndex::TUIO_GENERATOR_ICON = -2,
+          IconGridIndex::RELOAD_ICON = -3,
+          IconGridIndex::SHUTDOWN_ICON = -4;
+
+IconGridIndex::IconGridIndex() :
+  xStart_( 0 ),
+  yStart_( 0 ),
+  xStep_( 1 ),
+  yStep_( 1 ),
+  iconWidth_( 0 ),
+  iconHeight_( 0 ),
+  columns_()
+{
+}
+
+IconGridIndex::~IconGridIndex()
+{
+}
+
+/***************************************************************************//**
+Empties the index and sets up the grid.  The xStep and yStep are the distance 
+from the left (or top) edge of one icon to the next, so the spacing between 
+icons is (xStep - iconWidth) and (yStep - iconHeight).
+*******************************************************************************/
+void IconGridIndex::clear( int xStart, int yStart, int xStep, int yStep, 
+                           int iconWidth, int iconHeight )
+{
+    xStart_ = xStart;
+    yStart_ = yStart;
+    xStep_ = (xStep > 0) ? xStep : 1;
+    yStep_ = (yStep > 0) ? yStep : 1;
+    iconWidth_ = iconWidth;
+    iconHeight_ = iconHeight;
+    columns_.clear();
+}
+
+/***************************************************************************//**
+The (x, y) is the top left corner of the icon, which must be on the grid.
+*******************************************************************************/
+void IconGridIndex::addIcon( int x, int y, int code )
+{
+    int column = (x - xStart_) / xStep_,
+        row = (y - yStart_) / yStep_;
+
+    if( column >= 0 && row >= 0 ) {
+        if( column >= (int)columns_.size() ) {
+            columns_.resize( column + 1 );
+        }
+        std::vector<int> & rows = columns_[column];
+
+        if( row >= (int)rows.size() ) {
+            rows.resize( row + 1, NO_ICON );
+        }
+        rows[row] = code;
+    }
+}
+
+/***************************************************************************//**
+Like AppIcon::containsPoint(), the right and bottom edges of an icon count as
+being inside the icon.  A point in the spacing between icons returns NO_ICON.
+*******************************************************************************/
+int IconGridIndex::iconAt( double x, double y ) const
+{
+    double dx = x - xStart_,
+           dy = y - yStart_;
+
+    if( dx < 0 || dy < 0 ) {
+        return NO_ICON;
+    }
+    int column = (int)std::floor( dx / xStep_ ),
+        row = (int)std::floor( dy / yStep_ );
+
+    if( column >= (int)columns_.size() ) {
+        return NO_ICON;
+    }
+    const std::vector<int> & rows = columns_[column];
+
+    if( row >= (int)rows.size() ) {
+        return NO_ICON;
+    }
+    if( dx - (column * xStep_) > iconWidth_ || dy - (row * yStep_) > iconHeight_ ) {
+        return NO_ICON;
+    }
+    return rows[row];
+}
+
+/***************************************************************************//**
+Appends the code of every icon in the columns that overlap the range xMin to
+xMax.  Used by the PaintWidget to find the icons it needs to draw without 
+looking at the icons that are scrolled out of view.
+*******************************************************************************/
+void IconGridIndex::iconsInRange( double xMin, double xMax, std::vector<int> & codes ) const
+{
+    int firstColumn = (int)std::floor( (xMin - xStart_) / xStep_ ),
+        lastColumn = (int)std::floor( (xMax - xStart_) / xStep_ );
+
+    if( firstColumn < 0 ) {
+        firstColumn = 0;
+    }
+    if( lastColumn >= (int)columns_.size() ) {
+        lastColumn = (int)columns_.size() - 1;
+    }
+    for( int column = firstColumn; column <= lastColumn; ++column ) {
+        const std::vector<int> & rows = columns_[column];
+
+        for( int row = 0; row < (int)rows.size(); ++row ) {
+            if( rows[row] != NO_ICON ) {
+                codes.push_back( rows[row] );
+            }
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/*******************************************************************************
+IconGridIndex
+
+PURPOSE: Finds the desktop icon under a screen point in constant time, using the
+         fact that the PaintWidget lays the icons out on a regular grid.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef GUI_ICONGRIDINDEX_H
+#define GUI_ICONGRIDINDEX_H
+
+#include <vector>
+
+namespace gui
+{
+    /***********************************************************************//**
+    The PaintWidget lays its icons out in columns on a regular grid (the 
+    TUIO generator, reload, and shutdown icons first, followed by the app
+    icons), so the icon under a point can be found with a bit of arithmetic
+    instead of testing every icon's rectangle.  The index is rebuilt by the
+    PaintWidget whenever the icon layout changes, and is used by the 
+    TouchDetector for both touches and mouse clicks.
+
+    iconAt() returns the index of an app icon (0 or greater) or one of the
+    negative codes below.  The (x, y) values are in PaintWidget coordinates 
+    (i.e., the scroll offset has already been subtracted).
+    ***************************************************************************/
+    class IconGridIndex
+    {
+    public:
+        static const int NO_ICON,
+                         TUIO_GENERATOR_ICON,
+                         RELOAD_ICON,
+                         SHUTDOWN_ICON;
+
+        IconGridIndex();
+        virtual ~IconGridIndex();
+
+        void clear( int xStart, int yStart, int xStep, int yStep, 
+                    int iconWidth, int iconHeight );
+        void addIcon( int x, int y, int code );
+        int iconAt( double x, double y ) const;
+        void iconsInRange( double xMin, double xMax, std::vector<int> & codes ) const;
+
+    private:
+        int xStart_,
+            yStart_,
+            xStep_,
+            yStep_,
+            iconWidth_,
+            iconHeight_;
+        std::vector<std::vector<int> > columns_;
+    };
+}
+
+#endif
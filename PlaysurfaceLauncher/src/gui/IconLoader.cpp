@@ -0,0 +1,140 @@
+/*******************************************************************************
+IconLoader
+
+PURPOSE: Decodes app icon files in the background, at the size they are drawn,
+         the first time the PaintWidget needs them.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "gui/IconLoader.h"
+#include "gui/IconAtlas.h"
+#include "logger/FileLogger.h"
+#include <QImageReader>
+#include <QtConcurrentRun>
+
+using gui::IconLoader;
+using gui::IconAtlas;
+
+/***************************************************************************//**
+Runs on a worker thread.  Returns a null image if the file cannot be read
+(onDecodeFinished() logs it).
+*******************************************************************************/
+QImage IconLoader::decode( const QString & iconPath, int maxSize )
+{
+    QImageReader reader( iconPath );
+    QSize size = reader.size();
+
+    if( size.isValid() && (size.width() > maxSize || size.height() > maxSize) ) {
+        reader.setScaledSize( size.scaled( maxSize, maxSize, Qt::KeepAspectRatio ) );
+    }
+    QImage image = reader.read();
+
+    if( image.isNull() ) {
+        return image;
+    }
+    return image.convertToFormat( QImage::Format_ARGB32_Premultiplied );
+}
+
+IconLoader::IconLoader( QObject * parent ) :
+  QObject( parent ),
+  pending_(),
+  pendingPaths_(),
+  failedPaths_()
+{
+}
+
+/***************************************************************************//**
+Waits for the decodes still running, since they were started for this
+loader's watchers.
+*******************************************************************************/
+IconLoader::~IconLoader()
+{
+    QHash<QFutureWatcher<QImage> *, QString>::iterator it;
+
+    for( it = pending_.begin(); it != pending_.end(); ++it ) {
+        it.key()->disconnect( this );
+        it.key()->waitForFinished();
+    }
+}
+
+void IconLoader::request( const QString & iconPath )
+{
+    if( iconPath.isEmpty() || pendingPaths_.contains( iconPath ) || failedPaths_.contains( iconPath ) ) {
+        return;
+    }
+    QFutureWatcher<QImage> * watcher = new QFutureWatcher<QImage>( this );
+    connect( watcher, SIGNAL( finished() ), this, SLOT( onDecodeFinished() ) );
+    pending_.insert( watcher, iconPath );
+    pendingPaths_.insert( iconPath );
+    watcher->setFuture( QtConcurrent::run( &IconLoader::decode, iconPath, IconAtlas::MAX_ICON_SIZE ) );
+}
+
+bool IconLoader::isPending( const QString & iconPath )
+{
+    return pendingPaths_.contains( iconPath );
+}
+
+bool IconLoader::hasFailed( const QString & iconPath )
+{
+    return failedPaths_.contains( iconPath );
+}
+
+/***************************************************************************//**
+Lets a file that could not be decoded be requested again, since the app it
+belongs to has changed (or has been removed, which keeps the set of failed 
+files from growing without limit).
+*******************************************************************************/
+void IconLoader::forgetFailure( const QString & iconPath )
+{
+    failedPaths_.remove( iconPath );
+}
+
+int IconLoader::pendingCount()
+{
+    return pending_.size();
+}
+
+void IconLoader::onDecodeFinished()
+{
+    QFutureWatcher<QImage> * watcher = static_cast<QFutureWatcher<QImage> *>( sender() );
+
+    if( !pending_.contains( watcher ) ) {
+        return;
+    }
+    QString iconPath = pending_.take( watcher );
+    QImage image = watcher->result();
+    pendingPaths_.remove( iconPath );
+    watcher->deleteLater();
+
+    if( image.isNull() ) {
+        failedPaths_.insert( iconPath );
+        QString message = "Could not decode the app icon " + iconPath 
+                        + " (a placeholder is drawn instead)";
+        logger::FileLogger::instance().writeWarning( message.toStdString() );
+    }
+    emit iconLoaded( iconPath, image );
+}
@@ -0,0 +1,87 @@
+/*******************************************************************************
+IconLoader
+
+PURPOSE: Decodes app icon files in the background, at the size they are drawn,
+         the first time the PaintWidget needs them.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef GUI_ICONLOADER_H
+#define GUI_ICONLOADER_H
+
+#include <QObject>
+#include <QImage>
+#include <QString>
+#include <QHash>
+#include <QSet>
+#include <QFutureWatcher>
+
+namespace gui
+{
+    /***********************************************************************//**
+    Decodes app icon files on the QtConcurrent thread pool, so that icons are
+    only decoded when the PaintWidget first needs them, and never on the GUI
+    thread.  Each file is decoded straight to at most IconAtlas::MAX_ICON_SIZE
+    (with QImageReader::setScaledSize()), so the full-size image is never 
+    kept.
+
+    Requests are decoded in the order they are made, and a file that is
+    already being decoded (or that could not be decoded) is not requested
+    again, until forgetFailure() is called for it (when its app changes or
+    goes away).  Files that cannot be decoded are logged.  The iconLoaded()
+    signal is emitted on the GUI thread.
+    ***************************************************************************/
+    class IconLoader : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        static QImage decode( const QString & iconPath, int maxSize );
+
+        IconLoader( QObject * parent = NULL );
+        virtual ~IconLoader();
+
+        void request( const QString & iconPath );
+        bool isPending( const QString & iconPath );
+        bool hasFailed( const QString & iconPath );
+        void forgetFailure( const QString & iconPath );
+        int pendingCount();
+
+    signals:
+        void iconLoaded( const QString & iconPath, const QImage & image );
+
+    private slots:
+        void onDecodeFinished();
+
+    private:
+        QHash<QFutureWatcher<QImage> *, QString> pending_;
+        QSet<QString> pendingPaths_,
+                      failedPaths_;
+    };
+}
+
+#endif
@@ -0,0 +1,253 @@
+/*******************************************************************************
+PaintBenchmark
+
+PURPOSE: Measures the frame time of the icon surface with and without the pre-
+         composited icon layer.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "gui/PaintBenchmark.h"
+#include "gui/PaintWidget.h"
+#include <QApplication>
+#include <QDesktopWidget>
+#include <QPainter>
+#include <QElapsedTimer>
+#include <iomanip>
+
+using gui::PaintBenchmark;
+
+const QString PaintBenchmark::COMMAND_LINE_ARG = "-benchmarkpaint";
+
+const int PaintBenchmark::DEFAULT_ITERATIONS = 200,
+          PaintBenchmark::DEFAULT_NUMBER_OF_ICONS = 200;
+
+bool PaintBenchmark::isBenchmarkRequested( int argc, char * argv[] )
+{
+    if( argc > 1 ) {
+        QString arg = argv[1];
+        return (arg.compare( COMMAND_LINE_ARG, Qt::CaseInsensitive ) == 0);
+    }
+    return false;
+}
+
+/***************************************************************************//**
+Command line usage:
+
+    PlaysurfaceLauncher.exe -benchmarkpaint [iterations] [numberOfIcons] [iconImageFile]
+
+The view is the size of the primary screen.  Returns 0.
+*******************************************************************************/
+int PaintBenchmark::run( int argc, char * argv[], std::ostream & out )
+{
+    int iterations = (argc > 2) ? QString( argv[2] ).toInt() : DEFAULT_ITERATIONS,
+        numberOfIcons = (argc > 3) ? QString( argv[3] ).toInt() : DEFAULT_NUMBER_OF_ICONS;
+    QString iconImageFile = (argc > 4) ? QString( argv[4] ) : gui::PaintWidget::BIG_BLOBBY_IMAGE_FILE;
+    if( iterations < 1 ) { iterations = DEFAULT_ITERATIONS; }
+    if( numberOfIcons < 0 ) { numberOfIcons = DEFAULT_NUMBER_OF_ICONS; }
+
+    PaintBenchmark benchmark( QApplication::desktop()->screenGeometry().size(), numberOfIcons );
+    benchmark.loadImages( iconImageFile );
+    benchmark.measureFullRepaint( iterations );
+    benchmark.measureLayerRepaint( iterations );
+    benchmark.printReport( out );
+    return 0;
+}
+
+PaintBenchmark::PaintBenchmark( const QSize & viewSize, int numberOfIcons ) :
+  viewSize_( viewSize ),
+  numberOfIcons_( numberOfIcons ),
+  contentWidth_( viewSize.width() ),
+  iterations_( 0 ),
+  iconRects_(),
+  backgroundImage_(),
+  iconImage_(),
+  iconImageFile_(),
+  syntheticImages_( false ),
+  fullRepaintNanoseconds_( 0.0 ),
+  layerBuildNanoseconds_( 0.0 ),
+  layerRepaintNanoseconds_( 0.0 )
+{
+    calculateIconRects();
+}
+
+PaintBenchmark::~PaintBenchmark()
+{
+}
+
+/***************************************************************************//**
+If the launcher's images cannot be found (the benchmark was started from 
+another directory), full-size stand-ins are used so the cost of scaling is 
+still measured.
+*******************************************************************************/
+void PaintBenchmark::loadImages( const QString & iconImageFile )
+{
+    iconImageFile_ = iconImageFile;
+    backgroundImage_ = QImage( gui::PaintWidget::BACKGROUND_IMAGE_FILE );
+    iconImage_ = QImage( iconImageFile_ );
+    syntheticImages_ = backgroundImage_.isNull() || iconImage_.isNull();
+
+    if( backgroundImage_.isNull() ) {
+        backgroundImage_ = QImage( 1920, 1080, QImage::Format_ARGB32_Premultiplied );
+        backgroundImage_.fill( gui::PaintWidget::BACKGROUND_COLOR );
+    }
+    if( iconImage_.isNull() ) {
+        iconImage_ = QImage( 512, 512, QImage::Format_ARGB32_Premultiplied );
+        iconImage_.fill( Qt::darkBlue );
+    }
+}
+
+/***************************************************************************//**
+Icons are placed in columns the way PaintWidget::calculateIconPositions() 
+places them, from the top left down and then to the right.
+*******************************************************************************/
+void PaintBenchmark::calculateIconRects()
+{
+    int w = gui::PaintWidget::IMAGE_WIDTH,
+        h = gui::PaintWidget::IMAGE_HEIGHT,
+        columnWidth = w + gui::PaintWidget::X_SPACING,
+        rowHeight = h + gui::PaintWidget::Y_SPACING,
+        rows = (viewSize_.height() - h - 2 * gui::PaintWidget::Y_START) / rowHeight + 1;
+    if( rows < 1 ) { rows = 1; }
+
+    iconRects_.clear();
+
+    for( int i = 0; i < numberOfIcons_; ++i ) {
+        int x = gui::PaintWidget::X_START + (i / rows) * columnWidth,
+            y = gui::PaintWidget::Y_START + (i % rows) * rowHeight;
+        iconRects_.push_back( QRect( x, y, w, h ) );
+        contentWidth_ = qMax( contentWidth_, x + w + gui::PaintWidget::X_START );
+    }
+}
+
+/***************************************************************************//**
+The old paintEvent(): the background image scaled into every screen-wide 
+tile of the layout, and every icon drawn from its full-size image.
+*******************************************************************************/
+void PaintBenchmark::measureFullRepaint( int iterations )
+{
+    QPixmap view( viewSize_ );
+    QElapsedTimer timer;
+    timer.start();
+
+    for( int n = 0; n < iterations; ++n ) {
+        QPainter painter( &view );
+        painter.setRenderHint( QPainter::Antialiasing, true );
+        drawBackground( painter, 0, contentWidth_ );
+        drawIcons( painter, NULL );
+    }
+    fullRepaintNanoseconds_ = (double)timer.nsecsElapsed();
+    iterations_ = iterations;
+}
+
+/***************************************************************************//**
+The current paintEvent(): the layer (view width plus PREFETCH_MARGIN on each
+side, with the icons pre-scaled) is built once, and each frame copies the 
+view out of it.
+*******************************************************************************/
+void PaintBenchmark::measureLayerRepaint( int iterations )
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    int margin = gui::PaintWidget::PREFETCH_MARGIN;
+    QPixmap layer( viewSize_.width() + 2 * margin, viewSize_.height() );
+    layer.fill( gui::PaintWidget::BACKGROUND_COLOR );
+    QPixmap scaledIcon = QPixmap::fromImage( iconImage_.scaled( gui::PaintWidget::IMAGE_WIDTH,
+                                                                gui::PaintWidget::IMAGE_HEIGHT,
+                                                                Qt::IgnoreAspectRatio,
+                                                                Qt::SmoothTransformation ) );
+    QPainter layerPainter( &layer );
+    layerPainter.setRenderHint( QPainter::Antialiasing, true );
+    drawBackground( layerPainter, 0, layer.width() );
+    drawIcons( layerPainter, &scaledIcon );
+    layerPainter.end();
+    layerBuildNanoseconds_ = (double)timer.nsecsElapsed();
+
+    QPixmap view( viewSize_ );
+    QRect viewRect( QPoint( 0, 0 ), viewSize_ );
+    timer.restart();
+
+    for( int n = 0; n < iterations; ++n ) {
+        QPainter painter( &view );
+        painter.drawPixmap( viewRect, layer, viewRect );
+    }
+    layerRepaintNanoseconds_ = (double)timer.nsecsElapsed();
+}
+
+void PaintBenchmark::drawBackground( QPainter & painter, int xMin, int xMax )
+{
+    int w = viewSize_.width(),
+        h = viewSize_.height();
+
+    painter.setBrush( Qt::NoBrush );
+
+    for( int x = (xMin / w) * w; x < xMax; x += w ) {
+        painter.drawImage( QRect( x, 0, w, h ), backgroundImage_ );
+    }
+}
+
+void PaintBenchmark::drawIcons( QPainter & painter, const QPixmap * scaledIcon )
+{
+    for( size_t i = 0; i < iconRects_.size(); ++i ) {
+        const QRect & rect = iconRects_[i];
+        painter.setBrush( gui::PaintWidget::SOLID_WHITE_BRUSH );
+        painter.drawRoundedRect( rect, 10, 10 );
+        painter.setBrush( Qt::NoBrush );
+
+        if( scaledIcon != NULL ) {
+            painter.drawPixmap( rect.topLeft(), *scaledIcon );
+        }
+        else {
+            painter.drawImage( rect, iconImage_ );
+        }
+    }
+}
+
+void PaintBenchmark::printReport( std::ostream & out )
+{
+    out << "\nPaint benchmark: " << viewSize_.width() << "x" << viewSize_.height() 
+        << " view, " << numberOfIcons_ << " icons, layout width " << contentWidth_ << "\n"
+        << "icon image = " << iconImageFile_.toStdString()
+        << " (" << iconImage_.width() << "x" << iconImage_.height() << ")\n";
+
+    if( syntheticImages_ ) {
+        out << "(an image could not be read, so a stand-in of the same kind was used)\n";
+    }
+    if( iterations_ > 0 ) {
+        double milliseconds = 1000000.0 * iterations_;
+
+        out << "\niterations = " << iterations_ 
+            << std::fixed << std::setprecision( 3 )
+            << "\n" << std::left << std::setw( 28 ) << "full repaint (old)" 
+            << std::right << std::setw( 10 ) << fullRepaintNanoseconds_ / milliseconds << " ms/frame"
+            << "\n" << std::left << std::setw( 28 ) << "copy from icon layer (new)" 
+            << std::right << std::setw( 10 ) << layerRepaintNanoseconds_ / milliseconds << " ms/frame"
+            << "\n" << std::left << std::setw( 28 ) << "icon layer rebuild" 
+            << std::right << std::setw( 10 ) << layerBuildNanoseconds_ / 1000000.0 << " ms\n";
+    }
+    out.flush();
+}
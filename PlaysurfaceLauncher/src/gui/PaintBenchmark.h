@@ -0,0 +1,94 @@
+/*******************************************************************************
+PaintBenchmark
+
+PURPOSE: Measures the frame time of the icon surface with and without the pre-
+         composited icon layer.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef GUI_PAINTBENCHMARK_H
+#define GUI_PAINTBENCHMARK_H
+
+#include <QString>
+#include <QImage>
+#include <QPixmap>
+#include <QRect>
+#include <QSize>
+#include <ostream>
+#include <vector>
+
+class QPainter;
+
+namespace gui
+{
+    /***********************************************************************//**
+    Measures the frame time of the icon surface the way the PaintWidget used
+    to draw it (the tiled background and every icon on each paint) against
+    the way it draws it now (one copy from a pre-composited icon layer), for
+    a synthetic layout of a given number of icons on a screen-sized view.
+    The PaintWidget's own layout constants and images are used, so the 
+    numbers are the ones the launcher would see on the same machine.
+    ***************************************************************************/
+    class PaintBenchmark
+    {
+    public:
+        static const QString COMMAND_LINE_ARG;
+        static const int DEFAULT_ITERATIONS,
+                         DEFAULT_NUMBER_OF_ICONS;
+
+        static bool isBenchmarkRequested( int argc, char * argv[] );
+        static int run( int argc, char * argv[], std::ostream & out );
+
+        PaintBenchmark( const QSize & viewSize, int numberOfIcons );
+        virtual ~PaintBenchmark();
+
+        void loadImages( const QString & iconImageFile );
+        void measureFullRepaint( int iterations );
+        void measureLayerRepaint( int iterations );
+        void printReport( std::ostream & out );
+
+    private:
+        void calculateIconRects();
+        void drawBackground( QPainter & painter, int xMin, int xMax );
+        void drawIcons( QPainter & painter, const QPixmap * scaledIcon );
+
+        QSize viewSize_;
+        int numberOfIcons_,
+            contentWidth_,
+            iterations_;
+        std::vector<QRect> iconRects_;
+        QImage backgroundImage_,
+               iconImage_;
+        QString iconImageFile_;
+        bool syntheticImages_;
+        double fullRepaintNanoseconds_,
+               layerBuildNanoseconds_,
+               layerRepaintNanoseconds_;
+    };
+}
+
+#endif
@@ -34,12 +34,20 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 */
 #include "gui/PaintWidget.h"
 #include "gui/AppIcon.h"
+#include "gui/IconGridIndex.h"
+#include "gui/IconAtlas.h"
+#include "gui/IconLoader.h"
 #include "gui/FullScreenWindow.h"
+#include "utils/StopWatch.h"
+#include "metrics/Metrics.h"
 #include <QPainter>
+#include <QPaintEvent>
 #include <QRect>
 #include <QMovie>
 #include <QLabel>
 #include <QTimer>
+#include <QtConcurrentRun>
+#include <algorithm>
 #include <iostream>
 
 using gui::PaintWidget;
@@ -67,6 +75,9 @@ const QString PaintWidget::SHUTDOWN_ICON_IMAGE_FILE =
                   ":/QResources/icons/Shutdown-playsurface-icon.png";
 
 const int PaintWidget::LOADING_ICON_TIMEOUT = 5000,
+          PaintWidget::FRAME_MILLISECONDS = 16,
+          PaintWidget::PREFETCH_MARGIN = 250,
+          PaintWidget::DECODE_AHEAD_SCREENS = 1,
           PaintWidget::X_START = 125,
           PaintWidget::Y_START = 125,
           PaintWidget::X_SPACING = 25,
@@ -82,15 +93,25 @@ const QBrush PaintWidget::SOLID_BLACK_BRUSH( QColor( 0, 0, 0 ) ),
              PaintWidget::TRANSLUCENT_GRAY_BRUSH( QColor( 127, 127, 127, 200 ) ),
              PaintWidget::TRANSLUCENT_DARK_GRAY_BRUSH( QColor( 0, 0, 0, 200 ) );
 const int PaintWidget::LOADING_ICON_WIDTH = 400,
-          PaintWidget::LOADING_ICON_HEIGHT = 400;
+          PaintWidget::LOADING_ICON_HEIGHT = 400,
+          PaintWidget::TUIO_STATS_MARGIN = 10;
 
 PaintWidget::PaintWidget( gui::FullScreenWindow * mainWindow, enums::TuioSourceEnum::Enum tuioSource ) :
   mainWindow_( mainWindow ),
   tuioSource_( tuioSource ),
   parentWidth_( 1280 ),
   parentHeight_( 800 ),
+  scrollOffset_( 0 ),
+  contentWidth_( 1280 ),
+  layerX_( 0 ),
   backgroundImage_(),
   gesturePanelImage_(),
+  backgroundLayer_(),
+  iconLayer_(),
+  iconLayerDirty_( true ),
+  layerIcons_(),
+  pendingRegion_(),
+  frameTimer_( new QTimer( this ) ),
   gesturePanelImageRect_(),
   bigBlobbyImage_( BIG_BLOBBY_IMAGE_FILE ),
   touchHooks2TuioImage_( TOUCH_HOOKS_2_TUIO_IMAGE_FILE ),
@@ -99,9 +120,16 @@ PaintWidget::PaintWidget( gui::FullScreenWindow * mainWindow, enums::TuioSourceE
   reloadIcon_( NULL ),
   shutdownIcon_( NULL ),
   appIcons_(),
+  iconGridIndex_( new gui::IconGridIndex() ),
+  iconAtlas_( new gui::IconAtlas() ),
+  iconLoader_( new gui::IconLoader( this ) ),
+  iconAtlasWatcher_( new QFutureWatcher<gui::IconAtlas *>( this ) ),
+  iconAtlasLoaded_( false ),
+  iconAtlasPacking_( false ),
   activatedAppIconIndex_( -1 ),
   loadingIconMovie_( NULL ),
   loadingIconLabel_( NULL ),
+  tuioStatsLabel_( NULL ),
   drawGesturePanel_( false ),
   grayTuioGeneratorIcon_( false ),
   grayReloadIcon_( false ),
@@ -109,15 +137,24 @@ PaintWidget::PaintWidget( gui::FullScreenWindow * mainWindow, enums::TuioSourceE
   grayActivatedAppIcon_( false ),
   drawBlackScreen_( false ),
   showLoadingAnimation_( false ),
-  showShutdownComputerIcon_( false )
+  showShutdownComputerIcon_( false ),
+  showTuioStats_( false ),
+  iconsDrawnByOpenGL_( false )
 {
     resize( parentWidth_, parentHeight_ );
+    setAttribute( Qt::WA_OpaquePaintEvent );
     setBackgroundColor();
     setBackgroundImage();
     setTuioGeneratorIcon();
     setReloadIcon();
     setShutdownIcon();
     setLoadingIconAnimation();
+    frameTimer_->setSingleShot( true );
+    frameTimer_->setInterval( FRAME_MILLISECONDS );
+    connect( frameTimer_, SIGNAL( timeout() ), this, SLOT( repaintPendingRegion() ) );
+    connect( iconLoader_, SIGNAL( iconLoaded( const QString &, const QImage & ) ),
+             this, SLOT( onIconLoaded( const QString &, const QImage & ) ) );
+    connect( iconAtlasWatcher_, SIGNAL( finished() ), this, SLOT( onIconAtlasPacked() ) );
 }
 
 PaintWidget::~PaintWidget()
@@ -126,6 +163,14 @@ PaintWidget::~PaintWidget()
     delete reloadIcon_;
     delete shutdownIcon_;
     clearAppIcons();
+    delete iconGridIndex_;
+    delete iconAtlas_;
+
+    if( iconAtlasPacking_ ) {
+        iconAtlasWatcher_->disconnect( this );
+        iconAtlasWatcher_->waitForFinished();
+        delete iconAtlasWatcher_->result();
+    }
 }
 
 void PaintWidget::setBackgroundColor()
@@ -167,6 +212,7 @@ void PaintWidget::setTuioGeneratorIcon( enums::TuioSourceEnum::Enum tuioSource )
     else { // Must be BigBlobby.
         tuioGeneratorIcon_->setImage( bigBlobbyImage_ );
     }
+    invalidateIconLayer();
 }
 
 void PaintWidget::setReloadIcon()
@@ -199,6 +245,37 @@ void PaintWidget::setWidthAndHeightOfParent( int width, int height )
     parentHeight_ = height;
     calculateIconPositions();
     resizeGesturePanelImage();
+    placeTuioStatsLabel();
+}
+
+/***************************************************************************//**
+The PaintWidget is only as big as the CentralWidget's viewport; scrolling 
+just changes which part of the (much wider) icon layout is drawn in it.
+*******************************************************************************/
+void PaintWidget::setScrollOffset( int x )
+{
+    int maxOffset = contentWidth_ - width();
+    x = (x > maxOffset) ? maxOffset : x;
+    x = (x < 0) ? 0 : x;
+
+    if( x != scrollOffset_ ) {
+        scrollOffset_ = x;
+        invalidateAll();
+        requestNearbyIconImages();
+    }
+}
+
+int PaintWidget::scrollOffset()
+{
+    return scrollOffset_;
+}
+
+/***************************************************************************//**
+The width needed to show every icon, which may be many screens wide.
+*******************************************************************************/
+int PaintWidget::contentWidth()
+{
+    return contentWidth_;
 }
 
 void PaintWidget::resizeGesturePanelImage()
@@ -230,26 +307,37 @@ gui::AppIcon * PaintWidget::shutdownAppIcon()
 void PaintWidget::setTuioGeneratorIconToGray( bool b )
 {
     grayTuioGeneratorIcon_ = b;
+    invalidateIcon( tuioGeneratorIcon_ );
+    emit grayIconsChanged();
 }
 
 void PaintWidget::setReloadIconToGray( bool b )
 {
     grayReloadIcon_ = b;
+    invalidateIcon( reloadIcon_ );
+    emit grayIconsChanged();
 }
 
 void PaintWidget::setShutdownIconToGray( bool b )
 {
     grayShutdownIcon_ = b;
+    invalidateIcon( shutdownIcon_ );
+    emit grayIconsChanged();
 }
 
 void PaintWidget::setActivatedAppIconToGray( bool b )
 {
     grayActivatedAppIcon_ = b;
+    invalidateActivatedAppIcon();
+    emit grayIconsChanged();
 }
 
 void PaintWidget::setActivatedAppIconIndex( int index )
 {
+    invalidateActivatedAppIcon();
     activatedAppIconIndex_ = index;
+    invalidateActivatedAppIcon();
+    emit grayIconsChanged();
 }
 
 int PaintWidget::activatedAppIconIndex()
@@ -260,6 +348,7 @@ int PaintWidget::activatedAppIconIndex()
 void PaintWidget::drawGesturePanel( bool show )
 {
     drawGesturePanel_ = show;
+    invalidateAll();
 }
 
 QImage * PaintWidget::gesturePanelImage()
@@ -272,7 +361,7 @@ void PaintWidget::clearGesturePanelImage()
     gesturePanelImage_.fill( QColor( 255, 255, 255 ) );
 
     if( drawGesturePanel_ ) {
-        update();
+        invalidateAll();
     }
 }
 
@@ -280,6 +369,7 @@ void PaintWidget::drawBlackScreen( bool b )
 {
     drawBlackScreen_ = b;
     showLoadingAnimation_ = b;
+    invalidateAll();
 
     if( showLoadingAnimation_ && loadingIconLabel_ != NULL ) {
         centerLoadingIconLabel();
@@ -295,7 +385,7 @@ void PaintWidget::centerLoadingIconLabel()
 {
     if( loadingIconLabel_ != NULL ) {
         QSize movieSize = loadingIconMovie_->scaledSize();
-        int iconX = (parentWidth_ - LOADING_ICON_WIDTH) / 2 - x(),
+        int iconX = (parentWidth_ - LOADING_ICON_WIDTH) / 2,
             iconY = (parentHeight_ - LOADING_ICON_HEIGHT) / 2;
 
         loadingIconLabel_->resize( LOADING_ICON_WIDTH, LOADING_ICON_HEIGHT );
@@ -311,22 +401,394 @@ std::vector<gui::AppIcon *> & PaintWidget::appIcons()
     return appIcons_;
 }
 
+gui::IconGridIndex * PaintWidget::iconGridIndex()
+{
+    return iconGridIndex_;
+}
+
+/***************************************************************************//**
+Returns the icons within DECODE_AHEAD_SCREENS view widths of the view (the 
+same ones requestNearbyIconImages() decodes), and sets xMin and xMax to the
+range of x values that was searched.
+*******************************************************************************/
+std::vector<gui::AppIcon *> PaintWidget::iconsInDecodeWindow( int & xMin, int & xMax )
+{
+    std::vector<gui::AppIcon *> icons;
+    int margin = DECODE_AHEAD_SCREENS * width();
+    xMin = scrollOffset_ - margin;
+    xMax = scrollOffset_ + width() + margin;
+    iconsInRange( xMin, xMax, icons );
+    return icons;
+}
+
+bool PaintWidget::isIconGray( gui::AppIcon * icon )
+{
+    if( icon == NULL ) {
+        return false;
+    }
+    if( icon == tuioGeneratorIcon_ ) {
+        return grayTuioGeneratorIcon_;
+    }
+    if( icon == reloadIcon_ ) {
+        return grayReloadIcon_;
+    }
+    if( icon == shutdownIcon_ ) {
+        return grayShutdownIcon_;
+    }
+    return grayActivatedAppIcon_
+           && activatedAppIconIndex_ >= 0 
+           && activatedAppIconIndex_ < (int)appIcons_.size()
+           && appIcons_.at( activatedAppIconIndex_ ) == icon;
+}
+
+/***************************************************************************//**
+Draws a single icon (with its rounded rect) into a transparent image that is
+one pixel larger than the icon rectangle on each side, so the antialiased 
+border is kept.  Used by the GLIconView to fill its texture atlas.
+*******************************************************************************/
+QImage PaintWidget::iconSprite( gui::AppIcon * icon, bool gray )
+{
+    QRect rect = icon->rect().adjusted( -1, -1, 1, 1 );
+    QImage sprite( rect.size(), QImage::Format_ARGB32_Premultiplied );
+    sprite.fill( Qt::transparent );
+    QPainter painter( &sprite );
+    painter.setRenderHint( QPainter::Antialiasing, true );
+    painter.translate( -rect.topLeft() );
+    drawIcon( painter, icon, gray );
+    painter.end();
+    return sprite;
+}
+
+/***************************************************************************//**
+The parts of an app icon that are drawn under and over its image (the white
+rounded rect, or the dark rounded rect that grays the icon out), in a sprite
+laid out like the ones from iconSprite().  Used by the GLIconView for the app
+icons whose images it draws straight from the IconAtlas pages.
+*******************************************************************************/
+QImage PaintWidget::appIconFrameSprite( const QSize & size, bool grayOverlay )
+{
+    QImage sprite( size + QSize( 2, 2 ), QImage::Format_ARGB32_Premultiplied );
+    sprite.fill( Qt::transparent );
+    QPainter painter( &sprite );
+    painter.setRenderHint( QPainter::Antialiasing, true );
+    painter.setBrush( grayOverlay ? TRANSLUCENT_DARK_GRAY_BRUSH : SOLID_WHITE_BRUSH );
+    painter.drawRoundedRect( QRect( QPoint( 1, 1 ), size ), 10, 10 );
+    painter.end();
+    return sprite;
+}
+
+/***************************************************************************//**
+The background image at the size of one screen, ready to be tiled.
+*******************************************************************************/
+QImage PaintWidget::backgroundTile()
+{
+    QImage tile( parentWidth_, parentHeight_, QImage::Format_ARGB32_Premultiplied );
+    tile.fill( BACKGROUND_COLOR );
+    QPainter painter( &tile );
+    painter.drawImage( QRect( 0, 0, parentWidth_, parentHeight_ ), backgroundImage_ );
+    painter.end();
+    return tile;
+}
+
+/***************************************************************************//**
+When the icons are drawn by the GLIconView, the PaintWidget is covered and 
+does not need to keep its own icon layer up to date.
+*******************************************************************************/
+void PaintWidget::setIconsDrawnByOpenGL( bool b )
+{
+    iconsDrawnByOpenGL_ = b;
+    invalidateIconLayer();
+
+    if( iconsDrawnByOpenGL_ ) {
+        requestNearbyIconImages();
+    }
+}
+
 /***************************************************************************//**
 The PaintWidget is intended to be presented in a scroll window, the 
-CentralWidget, so that the width of the PaintWidget can be adjusted if 
-the number of app icons will not fit in a single screen width.
-Therefore, after the icon images have been copied by this function, the 
-helper function that calculates the icon positions will also adjust the 
-width of the widget to make it wider than the CentralWidget if necessary.
+CentralWidget, so that the icon layout can be scrolled if the number of app 
+icons will not fit in a single screen width.  Therefore, after the icon 
+icons have been created by this function, the helper function that 
+calculates the icon positions will also update the content width (which 
+sets the range of the CentralWidget's scroll bar).
+
+Each icon whose file is packed in the IconAtlas just refers to its rectangle
+in one of the atlas pages (see createFileIcon()).  An icon that was already
+decoded (while the apps were being read, see appendFileIcons()) keeps its 
+image.  The rest start out as placeholders, and are decoded in the 
+background when they come near the visible part of the layout (see 
+requestNearbyIconImages()).
 *******************************************************************************/
-void PaintWidget::setFileIcons( std::vector<QImage> * iconImages )
+void PaintWidget::setFileIcons( std::vector<QString> * iconPaths )
 {
+    std::vector<gui::AppIcon *> oldIcons;
+    oldIcons.swap( appIcons_ );
+    QHash<QString, gui::AppIcon *> oldIconsByPath;
+
+    for( int i = 0; i < (int)oldIcons.size(); ++i ) {
+        oldIconsByPath.insert( oldIcons.at( i )->iconPath(), oldIcons.at( i ) );
+    }
     clearAppIcons();
 
-    for( int i = 0; i < iconImages->size(); ++i ) {
-        appIcons_.push_back( new gui::AppIcon( iconImages->at( i ) ) );
+    for( int i = 0; i < (int)iconPaths->size(); ++i ) {
+        gui::AppIcon * icon = createFileIcon( iconPaths->at( i ) );
+
+        if( !icon->hasImage() && oldIconsByPath.contains( icon->iconPath() ) ) {
+            copyIconImage( oldIconsByPath.value( icon->iconPath() ), icon );
+        }
+        appIcons_.push_back( icon );
+    }
+    for( int i = 0; i < (int)oldIcons.size(); ++i ) {
+        delete oldIcons.at( i );
+    }
+    calculateIconPositions();
+    requestNearbyIconImages();
+}
+
+/***************************************************************************//**
+Adds icons for the icon files from index first to the end, while the 
+DirectoryReader is still finding apps; a first index of 0 means a new read 
+has started, so the old icons are dropped.  The icons already there are kept
+as they are, so each batch of apps only costs the new icons (and a pass over
+the icon positions).
+*******************************************************************************/
+void PaintWidget::appendFileIcons( std::vector<QString> * iconPaths, int first )
+{
+    if( first == 0 ) {
+        clearAppIcons();
+    }
+    layerIcons_.clear();
+
+    for( int i = first; i < (int)iconPaths->size(); ++i ) {
+        appIcons_.push_back( createFileIcon( iconPaths->at( i ) ) );
     }
     calculateIconPositions();
+    requestNearbyIconImages();
+}
+
+/***************************************************************************//**
+The IconAtlas cache is loaded the first time an icon is created.  Each icon
+is then looked up by the key of its file (see IconAtlas::iconKey()), so an 
+icon whose file has not changed since it was packed is never decoded again,
+no matter how many other apps were added, changed, or removed.
+*******************************************************************************/
+gui::AppIcon * PaintWidget::createFileIcon( const QString & iconPath )
+{
+    if( !iconAtlasLoaded_ ) {
+        iconAtlas_->load( gui::IconAtlas::CACHE_DIRECTORY );
+        iconAtlasLoaded_ = true;
+    }
+    gui::AppIcon * icon = new gui::AppIcon();
+    icon->setIconPath( iconPath );
+    icon->setAtlasKey( gui::IconAtlas::iconKey( iconPath ) );
+    useAtlasImage( icon );
+    return icon;
+}
+
+/***************************************************************************//**
+Points the icon at its rectangle in the IconAtlas, if its file is packed 
+there.
+*******************************************************************************/
+void PaintWidget::useAtlasImage( gui::AppIcon * icon )
+{
+    int index = iconAtlas_->indexOf( icon->atlasKey() ),
+        page = (index >= 0) ? iconAtlas_->pageOf( index ) : -1;
+
+    if( page >= 0 ) {
+        icon->setAtlasImage( iconAtlas_->page( page ), iconAtlas_->rectOf( index ) );
+    }
+}
+
+/***************************************************************************//**
+An icon in an atlas page shares the page; otherwise the image is shared.
+*******************************************************************************/
+void PaintWidget::copyIconImage( gui::AppIcon * from, gui::AppIcon * to )
+{
+    if( !from->atlasPage().isNull() && !from->atlasRect().isEmpty() ) {
+        to->setAtlasImage( from->atlasPage(), from->atlasRect() );
+    }
+    else if( from->hasImage() ) {
+        to->setImage( from->iconImage() );
+    }
+}
+
+/***************************************************************************//**
+Asks the IconLoader for the images of any of the icons that are still 
+placeholders.
+*******************************************************************************/
+void PaintWidget::requestIconImages( const std::vector<gui::AppIcon *> & icons )
+{
+    for( int i = 0; i < (int)icons.size(); ++i ) {
+        gui::AppIcon * icon = icons.at( i );
+
+        if( !icon->hasImage() && !icon->iconPath().isEmpty() ) {
+            iconLoader_->request( icon->iconPath() );
+        }
+    }
+}
+
+/***************************************************************************//**
+Asks for the icons in view first, then for the ones within 
+DECODE_AHEAD_SCREENS view widths on either side, so that they are ready before they 
+are scrolled into view.  Icons farther away are only decoded once the view
+gets near them, so a launcher with many apps never decodes them all at once.
+
+When the IconLoader has nothing left to do, the icons that were decoded but
+are not in the IconAtlas yet are packed into it.
+*******************************************************************************/
+void PaintWidget::requestNearbyIconImages()
+{
+    std::vector<gui::AppIcon *> icons;
+    int margin = DECODE_AHEAD_SCREENS * width();
+    iconsInRange( scrollOffset_, scrollOffset_ + width(), icons );
+    iconsInRange( scrollOffset_ - margin, scrollOffset_ + width() + margin, icons );
+    requestIconImages( icons );
+
+    if( iconLoader_->pendingCount() == 0 && !iconAtlasPacking_ && hasUnpackedIcons() ) {
+        packIconAtlas();
+    }
+}
+
+/***************************************************************************//**
+Puts the decoded image into every icon made from that file, and redraws the
+icon layer (the redraw waits for the next frame, so a burst of icons costs 
+one redraw).  Icon files that could not be decoded are left as placeholders.
+*******************************************************************************/
+void PaintWidget::onIconLoaded( const QString & iconPath, const QImage & image )
+{
+    bool changed = false;
+
+    for( int i = 0; i < (int)appIcons_.size(); ++i ) {
+        gui::AppIcon * icon = appIcons_.at( i );
+
+        if( !image.isNull() && !icon->hasImage() && icon->iconPath() == iconPath ) {
+            icon->setImage( image );
+            changed = true;
+        }
+    }
+    if( changed ) {
+        invalidateIconLayer();
+    }
+    if( iconLoader_->pendingCount() == 0 ) {
+        requestNearbyIconImages();
+    }
+}
+
+/***************************************************************************//**
+True if any icon has been decoded but is not in an IconAtlas page yet.
+*******************************************************************************/
+bool PaintWidget::hasUnpackedIcons()
+{
+    for( int i = 0; i < (int)appIcons_.size(); ++i ) {
+        gui::AppIcon * icon = appIcons_.at( i );
+
+        if( icon->hasImage() && icon->atlasPage().isNull() ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/***************************************************************************//**
+Packs every icon that has an image (the ones already in the atlas, and the
+ones decoded since) into a new atlas, and saves it.  Both are done on the 
+QtConcurrent pool (the images are implicitly shared, and are not changed 
+while the atlas is packed), and onIconAtlasPacked() takes the result on the
+GUI thread.  Only one atlas is packed at a time.
+*******************************************************************************/
+void PaintWidget::packIconAtlas()
+{
+    std::vector<QImage> images;
+    std::vector<QString> keys;
+
+    for( int i = 0; i < (int)appIcons_.size(); ++i ) {
+        gui::AppIcon * icon = appIcons_.at( i );
+
+        if( icon->hasImage() ) {
+            QImage image = icon->iconImage();
+            // A view of an atlas page must not outlive the page, which the icon may not.
+            images.push_back( icon->atlasPage().isNull() ? image : image.copy() );
+            keys.push_back( icon->atlasKey() );
+        }
+    }
+    iconAtlasPacking_ = true;
+    iconAtlasWatcher_->setFuture( QtConcurrent::run( &gui::IconAtlas::buildAndSave, 
+                                                     images, 
+                                                     keys,
+                                                     gui::IconAtlas::CACHE_DIRECTORY ) );
+}
+
+/***************************************************************************//**
+Each icon that was packed drops its own image (or its view of the old atlas)
+for a view of the new atlas.  Icons added while the atlas was being packed 
+are looked up by key too, and the ones that are not in it are packed the 
+next time.
+*******************************************************************************/
+void PaintWidget::onIconAtlasPacked()
+{
+    iconAtlasPacking_ = false;
+    delete iconAtlas_;
+    iconAtlas_ = iconAtlasWatcher_->result();
+
+    for( int i = 0; i < (int)appIcons_.size(); ++i ) {
+        useAtlasImage( appIcons_.at( i ) );
+    }
+    invalidateIconLayer();
+}
+
+/***************************************************************************//**
+Adds one app icon without repacking the icon atlas.  A new icon file is 
+decoded on its own (even if it could not be decoded before, since the app
+may have been fixed), and keeps its own image until the next atlas is packed.
+*******************************************************************************/
+void PaintWidget::insertFileIcon( int index, const QString & iconPath )
+{
+    if( index < 0 || index > (int)appIcons_.size() ) {
+        return;
+    }
+    layerIcons_.clear();
+    iconLoader_->forgetFailure( iconPath );
+    appIcons_.insert( appIcons_.begin() + index, createFileIcon( iconPath ) );
+
+    if( activatedAppIconIndex_ >= index ) {
+        ++activatedAppIconIndex_;
+    }
+    calculateIconPositions();
+    requestNearbyIconImages();
+}
+
+void PaintWidget::replaceFileIcon( int index, const QString & iconPath )
+{
+    if( index < 0 || index >= (int)appIcons_.size() ) {
+        return;
+    }
+    layerIcons_.clear();
+    iconLoader_->forgetFailure( appIcons_.at( index )->iconPath() );
+    iconLoader_->forgetFailure( iconPath );
+    delete appIcons_.at( index );
+    appIcons_.at( index ) = createFileIcon( iconPath );
+    calculateIconPositions();
+    requestNearbyIconImages();
+}
+
+void PaintWidget::removeFileIcon( int index )
+{
+    if( index < 0 || index >= (int)appIcons_.size() ) {
+        return;
+    }
+    layerIcons_.clear();
+    iconLoader_->forgetFailure( appIcons_.at( index )->iconPath() );
+    delete appIcons_.at( index );
+    appIcons_.erase( appIcons_.begin() + index );
+
+    if( activatedAppIconIndex_ == index ) {
+        activatedAppIconIndex_ = -1;
+    }
+    else if( activatedAppIconIndex_ > index ) {
+        --activatedAppIconIndex_;
+    }
+    calculateIconPositions();
+    requestNearbyIconImages();
 }
 
 void PaintWidget::showShutdownComputerIcon( bool b )
@@ -335,6 +797,57 @@ void PaintWidget::showShutdownComputerIcon( bool b )
     calculateIconPositions();
 }
 
+/***************************************************************************//**
+The TUIO statistics are shown in a label in the top right corner.  The label 
+belongs to the viewport (not to this widget), so that it can be raised above
+the GLIconView when the icons are drawn with OpenGL.
+*******************************************************************************/
+void PaintWidget::showTuioStats( bool b )
+{
+    showTuioStats_ = b;
+
+    if( showTuioStats_ && tuioStatsLabel_ == NULL ) {
+        createTuioStatsLabel();
+    }
+    if( tuioStatsLabel_ != NULL ) {
+        tuioStatsLabel_->setVisible( showTuioStats_ );
+        placeTuioStatsLabel();
+    }
+}
+
+void PaintWidget::setTuioStatsText( const QString & text )
+{
+    if( showTuioStats_ && tuioStatsLabel_ != NULL ) {
+        tuioStatsLabel_->setText( text );
+        placeTuioStatsLabel();
+    }
+}
+
+void PaintWidget::createTuioStatsLabel()
+{
+    QWidget * parent = (parentWidget() != NULL) ? parentWidget() : this;
+    tuioStatsLabel_ = new QLabel( parent );
+    QPalette pal = tuioStatsLabel_->palette();
+    pal.setColor( QPalette::Window, QColor( 0, 0, 0, 180 ) );
+    pal.setColor( QPalette::WindowText, Qt::white );
+    tuioStatsLabel_->setPalette( pal );
+    tuioStatsLabel_->setAutoFillBackground( true );
+    tuioStatsLabel_->setFont( QFont( "Courier New", 10 ) );
+    tuioStatsLabel_->setMargin( TUIO_STATS_MARGIN );
+    tuioStatsLabel_->setAttribute( Qt::WA_TransparentForMouseEvents );
+    tuioStatsLabel_->setText( "TUIO  waiting for statistics" );
+}
+
+void PaintWidget::placeTuioStatsLabel()
+{
+    if( tuioStatsLabel_ != NULL && showTuioStats_ ) {
+        tuioStatsLabel_->adjustSize();
+        tuioStatsLabel_->move( parentWidth_ - tuioStatsLabel_->width() - TUIO_STATS_MARGIN, 
+                               TUIO_STATS_MARGIN );
+        tuioStatsLabel_->raise();
+    }
+}
+
 void PaintWidget::calculateIconPositions()
 {
     //std::cout << "PaintWidget::calculateIconPositions() called.\n";
@@ -347,9 +860,13 @@ void PaintWidget::calculateIconPositions()
         y = yStart,
         lastX = x;
     //std::cout << "yStart = " << yStart << "\n";
+    iconGridIndex_->clear( X_START, yStart, 
+                           IMAGE_WIDTH + X_SPACING, IMAGE_HEIGHT + Y_SPACING,
+                           IMAGE_WIDTH, IMAGE_HEIGHT );
 
     if( tuioGeneratorIcon_ != NULL ) {
         tuioGeneratorIcon_->setRect( x, y, IMAGE_WIDTH, IMAGE_HEIGHT );
+        iconGridIndex_->addIcon( x, y, gui::IconGridIndex::TUIO_GENERATOR_ICON );
         y += Y_SPACING + IMAGE_HEIGHT;
 
         if( y > height() - (IMAGE_HEIGHT + yStart) ) {
@@ -359,6 +876,7 @@ void PaintWidget::calculateIconPositions()
     }
     if( reloadIcon_ != NULL ) {
         reloadIcon_->setRect( x, y, IMAGE_WIDTH, IMAGE_HEIGHT );
+        iconGridIndex_->addIcon( x, y, gui::IconGridIndex::RELOAD_ICON );
         y += Y_SPACING + IMAGE_HEIGHT;
 
         if( y > height() - (IMAGE_HEIGHT + yStart) ) {
@@ -369,6 +887,7 @@ void PaintWidget::calculateIconPositions()
     if( shutdownIcon_ != NULL ) {
         if( showShutdownComputerIcon_ ) {
             shutdownIcon_->setRect( x, y, IMAGE_WIDTH, IMAGE_HEIGHT );
+            iconGridIndex_->addIcon( x, y, gui::IconGridIndex::SHUTDOWN_ICON );
             y += Y_SPACING + IMAGE_HEIGHT;
 
             if( y > height() - (IMAGE_HEIGHT + yStart) ) {
@@ -377,14 +896,14 @@ void PaintWidget::calculateIconPositions()
             }
         }
         else { // The Shutdown Computer Icon is not showing, so the rectangle
-            // should be something that will make the TouchDetector always
-            // return false when a screen (x, y) is plugged in and tested 
-            // for being on top of the shutdownIcon_.
+            // is moved off screen (and the icon is left out of the grid 
+            // index, so the TouchDetector will never report a touch on it).
             shutdownIcon_->setRect( -1000, -1000, 0, 0 );
         }
     }
     for( int i = 0; i < appIcons_.size(); ++i ) {
         appIcons_.at( i )->setRect( x, y, IMAGE_WIDTH, IMAGE_HEIGHT );
+        iconGridIndex_->addIcon( x, y, i );
         y += Y_SPACING + IMAGE_HEIGHT;
         lastX = x;
 
@@ -393,10 +912,14 @@ void PaintWidget::calculateIconPositions()
             y = yStart;
         }
     }
-    // Need to resize widget based on last x value (plus IMAGE_WIDTH).
-    int drawingWidth = lastX + IMAGE_WIDTH + X_START,
-        widgetWidth = (drawingWidth > parentWidth_) ? drawingWidth : parentWidth_;
-    resize( widgetWidth, parentHeight_ );
+    // The widget stays the size of the parent; the width of the layout (based 
+    // on the last x value plus IMAGE_WIDTH) only sets the scroll range.
+    int drawingWidth = lastX + IMAGE_WIDTH + X_START;
+    contentWidth_ = (drawingWidth > parentWidth_) ? drawingWidth : parentWidth_;
+    resize( parentWidth_, parentHeight_ );
+    setScrollOffset( scrollOffset_ );
+    emit contentWidthChanged();
+    invalidateIconLayer();
     //debugPrintWidgetDimensions();
 }
 
@@ -406,6 +929,7 @@ void PaintWidget::clearAppIcons()
         delete appIcons_.at( i );
     }
     appIcons_.clear();
+    layerIcons_.clear();
 }
 
 /***************************************************************************//**
@@ -420,22 +944,35 @@ void PaintWidget::resizeEvent( QResizeEvent * event )
 
 void PaintWidget::paintEvent( QPaintEvent * event )
 {
+    //utils::StopWatch stopWatch;
+    long long startMicroseconds = metrics::Metrics::microseconds();
+
     if( drawGesturePanel_ ) {
-        drawGesturePanel();
+        drawGesturePanel( event->rect() );
     }
     else if( drawBlackScreen_ ) {
         drawSolidBlackScreen();
     }
+    else if( iconsDrawnByOpenGL_ ) {
+        hideLoadingIconIfVisible();
+    }
     else {
-        drawAllIcons();
+        drawAllIcons( event->rect() );
     }
+    metrics::Metrics::instance().paintTime.observeSince( startMicroseconds );
+    //debugPrintPaintTime( stopWatch.elapsed() );
 }
 
-void PaintWidget::drawGesturePanel()
+/***************************************************************************//**
+While finger painting, the exposed rectangle is usually just the area around
+the newest dots, so only that part of the image is copied.
+*******************************************************************************/
+void PaintWidget::drawGesturePanel( const QRect & exposedRect )
 {
     hideLoadingIconIfVisible();
     QPainter painter( this );
-    painter.drawImage( gesturePanelImageRect_, gesturePanelImage_ );
+    QRect rect = exposedRect.intersected( gesturePanelImageRect_ );
+    painter.drawImage( rect, gesturePanelImage_, rect );
     drawGesturePanelMessage( painter );
 }
 
@@ -473,53 +1010,265 @@ void PaintWidget::drawSolidBlackScreen()
     painter.drawRect( 0, 0, width(), height() );
 }
 
-void PaintWidget::drawAllIcons()
+/***************************************************************************//**
+The background and the icons (in their normal, non-gray state) near the 
+visible part of the layout are drawn once into the iconLayer_ pixmap, so a 
+repaint is just a copy of the exposed part of that pixmap.  Any icon that is 
+currently grayed out is then drawn over the top of the copy.
+*******************************************************************************/
+void PaintWidget::drawAllIcons( const QRect & exposedRect )
 {
     hideLoadingIconIfVisible();
+    updateIconLayer();
+    int dpr = devicePixelRatio();
+    QRect layerRect = exposedRect.translated( scrollOffset_ - layerX_, 0 );
+    QRect sourceRect( layerRect.topLeft() * dpr, layerRect.size() * dpr );
     QPainter painter( this );
+    painter.drawPixmap( exposedRect, iconLayer_, sourceRect );
     painter.setRenderHint( QPainter::Antialiasing, true );
-    drawBackground( painter );
-    drawTuioGeneratorIcon( painter );
-    drawReloadIcon( painter );
-    drawShutdownIcon( painter );
-    drawMultitouchAppIcons( painter );
+    painter.translate( -scrollOffset_, 0 );
+    drawGrayIcons( painter, exposedRect.translated( scrollOffset_, 0 ) );
 }
 
-void PaintWidget::drawBackground( QPainter & painter )
+/***************************************************************************//**
+Must be called whenever the size of the widget, the icon positions, or the 
+icon images change.
+*******************************************************************************/
+void PaintWidget::invalidateIconLayer()
 {
-    int x = 0,
-        y = 0,
-        w = parentWidth_,
-        h = parentHeight_;
+    iconLayerDirty_ = true;
+    invalidateAll();
+    emit iconLayerChanged();
+}
 
-    // Always draw the background image at least once.
-    QRect rect( x, y, w, h );
-    painter.setBrush( Qt::NoBrush );
-    painter.drawImage( rect, backgroundImage_ );
+/***************************************************************************//**
+Repaints the rectangle right away if nothing has been repainted in the last
+frame (FRAME_MILLISECONDS), so a single change is never held back.  During a
+burst, the rectangles that come in within a frame of the last repaint are 
+added to one region that is repainted when the frame is over.
+*******************************************************************************/
+void PaintWidget::invalidate( const QRect & rect )
+{
+    if( rect.isEmpty() ) {
+        return;
+    }
+    if( frameTimer_->isActive() ) {
+        pendingRegion_ += rect;
+    }
+    else {
+        update( rect );
+        frameTimer_->start();
+    }
+}
+
+void PaintWidget::invalidateAll()
+{
+    invalidate( rect() );
+}
+
+/***************************************************************************//**
+The timer is only started again if something was repainted, so it stops 
+once the burst is over and the next change is repainted immediately.
+*******************************************************************************/
+void PaintWidget::repaintPendingRegion()
+{
+    if( !pendingRegion_.isEmpty() ) {
+        update( pendingRegion_ );
+        pendingRegion_ = QRegion();
+        frameTimer_->start();
+    }
+}
 
-    // Check if PaintWidget is wide enough to need left-right tiling of background image.
-    int paintWidgetWidth = width();
+/***************************************************************************//**
+The rectangle is grown by a pixel on each side to cover the antialiased 
+border of the rounded rect, and moved from layout to widget coordinates.
+*******************************************************************************/
+void PaintWidget::invalidateIcon( gui::AppIcon * icon )
+{
+    if( icon != NULL ) {
+        invalidate( icon->rect().adjusted( -1, -1, 1, 1 ).translated( -scrollOffset_, 0 ) );
+    }
+}
 
-    if( paintWidgetWidth > parentWidth_ ) {
-        int n = paintWidgetWidth / parentWidth_,
-            r = paintWidgetWidth % parentWidth_;
+void PaintWidget::invalidateActivatedAppIcon()
+{
+    if( activatedAppIconIndex_ >= 0 && activatedAppIconIndex_ < (int)appIcons_.size() ) {
+        invalidateIcon( appIcons_.at( activatedAppIconIndex_ ) );
+    }
+}
 
-        for( int i = 0; i < n; ++i ) {
-            x += parentWidth_;
-            rect.setRect( x, y, w, h );
-            painter.drawImage( rect, backgroundImage_ );
+/***************************************************************************//**
+The layer covers the visible part of the layout plus PREFETCH_MARGIN on each 
+side, so scrolling a short way is just a copy from a different part of the 
+layer.  Once the view is scrolled past the edge of the layer, the layer is 
+redrawn around the new scroll offset.  Only the icons in (or near) the view 
+are drawn, so the cost does not go up with the number of apps, and the 
+scaled pixmaps of icons that have left the layer are released.
+*******************************************************************************/
+void PaintWidget::updateIconLayer()
+{
+    int dpr = devicePixelRatio();
+    QSize layerSize( width() + 2 * PREFETCH_MARGIN, height() );
+    bool outsideLayer = scrollOffset_ < layerX_ 
+                        || scrollOffset_ + width() > layerX_ + layerSize.width();
+
+    if( iconLayerDirty_ || outsideLayer || iconLayer_.size() != layerSize * dpr ) {
+        layerX_ = (scrollOffset_ > PREFETCH_MARGIN) ? (scrollOffset_ - PREFETCH_MARGIN) : 0;
+        int layerEnd = layerX_ + layerSize.width();
+
+        backgroundLayer_ = QPixmap( layerSize * dpr );
+        backgroundLayer_.setDevicePixelRatio( dpr );
+        backgroundLayer_.fill( BACKGROUND_COLOR );
+        QPainter backgroundPainter( &backgroundLayer_ );
+        backgroundPainter.translate( -layerX_, 0 );
+        drawBackground( backgroundPainter, layerX_, layerEnd );
+        backgroundPainter.end();
+
+        std::vector<gui::AppIcon *> icons;
+        iconsInRange( layerX_, layerEnd, icons );
+        iconLayer_ = backgroundLayer_.copy();
+        iconLayer_.setDevicePixelRatio( dpr );
+        QPainter painter( &iconLayer_ );
+        painter.setRenderHint( QPainter::Antialiasing, true );
+        painter.translate( -layerX_, 0 );
+
+        for( int i = 0; i < (int)icons.size(); ++i ) {
+            drawIcon( painter, icons.at( i ), false );
+        }
+        painter.end();
+        releasePixmapsOutsideLayer( icons );
+        requestIconImages( icons );
+        iconLayerDirty_ = false;
+    }
+}
+
+void PaintWidget::iconsInRange( int xMin, int xMax, std::vector<gui::AppIcon *> & icons )
+{
+    std::vector<int> codes;
+    iconGridIndex_->iconsInRange( xMin, xMax, codes );
+
+    for( int i = 0; i < (int)codes.size(); ++i ) {
+        gui::AppIcon * icon = iconForCode( codes.at( i ) );
+
+        if( icon != NULL ) {
+            icons.push_back( icon );
+        }
+    }
+}
+
+gui::AppIcon * PaintWidget::iconForCode( int code )
+{
+    if( code == gui::IconGridIndex::TUIO_GENERATOR_ICON ) {
+        return tuioGeneratorIcon_;
+    }
+    if( code == gui::IconGridIndex::RELOAD_ICON ) {
+        return reloadIcon_;
+    }
+    if( code == gui::IconGridIndex::SHUTDOWN_ICON ) {
+        return shutdownIcon_;
+    }
+    if( code >= 0 && code < (int)appIcons_.size() ) {
+        return appIcons_.at( code );
+    }
+    return NULL;
+}
+
+/***************************************************************************//**
+The icons that were in the old layer but are not in the new one give back
+their scaled pixmaps (they are scaled again if they are scrolled back into
+view).
+*******************************************************************************/
+void PaintWidget::releasePixmapsOutsideLayer( const std::vector<gui::AppIcon *> & icons )
+{
+    for( int i = 0; i < (int)layerIcons_.size(); ++i ) {
+        gui::AppIcon * icon = layerIcons_.at( i );
+
+        if( std::find( icons.begin(), icons.end(), icon ) == icons.end() ) {
+            icon->releasePixmaps();
         }
     }
+    layerIcons_ = icons;
+}
+
+void PaintWidget::drawGrayIcons( QPainter & painter, const QRect & exposedRect )
+{
+    if( grayTuioGeneratorIcon_ && tuioGeneratorIcon_ != NULL ) {
+        drawGrayIcon( painter, tuioGeneratorIcon_, exposedRect );
+    }
+    if( grayReloadIcon_ && reloadIcon_ != NULL ) {
+        drawGrayIcon( painter, reloadIcon_, exposedRect );
+    }
+    if( grayShutdownIcon_ && shutdownIcon_ != NULL ) {
+        drawGrayIcon( painter, shutdownIcon_, exposedRect );
+    }
+    if( grayActivatedAppIcon_ 
+        && activatedAppIconIndex_ >= 0 
+        && activatedAppIconIndex_ < (int)appIcons_.size() ) 
+    {
+        drawGrayIcon( painter, appIcons_.at( activatedAppIconIndex_ ), exposedRect );
+    }
 }
 
-void PaintWidget::drawTuioGeneratorIcon( QPainter & painter )
+/***************************************************************************//**
+The gray version of an icon is not just a layer on top of the normal version
+(the rounded rect under the image changes color), so the background is put 
+back under the icon before the gray version is drawn.
+*******************************************************************************/
+void PaintWidget::drawGrayIcon( QPainter & painter, gui::AppIcon * icon, const QRect & exposedRect )
+{
+    QRect iconRect = icon->rect().adjusted( -1, -1, 1, 1 );
+
+    if( iconRect.intersects( exposedRect ) ) {
+        int dpr = devicePixelRatio();
+        QRect layerRect = iconRect.translated( -layerX_, 0 );
+        QRect sourceRect( layerRect.topLeft() * dpr, layerRect.size() * dpr );
+        painter.drawPixmap( iconRect, backgroundLayer_, sourceRect );
+        drawIcon( painter, icon, true );
+    }
+}
+
+void PaintWidget::drawIcon( QPainter & painter, gui::AppIcon * icon, bool gray )
+{
+    if( icon == tuioGeneratorIcon_ ) {
+        drawTuioGeneratorIcon( painter, gray );
+    }
+    else if( icon == reloadIcon_ ) {
+        drawReloadIcon( painter, gray );
+    }
+    else if( icon == shutdownIcon_ ) {
+        drawShutdownIcon( painter, gray );
+    }
+    else {
+        drawMultitouchAppIcon( painter, icon, gray );
+    }
+}
+
+/***************************************************************************//**
+The background image is one screen wide and is tiled left to right across 
+the layout.  Only the tiles that overlap xMin to xMax (layout coordinates) 
+are drawn.
+*******************************************************************************/
+void PaintWidget::drawBackground( QPainter & painter, int xMin, int xMax )
+{
+    int w = (parentWidth_ > 0) ? parentWidth_ : 1,
+        h = parentHeight_,
+        x = (xMin / w) * w;
+
+    painter.setBrush( Qt::NoBrush );
+
+    for( ; x < xMax && x < contentWidth_; x += w ) {
+        painter.drawImage( QRect( x, 0, w, h ), backgroundImage_ );
+    }
+}
+
+void PaintWidget::drawTuioGeneratorIcon( QPainter & painter, bool gray )
 {
     if( tuioGeneratorIcon_ != NULL ) {
         if( tuioSource_ == enums::TuioSourceEnum::TOUCH_HOOKS_2_TUIO ) {
             painter.setBrush( Qt::NoBrush );
-            painter.drawImage( tuioGeneratorIcon_->rect(), tuioGeneratorIcon_->iconImage() );
+            drawIconImage( painter, tuioGeneratorIcon_ );
 
-            if( grayTuioGeneratorIcon_  ) {
+            if( gray ) {
                 painter.setBrush( TRANSLUCENT_LIGHT_GRAY_BRUSH );
                 painter.drawRoundedRect( tuioGeneratorIcon_->rect(), 10, 10 );
             }
@@ -528,56 +1277,67 @@ void PaintWidget::drawTuioGeneratorIcon( QPainter & painter )
             painter.drawRoundedRect( tuioGeneratorIcon_->rect(), 10, 10 );
         }
         else { // Must be BigBlobby.
-            painter.setBrush( grayTuioGeneratorIcon_ ? TRANSLUCENT_GRAY_BRUSH : SOLID_BLACK_BRUSH );
+            painter.setBrush( gray ? TRANSLUCENT_GRAY_BRUSH : SOLID_BLACK_BRUSH );
             painter.drawRoundedRect( tuioGeneratorIcon_->rect(), 10, 10 );
 
-            painter.setBrush( grayTuioGeneratorIcon_ ? TRANSLUCENT_GRAY_BRUSH : Qt::NoBrush );
-            painter.drawImage( tuioGeneratorIcon_->rect(), tuioGeneratorIcon_->iconImage() );
+            painter.setBrush( gray ? TRANSLUCENT_GRAY_BRUSH : Qt::NoBrush );
+            drawIconImage( painter, tuioGeneratorIcon_ );
         }
     }
 }
 
-void PaintWidget::drawReloadIcon( QPainter & painter )
+void PaintWidget::drawReloadIcon( QPainter & painter, bool gray )
 {
     if( reloadIcon_ != NULL ) {
-        painter.setBrush( grayReloadIcon_ ? TRANSLUCENT_GRAY_BRUSH : SOLID_BLACK_BRUSH );
+        painter.setBrush( gray ? TRANSLUCENT_GRAY_BRUSH : SOLID_BLACK_BRUSH );
         painter.drawRoundedRect( reloadIcon_->rect(), 10, 10 );
 
-        painter.setBrush( grayReloadIcon_ ? TRANSLUCENT_GRAY_BRUSH : Qt::NoBrush );
-        painter.drawImage( reloadIcon_->rect(), reloadIcon_->iconImage() );
+        painter.setBrush( gray ? TRANSLUCENT_GRAY_BRUSH : Qt::NoBrush );
+        drawIconImage( painter, reloadIcon_ );
     }
 }
 
-void PaintWidget::drawShutdownIcon( QPainter & painter )
+void PaintWidget::drawShutdownIcon( QPainter & painter, bool gray )
 {
     if( shutdownIcon_ != NULL ) {
-        painter.setBrush( grayShutdownIcon_ ? TRANSLUCENT_GRAY_BRUSH : SOLID_BLACK_BRUSH );
+        painter.setBrush( gray ? TRANSLUCENT_GRAY_BRUSH : SOLID_BLACK_BRUSH );
         painter.drawRoundedRect( shutdownIcon_->rect(), 10, 10 );
 
-        painter.setBrush( grayShutdownIcon_ ? TRANSLUCENT_GRAY_BRUSH : Qt::NoBrush );
-        painter.drawImage( shutdownIcon_->rect(), shutdownIcon_->iconImage() );
+        painter.setBrush( gray ? TRANSLUCENT_GRAY_BRUSH : Qt::NoBrush );
+        drawIconImage( painter, shutdownIcon_ );
     }
 }
 
-void PaintWidget::drawMultitouchAppIcons( QPainter & painter )
+void PaintWidget::drawMultitouchAppIcon( QPainter & painter, gui::AppIcon * appIcon, bool gray )
 {
-    for( int i = 0; i < appIcons_.size(); ++i ) {
-        gui::AppIcon * appIcon = appIcons_.at( i );
-
-        //painter.setPen( Qt::NoPen );
-        painter.setBrush( SOLID_WHITE_BRUSH );
-        painter.drawRoundedRect( appIcon->rect(), 10, 10 );
+    //painter.setPen( Qt::NoPen );
+    painter.setBrush( SOLID_WHITE_BRUSH );
+    painter.drawRoundedRect( appIcon->rect(), 10, 10 );
 
+    if( appIcon->hasImage() ) {
         painter.setBrush( Qt::NoBrush );
-        painter.drawImage( appIcon->rect(), appIcon->iconImage() );
-
-        if( grayActivatedAppIcon_ && i == activatedAppIconIndex_  ) {
-            painter.setBrush( TRANSLUCENT_DARK_GRAY_BRUSH );
-            painter.drawRoundedRect( appIcon->rect(), 10, 10 );
-        }
+        drawIconImage( painter, appIcon );
+    }
+    else { // Placeholder until the image has been decoded.
+        painter.setBrush( TRANSLUCENT_LIGHT_GRAY_BRUSH );
+        painter.drawRoundedRect( appIcon->rect().adjusted( 15, 15, -15, -15 ), 10, 10 );
+    }
+    if( gray ) {
+        painter.setBrush( TRANSLUCENT_DARK_GRAY_BRUSH );
+        painter.drawRoundedRect( appIcon->rect(), 10, 10 );
     }
 }
 
+/***************************************************************************//**
+The icon comes back from the AppIcon already scaled to the size of its 
+rectangle, so this is a straight copy.
+*******************************************************************************/
+void PaintWidget::drawIconImage( QPainter & painter, gui::AppIcon * icon )
+{
+    QRect rect = icon->rect();
+    painter.drawPixmap( rect.topLeft(), icon->pixmap( rect.size(), devicePixelRatio() ) );
+}
+
 void PaintWidget::debugPrintWidgetDimensions()
 {
     std::cout << "    widget(w, h) = (" 
@@ -600,3 +1360,9 @@ void PaintWidget::debugPrintIsMovieValid()
         std::cout << "Movie is not valid.\n";
     }
 }
+
+void PaintWidget::debugPrintPaintTime( double seconds )
+{
+    std::cout << "    paintEvent() took " << (seconds * 1000.0) << " ms for " 
+              << appIcons_.size() << " app icons\n";
+}
@@ -38,13 +38,21 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #include "enums/TuioSourceEnum.h"
 #include <QWidget>
 #include <QImage>
+#include <QPixmap>
+#include <QRegion>
+#include <QHash>
 #include <QPen>
+#include <QFutureWatcher>
 #include <vector>
 
 namespace gui { class AppIcon; }
+namespace gui { class IconGridIndex; }
+namespace gui { class IconAtlas; }
+namespace gui { class IconLoader; }
 namespace gui { class FullScreenWindow; }
 class QMovie;
 class QLabel;
+class QTimer;
 
 namespace gui 
 {
@@ -64,6 +72,9 @@ namespace gui
                              RELOAD_ICON_IMAGE_FILE,
                              SHUTDOWN_ICON_IMAGE_FILE;
         static const int LOADING_ICON_TIMEOUT,
+                         FRAME_MILLISECONDS,
+                         PREFETCH_MARGIN,
+                         DECODE_AHEAD_SCREENS,
                          X_START,
                          Y_START,
                          X_SPACING,
@@ -79,13 +90,17 @@ namespace gui
                             TRANSLUCENT_LIGHT_GRAY_BRUSH,
                             TRANSLUCENT_DARK_GRAY_BRUSH;
         static const int LOADING_ICON_WIDTH,
-                         LOADING_ICON_HEIGHT;
+                         LOADING_ICON_HEIGHT,
+                         TUIO_STATS_MARGIN;
 
         PaintWidget( gui::FullScreenWindow * parent, enums::TuioSourceEnum::Enum tuioSource );
         virtual ~PaintWidget();
 
         void setTuioGeneratorIcon( enums::TuioSourceEnum::Enum tuioSource );
         void setWidthAndHeightOfParent( int width, int height );
+        void setScrollOffset( int x );
+        int scrollOffset();
+        int contentWidth();
         gui::AppIcon * tuioGeneratorAppIcon();
         gui::AppIcon * reloadAppIcon();
         gui::AppIcon * shutdownAppIcon();
@@ -100,13 +115,38 @@ namespace gui
         void clearGesturePanelImage();
         void drawBlackScreen( bool b );
         std::vector<gui::AppIcon *> & appIcons();
-
-        void setFileIcons( std::vector<QImage> * iconImages );
+        gui::IconGridIndex * iconGridIndex();
+        std::vector<gui::AppIcon *> iconsInDecodeWindow( int & xMin, int & xMax );
+        bool isIconGray( gui::AppIcon * icon );
+        QImage iconSprite( gui::AppIcon * icon, bool gray );
+        QImage appIconFrameSprite( const QSize & size, bool grayOverlay );
+        QImage backgroundTile();
+        void setIconsDrawnByOpenGL( bool b );
+
+        void setFileIcons( std::vector<QString> * iconPaths );
+        void appendFileIcons( std::vector<QString> * iconPaths, int first );
+        void insertFileIcon( int index, const QString & iconPath );
+        void replaceFileIcon( int index, const QString & iconPath );
+        void removeFileIcon( int index );
         void showShutdownComputerIcon( bool b );
+        void showTuioStats( bool b );
+        void setTuioStatsText( const QString & text );
+        void invalidate( const QRect & rect );
+        void invalidateAll();
+
+    signals:
+        void iconLayerChanged();
+        void contentWidthChanged();
+        void grayIconsChanged();
 
     public slots:
         void hideLoadingIconIfVisible();
 
+    private slots:
+        void repaintPendingRegion();
+        void onIconLoaded( const QString & iconPath, const QImage & image );
+        void onIconAtlasPacked();
+
     protected:
         void resizeEvent( QResizeEvent * event );
         void paintEvent( QPaintEvent * event );
@@ -120,29 +160,59 @@ namespace gui
         void setLoadingIconAnimation();
         void calculateIconPositions();
         void clearAppIcons();
+        gui::AppIcon * createFileIcon( const QString & iconPath );
+        void useAtlasImage( gui::AppIcon * icon );
+        void copyIconImage( gui::AppIcon * from, gui::AppIcon * to );
+        void requestIconImages( const std::vector<gui::AppIcon *> & icons );
+        void requestNearbyIconImages();
+        bool hasUnpackedIcons();
+        void packIconAtlas();
         void centerLoadingIconLabel();
+        void createTuioStatsLabel();
+        void placeTuioStatsLabel();
 
         void resizeGesturePanelImage();
-        void drawGesturePanel();
+        void drawGesturePanel( const QRect & exposedRect );
         void drawGesturePanelMessage( QPainter & painter );
         void drawSolidBlackScreen();
-        void drawAllIcons();
-        void drawBackground( QPainter & painter );
-        void drawTuioGeneratorIcon( QPainter & painter );
-        void drawReloadIcon( QPainter & painter );
-        void drawShutdownIcon( QPainter & painter );
-        void drawMultitouchAppIcons( QPainter & painter );
+        void drawAllIcons( const QRect & exposedRect );
+        void invalidateIconLayer();
+        void invalidateIcon( gui::AppIcon * icon );
+        void invalidateActivatedAppIcon();
+        void updateIconLayer();
+        void iconsInRange( int xMin, int xMax, std::vector<gui::AppIcon *> & icons );
+        gui::AppIcon * iconForCode( int code );
+        void releasePixmapsOutsideLayer( const std::vector<gui::AppIcon *> & icons );
+        void drawGrayIcons( QPainter & painter, const QRect & exposedRect );
+        void drawGrayIcon( QPainter & painter, gui::AppIcon * icon, const QRect & exposedRect );
+        void drawIcon( QPainter & painter, gui::AppIcon * icon, bool gray );
+        void drawBackground( QPainter & painter, int xMin, int xMax );
+        void drawTuioGeneratorIcon( QPainter & painter, bool gray );
+        void drawReloadIcon( QPainter & painter, bool gray );
+        void drawShutdownIcon( QPainter & painter, bool gray );
+        void drawMultitouchAppIcon( QPainter & painter, gui::AppIcon * appIcon, bool gray );
+        void drawIconImage( QPainter & painter, gui::AppIcon * icon );
 
         void debugPrintWidgetDimensions();
         void debugPrintNumberOfIcons();
         void debugPrintIsMovieValid();
+        void debugPrintPaintTime( double seconds );
 
         gui::FullScreenWindow * mainWindow_;
         enums::TuioSourceEnum::Enum tuioSource_;
         int parentWidth_,
-            parentHeight_;
+            parentHeight_,
+            scrollOffset_,
+            contentWidth_,
+            layerX_;
         QImage backgroundImage_,
                gesturePanelImage_;
+        QPixmap backgroundLayer_,
+                iconLayer_;
+        bool iconLayerDirty_;
+        std::vector<gui::AppIcon *> layerIcons_;
+        QRegion pendingRegion_;
+        QTimer * frameTimer_;
         QRect gesturePanelImageRect_;
         QImage bigBlobbyImage_,
                touchHooks2TuioImage_,
@@ -151,9 +221,16 @@ namespace gui
                      * reloadIcon_,
                      * shutdownIcon_;
         std::vector<gui::AppIcon *> appIcons_;
+        gui::IconGridIndex * iconGridIndex_;
+        gui::IconAtlas * iconAtlas_;
+        gui::IconLoader * iconLoader_;
+        QFutureWatcher<gui::IconAtlas *> * iconAtlasWatcher_;
+        bool iconAtlasLoaded_,
+             iconAtlasPacking_;
         int activatedAppIconIndex_;
         QMovie * loadingIconMovie_;
-        QLabel * loadingIconLabel_;
+        QLabel * loadingIconLabel_,
+               * tuioStatsLabel_;
         bool drawGesturePanel_,
              grayTuioGeneratorIcon_,
              grayReloadIcon_,
@@ -161,7 +238,9 @@ namespace gui
              grayActivatedAppIcon_,
              drawBlackScreen_,
              showLoadingAnimation_,
-             showShutdownComputerIcon_;
+             showShutdownComputerIcon_,
+             showTuioStats_,
+             iconsDrawnByOpenGL_;
     };
 }
 
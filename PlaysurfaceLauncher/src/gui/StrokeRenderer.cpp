@@ -0,0 +1,188 @@
+/*******************************************************************************
+StrokeRenderer
+
+PURPOSE: Paints finger strokes and gesture labels onto the gesture panel image,
+         keeping one painter open per touch event and tracking the area that was
+         painted.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "gui/StrokeRenderer.h"
+#include <QImage>
+#include <QPen>
+#include <QFontMetrics>
+
+using gui::StrokeRenderer;
+
+const double StrokeRenderer::END_DOT_RADIUS = 4.0;
+const int StrokeRenderer::LABEL_POINT_SIZE = 12;
+
+StrokeRenderer::StrokeRenderer() :
+  painter_(),
+  image_( NULL ),
+  penColors_(),
+  labelFont_(),
+  lastPoints_(),
+  dirtyRect_()
+{
+    setPenColors();
+    labelFont_.setPointSize( LABEL_POINT_SIZE );
+}
+
+StrokeRenderer::~StrokeRenderer()
+{
+    endFrame();
+}
+
+void StrokeRenderer::setPenColors()
+{
+    penColors_ << QColor( "red" )
+               << QColor( "green" )
+               << QColor( "cyan" )
+               << QColor( "yellow" )
+               << QColor( "magenta" )
+               << QColor( "orange" );
+}
+
+/***************************************************************************//**
+Opens the painter on the image if it is not already open.  Returns false if
+there is no image to paint on.
+*******************************************************************************/
+bool StrokeRenderer::beginFrame( QImage * image )
+{
+    if( image == NULL ) {
+        return false;
+    }
+    if( painter_.isActive() && image_ != image ) {
+        endFrame();
+    }
+    if( !painter_.isActive() ) {
+        image_ = image;
+        painter_.begin( image_ );
+        painter_.setRenderHint( QPainter::Antialiasing, true );
+    }
+    return true;
+}
+
+/***************************************************************************//**
+Must be called before the image is shown or changed (e.g., cleared or resized),
+since the painter stays open on the image until then.
+*******************************************************************************/
+void StrokeRenderer::endFrame()
+{
+    if( painter_.isActive() ) {
+        painter_.end();
+    }
+    image_ = NULL;
+}
+
+void StrokeRenderer::clear()
+{
+    lastPoints_.clear();
+}
+
+QRect StrokeRenderer::takeDirtyRect()
+{
+    QRect rect = dirtyRect_;
+    dirtyRect_ = QRect();
+    return rect;
+}
+
+void StrokeRenderer::startStroke( QImage * image, int id, double x, double y, double penWidth )
+{
+    if( beginFrame( image ) ) {
+        QPointF point( x, y );
+        drawSegment( id, point, point, penWidth );
+        lastPoints_.insert( id, point );
+    }
+}
+
+void StrokeRenderer::continueStroke( QImage * image, int id, double x, double y, double penWidth )
+{
+    if( beginFrame( image ) ) {
+        QPointF point( x, y );
+        drawSegment( id, lastPoints_.value( id, point ), point, penWidth );
+        lastPoints_.insert( id, point );
+    }
+}
+
+void StrokeRenderer::finishStroke( QImage * image, int id, double x, double y, double penWidth )
+{
+    continueStroke( image, id, x, y, penWidth );
+    lastPoints_.remove( id );
+}
+
+/***************************************************************************//**
+A zero length line with round caps is drawn as a dot, so the first point of 
+a stroke looks the same as it did before lines were drawn.
+*******************************************************************************/
+void StrokeRenderer::drawSegment( int id, const QPointF & from, const QPointF & to, double penWidth )
+{
+    QPen pen( penColors_.at( id % penColors_.count() ) );
+    pen.setWidthF( penWidth );
+    pen.setCapStyle( Qt::RoundCap );
+    pen.setJoinStyle( Qt::RoundJoin );
+    painter_.setPen( pen );
+    painter_.drawLine( from, to );
+
+    double halfWidth = penWidth / 2.0;
+    addToDirtyRect( QRectF( from, to ).normalized().adjusted( -halfWidth, -halfWidth, 
+                                                              halfWidth, halfWidth ) );
+}
+
+void StrokeRenderer::drawEndDot( QImage * image, double x, double y )
+{
+    if( beginFrame( image ) ) {
+        painter_.setPen( Qt::black );
+        painter_.setBrush( Qt::black );
+        painter_.drawEllipse( QPointF( x, y ), END_DOT_RADIUS, END_DOT_RADIUS );
+        addToDirtyRect( QRectF( x - END_DOT_RADIUS, y - END_DOT_RADIUS, 
+                                2 * END_DOT_RADIUS, 2 * END_DOT_RADIUS ) );
+    }
+}
+
+/***************************************************************************//**
+Draws the text with its baseline at (x, y).
+*******************************************************************************/
+void StrokeRenderer::drawLabel( QImage * image, double x, double y, const QString & text )
+{
+    if( beginFrame( image ) ) {
+        painter_.setPen( Qt::black );
+        painter_.setFont( labelFont_ );
+        painter_.drawText( QPointF( x, y ), text );
+        QRect textRect = painter_.fontMetrics().boundingRect( text );
+        addToDirtyRect( QRectF( textRect.translated( (int)x, (int)y ) ) );
+    }
+}
+
+/***************************************************************************//**
+The rect is grown by a couple of pixels to cover antialiasing.
+*******************************************************************************/
+void StrokeRenderer::addToDirtyRect( const QRectF & rect )
+{
+    dirtyRect_ |= rect.toAlignedRect().adjusted( -2, -2, 2, 2 );
+}
@@ -0,0 +1,93 @@
+/*******************************************************************************
+StrokeRenderer
+
+PURPOSE: Paints finger strokes and gesture labels onto the gesture panel image,
+         keeping one painter open per touch event and tracking the area that was
+         painted.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef GUI_STROKERENDERER_H
+#define GUI_STROKERENDERER_H
+
+#include <QColor>
+#include <QFont>
+#include <QList>
+#include <QMap>
+#include <QPainter>
+#include <QPointF>
+#include <QRect>
+#include <QString>
+
+class QImage;
+
+namespace gui
+{
+    /***********************************************************************//**
+    Paints finger strokes onto the gesture panel image.  Each touch id is 
+    drawn as a line (with round ends) from its previous point to its newest
+    point, so a fast moving finger leaves a solid line instead of a trail of
+    separate dots.
+    
+    A single QPainter stays open on the image from the first point drawn 
+    until endFrame() is called (once per touch event), and the area painted
+    in that time is returned by takeDirtyRect().
+    ***************************************************************************/
+    class StrokeRenderer
+    {
+    public:
+        static const double END_DOT_RADIUS;
+        static const int LABEL_POINT_SIZE;
+
+        StrokeRenderer();
+        virtual ~StrokeRenderer();
+
+        void startStroke( QImage * image, int id, double x, double y, double penWidth );
+        void continueStroke( QImage * image, int id, double x, double y, double penWidth );
+        void finishStroke( QImage * image, int id, double x, double y, double penWidth );
+        void drawEndDot( QImage * image, double x, double y );
+        void drawLabel( QImage * image, double x, double y, const QString & text );
+        void endFrame();
+        void clear();
+        QRect takeDirtyRect();
+
+    private:
+        void setPenColors();
+        bool beginFrame( QImage * image );
+        void drawSegment( int id, const QPointF & from, const QPointF & to, double penWidth );
+        void addToDirtyRect( const QRectF & rect );
+
+        QPainter painter_;
+        QImage * image_;
+        QList<QColor> penColors_;
+        QFont labelFont_;
+        QMap<int, QPointF> lastPoints_;
+        QRect dirtyRect_;
+    };
+}
+
+#endif
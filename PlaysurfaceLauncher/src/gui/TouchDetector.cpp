@@ -34,11 +34,15 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #include "gui/TouchDetector.h"
 #include "gui/ConfirmExitBox.h"
 #include "gui/ConfirmShutdownBox.h"
-#include "gui/AppIcon.h"
+#include "gui/IconGridIndex.h"
+#include "gui/TouchTable.h"
+#include "gui/StrokeRenderer.h"
 #include "gestures/GestureDetector.h"
 #include "gestures/SidewaysSwipe.h"
 #include "gestures/GestureResult.h"
-#include "gestures/LineGesture.h"
+#include "gestures/GestureParams.h"
+#include "logger/EventJournal.h"
+#include "metrics/Metrics.h"
 #include <QEvent>
 #include <QPointF>
 #include <QTouchEvent>
@@ -54,37 +58,23 @@ const double TouchDetector::DOT_PIXELS = 20.0,
 
 TouchDetector::TouchDetector( gui::ConfirmExitBox * confirmExitBox,
                               gui::ConfirmShutdownBox * confirmShutdownBox,
-                              std::vector<gui::AppIcon *> & appIcons ) :
+                              gui::IconGridIndex * iconGridIndex ) :
   confirmExitBox_( confirmExitBox ),
   confirmShutdownBox_( confirmShutdownBox ),
-  tuioGeneratorIcon_( NULL ),
-  reloadIcon_( NULL ),
-  shutdownIcon_( NULL ),
-  appIcons_( appIcons ),
+  iconGridIndex_( iconGridIndex ),
   gestureDetector_( new gestures::GestureDetector() ),
-  penColors_(),
-  dirty_( false ),
+  strokeRenderer_( new gui::StrokeRenderer() ),
   sidewaysSwipe_( new gestures::SidewaysSwipe() ),
   scrollOffsetX_( 0 ),
   scrollFactor_( 1.0 )
 {
-    setPenColors();
 }
 
 TouchDetector::~TouchDetector()
 {
     delete gestureDetector_;
     delete sidewaysSwipe_;
-}
-
-void TouchDetector::setPenColors()
-{
-    penColors_ << QColor( "red" )
-               << QColor( "green" )
-               << QColor( "cyan" )
-               << QColor( "yellow" )
-               << QColor( "magenta" )
-               << QColor( "orange" );
+    delete strokeRenderer_;
 }
 
 void TouchDetector::setScrollOffsetX( int x )
@@ -92,219 +82,116 @@ void TouchDetector::setScrollOffsetX( int x )
     scrollOffsetX_ = x;
 }
 
-void TouchDetector::setTuioGeneratorIcon( gui::AppIcon * tuioGeneratorIcon )
-{
-    tuioGeneratorIcon_ = tuioGeneratorIcon;
-}
-
-void TouchDetector::setReloadIcon( gui::AppIcon * reloadIcon )
-{
-    reloadIcon_ = reloadIcon;
-}
-
-void TouchDetector::setShutdownIcon( gui::AppIcon * shutdownIcon )
-{
-    shutdownIcon_ = shutdownIcon;
-}
-
-bool TouchDetector::touchOnYesButton( const QTouchEvent::TouchPoint & touchPoint )
-{
-    double x = touchPoint.pos().x(),
-           y = touchPoint.pos().y();
-    return confirmExitBox_->isPointOnYesButton( x, y );
-}
-
-bool TouchDetector::touchOnNoButton( const QTouchEvent::TouchPoint & touchPoint )
-{
-    double x = touchPoint.pos().x(),
-           y = touchPoint.pos().y();
-    return confirmExitBox_->isPointOnNoButton( x, y );
-}
-
-bool TouchDetector::touchOnShutdownComputerButton( const QTouchEvent::TouchPoint & touchPoint )
+bool TouchDetector::touchOnYesButton( const gui::TouchTable & touches, int i )
 {
-    double x = touchPoint.pos().x(),
-           y = touchPoint.pos().y();
-    return confirmShutdownBox_->isPointOnShutdownComputerButton( x, y );
+    return confirmExitBox_->isPointOnYesButton( touches.x( i ), touches.y( i ) );
 }
 
-bool TouchDetector::touchOnShutdownPlaysurfaceButton( const QTouchEvent::TouchPoint & touchPoint )
+bool TouchDetector::touchOnNoButton( const gui::TouchTable & touches, int i )
 {
-    double x = touchPoint.pos().x(),
-           y = touchPoint.pos().y();
-    return confirmShutdownBox_->isPointOnShutdownPlaysurfaceButton( x, y );
+    return confirmExitBox_->isPointOnNoButton( touches.x( i ), touches.y( i ) );
 }
 
-bool TouchDetector::touchOnCancelShutdownButton( const QTouchEvent::TouchPoint & touchPoint )
+bool TouchDetector::touchOnShutdownComputerButton( const gui::TouchTable & touches, int i )
 {
-    double x = touchPoint.pos().x(),
-           y = touchPoint.pos().y();
-    return confirmShutdownBox_->isPointOnCancelButton( x, y );
+    return confirmShutdownBox_->isPointOnShutdownComputerButton( touches.x( i ), touches.y( i ) );
 }
 
-bool TouchDetector::isTouchOnTuioGeneratorIcon( const QTouchEvent::TouchPoint & touchPoint )
+bool TouchDetector::touchOnShutdownPlaysurfaceButton( const gui::TouchTable & touches, int i )
 {
-    if( tuioGeneratorIcon_ != NULL ) {
-        double x = touchPoint.pos().x() - scrollOffsetX_,
-               y = touchPoint.pos().y();
-        //debugPrint( x, y );
-
-        return tuioGeneratorIcon_->containsPoint( x, y );
-    }
-    return false;
+    return confirmShutdownBox_->isPointOnShutdownPlaysurfaceButton( touches.x( i ), touches.y( i ) );
 }
 
-bool TouchDetector::isClickOnTuioGeneratorIcon( double x, double y )
+bool TouchDetector::touchOnCancelShutdownButton( const gui::TouchTable & touches, int i )
 {
-    x -= scrollOffsetX_;
-    return (tuioGeneratorIcon_ != NULL) 
-        && tuioGeneratorIcon_->containsPoint( x, y );
-}
-
-bool TouchDetector::isTouchOnReloadIcon( const QTouchEvent::TouchPoint & touchPoint )
-{
-    if( reloadIcon_ != NULL ) {
-        double x = touchPoint.pos().x() - scrollOffsetX_,
-               y = touchPoint.pos().y();
-        //debugPrint( x, y );
-
-        return reloadIcon_->containsPoint( x, y );
-    }
-    return false;
+    return confirmShutdownBox_->isPointOnCancelButton( touches.x( i ), touches.y( i ) );
 }
 
-bool TouchDetector::isClickOnReloadIcon( double x, double y )
-{
-    x -= scrollOffsetX_;
-    return (reloadIcon_ != NULL) && reloadIcon_->containsPoint( x, y );
-}
-
-bool TouchDetector::isTouchOnShutdownIcon( const QTouchEvent::TouchPoint & touchPoint )
+/***************************************************************************//**
+Returns the index of the app icon under the touch, or one of the negative 
+codes from IconGridIndex (TUIO_GENERATOR_ICON, RELOAD_ICON, SHUTDOWN_ICON, or 
+NO_ICON).  The lookup is a constant time grid calculation, so the cost does 
+not go up with the number of app icons.
+*******************************************************************************/
+int TouchDetector::iconAt( const gui::TouchTable & touches, int i )
 {
-    if( shutdownIcon_ != NULL ) {
-        double x = touchPoint.pos().x() - scrollOffsetX_,
-               y = touchPoint.pos().y();
-        //debugPrint( x, y );
-
-        return shutdownIcon_->containsPoint( x, y );
-    }
-    return false;
+    return iconAt( touches.x( i ), touches.y( i ) );
 }
 
-bool TouchDetector::isClickOnShutdownIcon( double x, double y )
+int TouchDetector::iconAt( double x, double y )
 {
     x -= scrollOffsetX_;
-    return (shutdownIcon_ != NULL) && shutdownIcon_->containsPoint( x, y );
-}
-
-int TouchDetector::indexOfAppIcon( const QTouchEvent::TouchPoint & touchPoint )
-{
-    int index = -1;
-
-    double x = touchPoint.pos().x() - scrollOffsetX_,
-           y = touchPoint.pos().y();
     //debugPrint( x, y );
-
-    for( int i = 0; i < appIcons_.size(); ++i ) {
-        if( appIcons_.at( i )->containsPoint( x, y ) ) {
-            index = i;
-            //debugPrint( x, y, index );
-            break;
-        }
-    }
-    return index;
-}
-
-int TouchDetector::indexOfAppIcon( double x, double y )
-{
-    int index = -1;
-    x -= scrollOffsetX_;
-
-    for( int i = 0; i < appIcons_.size(); ++i ) {
-        if( appIcons_.at( i )->containsPoint( x, y ) ) {
-            index = i;
-            //debugPrint( x, y, index );
-            break;
-        }
-    }
+    int index = iconGridIndex_->iconAt( x, y );
+    //debugPrint( x, y, index );
     return index;
 }
 
 /***************************************************************************//**
-If the touchPoint id is not already in the list of gestures, then a new 
+If the touch id is not already in the list of gestures, then a new 
 gesture will be started.
 *******************************************************************************/
-void TouchDetector::startGesture( const QTouchEvent::TouchPoint & touchPoint,
+void TouchDetector::startGesture( const gui::TouchTable & touches, int i,
                                   QImage * image /*= NULL*/ )
 {
     //std::cout << "\n\nTouchDetector::startGesture() called...\n";
-    int id = touchPoint.id();
-    double x = touchPoint.pos().x() - scrollOffsetX_,
-           y = touchPoint.pos().y();
+    int id = touches.id( i );
+    double x = touches.x( i ),
+           y = touches.y( i );
 
     //debugPrintIdAndXY( id, x, y );
     bool ok = gestureDetector_->startGesture( id, x, y );
 
     if( ok ) {
-        paintDot( image, id, x, y, touchPoint.pressure(), touchPoint.rect() );
+        double w = penWidth( touches.width( i ), touches.height( i ) );
+        strokeRenderer_->startStroke( image, id, x, y, w );
     }
 }
 
-/*******************************************************************************
-Checks for NULL before painting the dot.
+/***************************************************************************//**
+The stroke is drawn DOT_PIXELS wide, unless the touch has a bounding box, in 
+which case it is half the larger side of the box.
 *******************************************************************************/
-void TouchDetector::paintDot( QImage * image, int id, double x, double y, 
-                              double pressure, const QRectF & boundingBox )
+double TouchDetector::penWidth( double w, double h )
 {
-    if( image != NULL ) {
-        double dotDiameter = DOT_PIXELS,
-               w = boundingBox.width(),
-               h = boundingBox.height();
-        //std::cout << std::fixed << std::setprecision( 1 )
-        //          << "bounding box (w x h) = (" << w << " x " << h << ")\n"; 
-        if( w > 0 && h > 0 ) {
-            dotDiameter = (w > h) ? (w / 2.0) : (h / 2.0);
-        }
-        double halfDotDiameter = dotDiameter / 2.0;
-
-        QPainter painter( image );
-        painter.setPen( Qt::NoPen );
-        painter.setBrush( penColors_.at( id % penColors_.count() ) );
-        painter.drawEllipse( QPointF( x, y ), halfDotDiameter, halfDotDiameter );
-        painter.end();
-        dirty_ = true;
+    double dotDiameter = DOT_PIXELS;
+    //std::cout << std::fixed << std::setprecision( 1 )
+    //          << "bounding box (w x h) = (" << w << " x " << h << ")\n"; 
+    if( w > 0 && h > 0 ) {
+        dotDiameter = (w > h) ? (w / 2.0) : (h / 2.0);
     }
+    return dotDiameter;
 }
 
 /***************************************************************************//**
 
 *******************************************************************************/
-void TouchDetector::updateGesture( const QTouchEvent::TouchPoint & touchPoint, 
+void TouchDetector::updateGesture( const gui::TouchTable & touches, int i, 
                                    QImage * image /*= NULL*/ )
 {
     //std::cout << "TouchDetector::updateGesture() called.\n";
-    int id = touchPoint.id();
-    double x = touchPoint.pos().x() - scrollOffsetX_,
-           y = touchPoint.pos().y();
+    int id = touches.id( i );
+    double x = touches.x( i ),
+           y = touches.y( i );
 
-    if( touchPoint.state() != Qt::TouchPointStationary ) {
+    if( touches.state( i ) != Qt::TouchPointStationary ) {
         gestureDetector_->updateGesture( id, x, y );
-        paintDot( image, id, x, y, touchPoint.pressure(), touchPoint.rect() );
+        double w = penWidth( touches.width( i ), touches.height( i ) );
+        strokeRenderer_->continueStroke( image, id, x, y, w );
     }
 }
 
 /***************************************************************************//**
 Returns true if the gesture completes a plus sign.
 *******************************************************************************/
-bool TouchDetector::finishGestureAndTestForPlusSign( const QTouchEvent::TouchPoint & touchPoint, 
+bool TouchDetector::finishGestureAndTestForPlusSign( const gui::TouchTable & touches, int i, 
                                                      QImage * image /*= NULL*/ )
 {
     //std::cout << "TouchDetector::finishGesture() called...\n";
     bool plusSign = false;
-    int id = touchPoint.id();
-    double x = touchPoint.pos().x() - scrollOffsetX_,
-           y = touchPoint.pos().y(),
-           pressure = touchPoint.pressure();
+    int id = touches.id( i );
+    double x = touches.x( i ),
+           y = touches.y( i );
     //debugPrintIdAndXY( id, x, y );
 
     if( image == NULL ) {
@@ -313,20 +200,39 @@ bool TouchDetector::finishGestureAndTestForPlusSign( const QTouchEvent::TouchPoi
     else { // The image is not null, so need info for painting.
         gestures::GestureResult gestureResult = gestureDetector_->finishGestureAndCalculateResult( id, x, y );
         plusSign = gestureResult.isPlusSign();
-        paintDot( image, id, x, y, touchPoint.pressure(), touchPoint.rect() );
+        double w = penWidth( touches.width( i ), touches.height( i ) );
+        strokeRenderer_->finishStroke( image, id, x, y, w );
         paintResultLabel( image, id, x, y, gestureResult );
+
+        if( gestureResult.isHorizontalLine() ) {
+            recordGesture( logger::EventJournal::HORIZONTAL_LINE_GESTURE, x, y );
+        }
+        else if( gestureResult.isVerticalLine() ) {
+            recordGesture( logger::EventJournal::VERTICAL_LINE_GESTURE, x, y );
+        }
+    }
+    if( plusSign ) {
+        recordGesture( logger::EventJournal::PLUS_SIGN_GESTURE, x, y );
     }
     return plusSign;
 }
 
+void TouchDetector::recordGesture( int gesture, double x, double y )
+{
+    logger::EventJournal::instance().record( logger::EventJournal::GESTURE, gesture, (int)x, (int)y );
+    metrics::Metrics & metrics = metrics::Metrics::instance();
+
+    switch( gesture ) {
+        case logger::EventJournal::PLUS_SIGN_GESTURE:        metrics.plusSignGestures.increment();        break;
+        case logger::EventJournal::HORIZONTAL_LINE_GESTURE:  metrics.horizontalLineGestures.increment();  break;
+        case logger::EventJournal::VERTICAL_LINE_GESTURE:    metrics.verticalLineGestures.increment();    break;
+        default:  break;
+    }
+}
+
 void TouchDetector::paintResultLabel( QImage * image, int id, double x, double y,
                                       gestures::GestureResult & gestureResult )
 {
-    QPainter painter( image );
-    painter.setPen( Qt::black );
-    QFont font;
-    font.setPointSize( 12 );
-    painter.setFont( font );
     double textX = x + 10.0,
            textY1 = y + 6.0,
            textY2 = textY1 + 18,
@@ -335,34 +241,32 @@ void TouchDetector::paintResultLabel( QImage * image, int id, double x, double y
 
     if( gestureResult.isHorizontalLine() ) {
         QString aspectRatio = widthHeightRatioAsString( gestureResult );
-        painter.drawText( textX, textY1, "Horizontal Line" );
-        painter.drawText( textX, textY2, aspectRatio );
+        strokeRenderer_->drawLabel( image, textX, textY1, "Horizontal Line" );
+        strokeRenderer_->drawLabel( image, textX, textY2, aspectRatio );
 
         //QString numPoints = numberOfPointsAsString( gestureResult );
-        //painter.drawText( textX, textY4, numPoints );
+        //strokeRenderer_->drawLabel( image, textX, textY4, numPoints );
     }
     else if( gestureResult.isVerticalLine() ) {
         QString aspectRatio = heightWidthRatioAsString( gestureResult );
-        painter.drawText( textX, textY1, "Vertical Line" );
-        painter.drawText( textX, textY2, aspectRatio );
+        strokeRenderer_->drawLabel( image, textX, textY1, "Vertical Line" );
+        strokeRenderer_->drawLabel( image, textX, textY2, aspectRatio );
 
         //QString numPoints = numberOfPointsAsString( gestureResult );
-        //painter.drawText( textX, textY4, numPoints );
+        //strokeRenderer_->drawLabel( image, textX, textY4, numPoints );
     }
-    else if( gestureResult.numberOfPoints() >= gestures::LineGesture::MIN_NUM_POINTS ) {
+    else if( gestureResult.numberOfPoints() >= gestures::GestureParams::current()->minNumPoints() ) {
         QString aspectRatio = greaterRatioAsString( gestureResult );
-        painter.drawText( textX, textY1, "Neither" );
-        painter.drawText( textX, textY2, aspectRatio );
+        strokeRenderer_->drawLabel( image, textX, textY1, "Neither" );
+        strokeRenderer_->drawLabel( image, textX, textY2, aspectRatio );
 
         //QString numPoints = numberOfPointsAsString( gestureResult );
-        //painter.drawText( textX, textY4, numPoints );
+        //strokeRenderer_->drawLabel( image, textX, textY4, numPoints );
     }
     if( gestureResult.isPlusSign() ) {
-        painter.drawText( textX, textY3, "PLUS SIGN DETECTED" );
+        strokeRenderer_->drawLabel( image, textX, textY3, "PLUS SIGN DETECTED" );
     }
-    painter.setBrush( Qt::black );
-    painter.drawEllipse( QPointF( x, y ), 4.0, 4.0 );
-    dirty_ = true;
+    strokeRenderer_->drawEndDot( image, x, y );
 }
 
 QString TouchDetector::widthHeightRatioAsString( gestures::GestureResult & result )
@@ -391,16 +295,29 @@ QString TouchDetector::numberOfPointsAsString( gestures::GestureResult & result
     return "Points = " + QString::number( result.numberOfPoints() );
 }
 
-bool TouchDetector::isPaintingUpdated()
+/***************************************************************************//**
+Returns the area of the image painted since the last call (an empty rect if
+nothing was painted), so that only that area needs to be repainted on screen.
+*******************************************************************************/
+QRect TouchDetector::takeDirtyRect()
+{
+    return strokeRenderer_->takeDirtyRect();
+}
+
+/***************************************************************************//**
+Closes the painter that was opened on the gesture panel image by the first
+touch of the event.  Called once at the end of each touch event.
+*******************************************************************************/
+void TouchDetector::endPainting()
 {
-    bool update = dirty_;
-    dirty_= false;
-    return update;
+    strokeRenderer_->endFrame();
 }
 
 void TouchDetector::clearGestures()
 {
     gestureDetector_->clear();
+    strokeRenderer_->endFrame();
+    strokeRenderer_->clear();
 }
 
 void TouchDetector::setScrollBarParams( double min, double max, double viewWidth )
@@ -415,30 +332,30 @@ void TouchDetector::setScrollBarParams( double min, double max, double viewWidth
      }
 }
 
-void TouchDetector::startSidewaysSwipe( const QTouchEvent::TouchPoint & touchPoint )
+void TouchDetector::startSidewaysSwipe( const gui::TouchTable & touches, int i )
 {
     if( sidewaysSwipe_->isReadyToStart() ) {
-        int id = touchPoint.id(),
-            x = (int)touchPoint.pos().x();
+        int id = touches.id( i ),
+            x = (int)touches.x( i );
 
         sidewaysSwipe_->startSwipe( id, x );
     }
 }
 
-int TouchDetector::updateSidewaysSwipe( const QTouchEvent::TouchPoint & touchPoint )
+int TouchDetector::updateSidewaysSwipe( const gui::TouchTable & touches, int i )
 {
     int deltaX = 0;
 
-    if( touchPoint.id() == sidewaysSwipe_->blobID() ) {
-        int x = (int)touchPoint.pos().x();
+    if( touches.id( i ) == sidewaysSwipe_->blobID() ) {
+        int x = (int)touches.x( i );
         deltaX = (sidewaysSwipe_->lengthOfSwipe( x ) * scrollFactor_);
     }
     return deltaX;
 }
 
-void TouchDetector::finishSidewaysSwipe( const QTouchEvent::TouchPoint & touchPoint )
+void TouchDetector::finishSidewaysSwipe( const gui::TouchTable & touches, int i )
 {
-    if( touchPoint.id() == sidewaysSwipe_->blobID() ) {
+    if( touches.id( i ) == sidewaysSwipe_->blobID() ) {
         sidewaysSwipe_->clear();
     }
 }
@@ -34,12 +34,10 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #ifndef GUI_TOUCHDETECTOR_H
 #define GUI_TOUCHDETECTOR_H
 
-#include <QList>
-#include <QColor>
+#include <QRect>
 #include <QRectF>
 #include <QPainter>
 #include <QBrush>
-#include <QTouchEvent>
 #include <string>
 #include <vector>
 
@@ -47,7 +45,9 @@ class QEvent;
 class QImage;
 namespace gui { class ConfirmExitBox; }
 namespace gui { class ConfirmShutdownBox; }
-namespace gui { class AppIcon; }
+namespace gui { class IconGridIndex; }
+namespace gui { class TouchTable; }
+namespace gui { class StrokeRenderer; }
 namespace gui { class CornerRect; }
 namespace gestures { class GestureDetector; }
 namespace gestures { class SidewaysSwipe; }
@@ -64,46 +64,37 @@ namespace gui
 
         TouchDetector( gui::ConfirmExitBox * confirmExitBox,
                        gui::ConfirmShutdownBox * confirmShutdownBox,
-                       std::vector<gui::AppIcon *> & appIcons );
+                       gui::IconGridIndex * iconGridIndex );
         virtual ~TouchDetector();
 
-        void setTuioGeneratorIcon( gui::AppIcon * tuioGeneratorIcon );
-        void setReloadIcon( gui::AppIcon * reloadIcon );
-        void setShutdownIcon( gui::AppIcon * shutdownIcon );
         void setScrollOffsetX( int x );
 
-        bool touchOnYesButton( const QTouchEvent::TouchPoint & touchPoint );
-        bool touchOnNoButton( const QTouchEvent::TouchPoint & touchPoint );
-        bool touchOnShutdownComputerButton( const QTouchEvent::TouchPoint & touchPoint );
-        bool touchOnShutdownPlaysurfaceButton( const QTouchEvent::TouchPoint & touchPoint );
-        bool touchOnCancelShutdownButton( const QTouchEvent::TouchPoint & touchPoint );
+        bool touchOnYesButton( const gui::TouchTable & touches, int i );
+        bool touchOnNoButton( const gui::TouchTable & touches, int i );
+        bool touchOnShutdownComputerButton( const gui::TouchTable & touches, int i );
+        bool touchOnShutdownPlaysurfaceButton( const gui::TouchTable & touches, int i );
+        bool touchOnCancelShutdownButton( const gui::TouchTable & touches, int i );
 
-        bool isTouchOnTuioGeneratorIcon( const QTouchEvent::TouchPoint & touchPoint );
-        bool isClickOnTuioGeneratorIcon( double x, double y );
-        bool isTouchOnReloadIcon( const QTouchEvent::TouchPoint & touchPoint );
-        bool isClickOnReloadIcon( double x, double y );
-        bool isTouchOnShutdownIcon( const QTouchEvent::TouchPoint & touchPoint );
-        bool isClickOnShutdownIcon( double x, double y );
-        int indexOfAppIcon( const QTouchEvent::TouchPoint & touchPoint );
-        int indexOfAppIcon( double x, double y );
+        int iconAt( const gui::TouchTable & touches, int i );
+        int iconAt( double x, double y );
 
-        void startGesture( const QTouchEvent::TouchPoint & touchPoint, QImage * image = NULL );
-        void updateGesture( const QTouchEvent::TouchPoint & touchPoint, QImage * image = NULL );
-        bool finishGestureAndTestForPlusSign( const QTouchEvent::TouchPoint & touchPoint, QImage * image = NULL );
+        void startGesture( const gui::TouchTable & touches, int i, QImage * image = NULL );
+        void updateGesture( const gui::TouchTable & touches, int i, QImage * image = NULL );
+        bool finishGestureAndTestForPlusSign( const gui::TouchTable & touches, int i, QImage * image = NULL );
         void clearGestures();
-        bool isPaintingUpdated();
+        void endPainting();
+        QRect takeDirtyRect();
 
         void setScrollBarParams( double min, double max, double viewWidth );
-        void startSidewaysSwipe( const QTouchEvent::TouchPoint & touchPoint );
-        int updateSidewaysSwipe( const QTouchEvent::TouchPoint & touchPoint );
-        void finishSidewaysSwipe( const QTouchEvent::TouchPoint & touchPoint );
+        void startSidewaysSwipe( const gui::TouchTable & touches, int i );
+        int updateSidewaysSwipe( const gui::TouchTable & touches, int i );
+        void finishSidewaysSwipe( const gui::TouchTable & touches, int i );
 
     private:
-        void setPenColors();
-        void paintDot( QImage * image, int id, double x, double y, 
-                       double pressure, const QRectF & boundingBox );
+        double penWidth( double w, double h );
         void paintResultLabel( QImage * image, int id, double x, double y,
                                gestures::GestureResult & gestureResult );
+        void recordGesture( int gesture, double x, double y );
         QString widthHeightRatioAsString( gestures::GestureResult & result );
         QString heightWidthRatioAsString( gestures::GestureResult & result );
         QString greaterRatioAsString( gestures::GestureResult & result );
@@ -115,13 +106,9 @@ namespace gui
 
         gui::ConfirmExitBox * confirmExitBox_;
         gui::ConfirmShutdownBox * confirmShutdownBox_;
-        gui::AppIcon * tuioGeneratorIcon_,
-                     * reloadIcon_,
-                     * shutdownIcon_;
-        std::vector<gui::AppIcon *> & appIcons_;
+        gui::IconGridIndex * iconGridIndex_;
         gestures::GestureDetector * gestureDetector_;
-        QList<QColor> penColors_;
-        bool dirty_;
+        gui::StrokeRenderer * strokeRenderer_;
         gestures::SidewaysSwipe * sidewaysSwipe_;
         int scrollOffsetX_;
         double scrollFactor_;
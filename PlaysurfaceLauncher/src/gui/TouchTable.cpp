@@ -0,0 +1,137 @@
+/*******************************************************************************
+TouchTable
+
+PURPOSE: Holds the few values the launcher reads from each touch point of a
+         QTouchEvent (id, position, state, pressure, size, and timestamp) in
+         flat arrays.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "gui/TouchTable.h"
+#include <QTouchEvent>
+#include <QList>
+
+using gui::TouchTable;
+
+TouchTable::TouchTable() :
+  ids_(),
+  xs_(),
+  ys_(),
+  states_(),
+  pressures_(),
+  widths_(),
+  heights_(),
+  timestamps_()
+{
+}
+
+TouchTable::~TouchTable()
+{
+}
+
+/***************************************************************************//**
+The touchPoints() list is read through a const reference, so the TouchPoint
+objects are never copied.  The timestamp of the event is stored with each row.
+*******************************************************************************/
+void TouchTable::fill( const QTouchEvent * touchEvent )
+{
+    clear();
+    const QList<QTouchEvent::TouchPoint> & touchPoints = touchEvent->touchPoints();
+    ulong timestamp = touchEvent->timestamp();
+
+    for( int i = 0; i < touchPoints.size(); ++i ) {
+        const QTouchEvent::TouchPoint & touchPoint = touchPoints.at( i );
+        const QPointF pos = touchPoint.pos();
+        const QRectF rect = touchPoint.rect();
+
+        ids_.push_back( touchPoint.id() );
+        xs_.push_back( pos.x() );
+        ys_.push_back( pos.y() );
+        states_.push_back( touchPoint.state() );
+        pressures_.push_back( touchPoint.pressure() );
+        widths_.push_back( rect.width() );
+        heights_.push_back( rect.height() );
+        timestamps_.push_back( timestamp );
+    }
+}
+
+void TouchTable::clear()
+{
+    ids_.clear();
+    xs_.clear();
+    ys_.clear();
+    states_.clear();
+    pressures_.clear();
+    widths_.clear();
+    heights_.clear();
+    timestamps_.clear();
+}
+
+int TouchTable::size() const
+{
+    return (int)ids_.size();
+}
+
+int TouchTable::id( int i ) const
+{
+    return ids_[i];
+}
+
+double TouchTable::x( int i ) const
+{
+    return xs_[i];
+}
+
+double TouchTable::y( int i ) const
+{
+    return ys_[i];
+}
+
+Qt::TouchPointState TouchTable::state( int i ) const
+{
+    return states_[i];
+}
+
+double TouchTable::pressure( int i ) const
+{
+    return pressures_[i];
+}
+
+double TouchTable::width( int i ) const
+{
+    return widths_[i];
+}
+
+double TouchTable::height( int i ) const
+{
+    return heights_[i];
+}
+
+ulong TouchTable::timestamp( int i ) const
+{
+    return timestamps_[i];
+}
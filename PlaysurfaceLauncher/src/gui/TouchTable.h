@@ -0,0 +1,85 @@
+/*******************************************************************************
+TouchTable
+
+PURPOSE: Holds the few values the launcher reads from each touch point of a
+         QTouchEvent (id, position, state, pressure, size, and timestamp) in
+         flat arrays.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef GUI_TOUCHTABLE_H
+#define GUI_TOUCHTABLE_H
+
+#include <QtGlobal>
+#include <vector>
+
+class QTouchEvent;
+
+namespace gui
+{
+    /***********************************************************************//**
+    A QTouchEvent::TouchPoint carries about 16 points and rectangles behind a 
+    d-pointer, while the launcher only ever reads the id, position, state,
+    pressure, and size of a touch.  The TouchTable copies just those values 
+    out of a QTouchEvent (once per event) into one array per field, and the
+    CentralWidget and TouchDetector read touches by row number from there.
+    
+    The arrays are cleared (not freed) for each new event, so after the
+    first few events no memory is allocated.
+    ***************************************************************************/
+    class TouchTable
+    {
+    public:
+        TouchTable();
+        virtual ~TouchTable();
+
+        void fill( const QTouchEvent * touchEvent );
+        void clear();
+        int size() const;
+
+        int id( int i ) const;
+        double x( int i ) const;
+        double y( int i ) const;
+        Qt::TouchPointState state( int i ) const;
+        double pressure( int i ) const;
+        double width( int i ) const;
+        double height( int i ) const;
+        ulong timestamp( int i ) const;
+
+    private:
+        std::vector<int> ids_;
+        std::vector<double> xs_,
+                            ys_;
+        std::vector<Qt::TouchPointState> states_;
+        std::vector<double> pressures_,
+                            widths_,
+                            heights_;
+        std::vector<ulong> timestamps_;
+    };
+}
+
+#endif
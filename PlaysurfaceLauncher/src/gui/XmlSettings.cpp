@@ -36,27 +36,38 @@ CREATED: 3/14/2015
 #include "xml/SettingsXmlReader.h"
 #include "xml/SettingsXmlWriter.h"
 #include "xml/SettingsValidator.h"
+#include "gestures/GestureParams.h"
 #include "exceptions/FileNotFoundException.h"
 #include "exceptions/SettingsXmlReaderException.h"
 #include "exceptions/SettingsXmlWriterException.h"
 #include "exceptions/UnknownXmlTagException.h"
 #include "exceptions/ValidatorException.h"
+#include "logger/FileLogger.h"
+#include <QFileSystemWatcher>
+#include <QFileInfo>
+#include <QTimer>
 
 using gui::XmlSettings;
 using exceptions::FileNotFoundException;
+using exceptions::IOException;
 using exceptions::SettingsXmlReaderException;
 using exceptions::SettingsXmlWriterException;
 using exceptions::UnknownXmlTagException;
 using exceptions::ValidatorException;
 
 const QString XmlSettings::DEFAULT_CONFIG_FILE = "Data/Settings/PlaysurfaceLauncherSettings.xml";
+const int XmlSettings::CONFIG_FILE_RELOAD_DELAY_MILLISEC = 250;
 
 XmlSettings::XmlSettings() :
   xmlReader_( new xml::SettingsXmlReader() ),
   xmlWriter_( new xml::SettingsXmlWriter() ),
   validator_( new xml::SettingsValidator() ),
-  dialogBox_( new gui::XmlDialogBoxUtils() )
+  dialogBox_( new gui::XmlDialogBoxUtils() ),
+  configFileWatcher_( new QFileSystemWatcher( this ) ),
+  reloadPending_( false )
 {
+    connect( configFileWatcher_, SIGNAL( fileChanged( const QString & ) ),
+             this, SLOT( onConfigFileChanged( const QString & ) ) );
 }
 
 XmlSettings::~XmlSettings()
@@ -90,6 +101,93 @@ bool XmlSettings::isWindows8TouchSelected()
 void XmlSettings::readXmlConfigFile()
 {
     useXmlFileToUpdateValidator();
+    publishGestureParams();
+    watchConfigFile();
+}
+
+/***************************************************************************//**
+Editors often save by writing several times in a row (or by replacing the
+file), so the reload is delayed slightly and only done once per burst of
+change notifications.
+*******************************************************************************/
+void XmlSettings::onConfigFileChanged( const QString & path )
+{
+    if( !reloadPending_ ) {
+        reloadPending_ = true;
+        QTimer::singleShot( CONFIG_FILE_RELOAD_DELAY_MILLISEC, this, SLOT( reloadGestureParams() ) );
+    }
+}
+
+/***************************************************************************//**
+Hot-reloads the <Gestures> thresholds without a restart.  The other settings
+are still applied only at startup (or through the menus).  Only the 
+<Gestures> section is read, into a copy of the validator that replaces the
+current one if the file could be parsed.  Problems are written to the log
+rather than shown in dialogs, since no one asked for the reload.
+*******************************************************************************/
+void XmlSettings::reloadGestureParams()
+{
+    reloadPending_ = false;
+
+    if( QFileInfo( DEFAULT_CONFIG_FILE ).exists() ) {
+        xml::SettingsValidator reloaded( *validator_ );
+
+        try {
+            xmlReader_->readGestures( DEFAULT_CONFIG_FILE, &reloaded );
+            logReloadProblems();
+            *validator_ = reloaded;
+            publishGestureParams();
+        }
+        catch( IOException & e ) {
+            logReloadProblem( e.getMessage() + " (" + e.getSource() + ")" );
+        }
+    }
+    watchConfigFile();
+}
+
+void XmlSettings::logReloadProblems()
+{
+    std::vector<UnknownXmlTagException> unknownTags = xmlReader_->unknownXmlTagExceptions();
+    std::vector<ValidatorException> invalidValues = xmlReader_->validatorExceptions();
+
+    for( size_t i = 0; i < unknownTags.size(); ++i ) {
+        logReloadProblem( unknownTags[i].getMessage() + " <" + unknownTags[i].getTagName() + ">" );
+    }
+    for( size_t i = 0; i < invalidValues.size(); ++i ) {
+        logReloadProblem( invalidValues[i].getMessage() 
+                          + " " + invalidValues[i].getTagName() 
+                          + " = \"" + invalidValues[i].getTagValue() 
+                          + "\" (expected " + invalidValues[i].getTagExpectedValue() + ")" );
+    }
+}
+
+void XmlSettings::logReloadProblem( const QString & problem )
+{
+    QString message = "XmlSettings: gesture settings not reloaded from " 
+                      + DEFAULT_CONFIG_FILE + ": " + problem;
+    logger::FileLogger::instance().writeWarning( message.toStdString() );
+}
+
+void XmlSettings::publishGestureParams()
+{
+    gestures::GestureParams params( validator_->gestureMinNumPoints(),
+                                    validator_->gestureExpirationMilliseconds(),
+                                    validator_->gestureValidLineAspectRatio(),
+                                    validator_->gestureToleranceFactor() );
+    gestures::GestureParams::publish( params );
+}
+
+/***************************************************************************//**
+A file that is replaced (rather than rewritten) drops out of the watcher, so
+this is called again after every reload.
+*******************************************************************************/
+void XmlSettings::watchConfigFile()
+{
+    bool isWatched = configFileWatcher_->files().contains( DEFAULT_CONFIG_FILE );
+
+    if( !isWatched && QFileInfo( DEFAULT_CONFIG_FILE ).exists() ) {
+        configFileWatcher_->addPath( DEFAULT_CONFIG_FILE );
+    }
 }
 
 void XmlSettings::updateMainWindowSettings( gui::FullScreenWindow * mainWindow )
@@ -102,6 +200,15 @@ void XmlSettings::updateMainWindowSettings( gui::FullScreenWindow * mainWindow )
 
     bool usePlusSign = validator_->usePlusGestureToQuitApps();
     mainWindow->setGesturesMenuPlusSignOption( usePlusSign );
+
+    bool useOpenGL = validator_->useOpenGLRenderer();
+    mainWindow->useOpenGLRenderer( useOpenGL );
+
+    bool useWarmStart = validator_->useWarmStart();
+    mainWindow->useWarmStart( useWarmStart, validator_->warmStartApps() );
+
+    int metricsPort = validator_->metricsPort();
+    mainWindow->useMetricsPort( metricsPort );
 }
 
 void XmlSettings::saveSettingsToXmlFile( gui::FullScreenWindow * mainWindow )
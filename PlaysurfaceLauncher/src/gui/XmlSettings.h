@@ -37,6 +37,7 @@ CREATED: 3/14/2015
 #include <QObject>
 #include <QString>
 
+class QFileSystemWatcher;
 namespace xml { class SettingsXmlReader; }
 namespace xml { class SettingsXmlWriter; }
 namespace xml { class SettingsValidator; }
@@ -51,6 +52,7 @@ namespace gui
 
     public:
         static const QString DEFAULT_CONFIG_FILE;
+        static const int CONFIG_FILE_RELOAD_DELAY_MILLISEC;
 
         XmlSettings();
         ~XmlSettings();
@@ -64,15 +66,23 @@ namespace gui
         void readXmlConfigFile();
         void updateMainWindowSettings( gui::FullScreenWindow * mainWindow );
         void saveSettingsToXmlFile( gui::FullScreenWindow * mainWindow );
+        void onConfigFileChanged( const QString & path );
+        void reloadGestureParams();
 
     private:
         void useXmlFileToUpdateValidator();
         void useValidatorToUpdateXmlFile();
+        void publishGestureParams();
+        void logReloadProblems();
+        void logReloadProblem( const QString & problem );
+        void watchConfigFile();
 
         xml::SettingsXmlReader * xmlReader_;
         xml::SettingsXmlWriter * xmlWriter_;
         xml::SettingsValidator * validator_;
         gui::XmlDialogBoxUtils * dialogBox_;
+        QFileSystemWatcher * configFileWatcher_;
+        bool reloadPending_;
     };
 }
 
@@ -0,0 +1,288 @@
+/*******************************************************************************
+AppCatalog
+
+PURPOSE: A memory-mappable on-disk catalog of the multitouch apps found on the
+         last scan, with the signatures used to skip unchanged app
+         directories.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "io/AppCatalog.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <QSaveFile>
+
+using io::AppCatalog;
+
+const QString AppCatalog::CACHE_DIRECTORY = "Data/Cache/AppCatalog",
+              AppCatalog::CATALOG_FILE = "AppCatalog.dat";
+const quint32 AppCatalog::MAGIC = 0x43415350; // "PSAC"
+const int AppCatalog::FILE_VERSION = 2;
+
+/***************************************************************************//**
+Reads the signature of an app subdirectory.  A file that does not exist gets
+a size and modification time of -1, so it never matches a cataloged file.
+*******************************************************************************/
+AppCatalog::Signature AppCatalog::Signature::read( const QString & directory,
+                                                   const QString & appFilename,
+                                                   const QString & iconFilename )
+{
+    Signature signature;
+    QFileInfo dirInfo( directory ),
+              appInfo( directory + "/" + appFilename ),
+              iconInfo( directory + "/" + iconFilename );
+
+    if( dirInfo.exists() ) {
+        signature.directoryModified = dirInfo.lastModified().toMSecsSinceEpoch();
+    }
+    if( appInfo.exists() ) {
+        signature.appSize = appInfo.size();
+        signature.appModified = appInfo.lastModified().toMSecsSinceEpoch();
+    }
+    if( iconInfo.exists() ) {
+        signature.iconSize = iconInfo.size();
+        signature.iconModified = iconInfo.lastModified().toMSecsSinceEpoch();
+    }
+    return signature;
+}
+
+AppCatalog::Signature::Signature() :
+  directoryModified( -1 ),
+  appSize( -1 ),
+  appModified( -1 ),
+  iconSize( -1 ),
+  iconModified( -1 )
+{
+}
+
+bool AppCatalog::Signature::equals( const Signature & other ) const
+{
+    return directoryModified == other.directoryModified
+           && appSize == other.appSize
+           && appModified == other.appModified
+           && iconSize == other.iconSize
+           && iconModified == other.iconModified;
+}
+
+AppCatalog::AppCatalog() :
+  file_( NULL ),
+  data_( NULL ),
+  dataSize_( 0 ),
+  entryCount_( 0 ),
+  index_()
+{
+}
+
+AppCatalog::~AppCatalog()
+{
+    unload();
+}
+
+/***************************************************************************//**
+Maps the catalog file into memory and indexes its records by subdirectory.
+Returns false (and leaves the catalog empty) if there is no catalog, it was
+written by a different version, or it is truncated or corrupt.
+*******************************************************************************/
+bool AppCatalog::load()
+{
+    unload();
+    file_ = new QFile( CACHE_DIRECTORY + "/" + CATALOG_FILE );
+
+    if( file_->open( QIODevice::ReadOnly ) && file_->size() >= (qint64)sizeof( FileHeader ) ) {
+        dataSize_ = file_->size();
+        data_ = file_->map( 0, dataSize_ );
+
+        if( data_ != NULL && indexRecords() ) {
+            return true;
+        }
+    }
+    unload();
+    return false;
+}
+
+bool AppCatalog::indexRecords()
+{
+    const FileHeader * header = reinterpret_cast<const FileHeader *>( data_ );
+
+    if( header->magic != MAGIC
+        || header->version != (quint32)FILE_VERSION
+        || !isInFile( sizeof( FileHeader ), (qint64)header->entryCount * sizeof( EntryRecord ) ) )
+    {
+        return false;
+    }
+    entryCount_ = (int)header->entryCount;
+
+    for( int i = 0; i < entryCount_; ++i ) {
+        const EntryRecord * r = record( i );
+
+        if( !isInFile( r->directoryOffset, (qint64)r->directoryLength * sizeof( QChar ) )
+            || !isInFile( r->appFilenameOffset, (qint64)r->appFilenameLength * sizeof( QChar ) )
+            || !isInFile( r->iconFilenameOffset, (qint64)r->iconFilenameLength * sizeof( QChar ) ) )
+        {
+            index_.clear();
+            entryCount_ = 0;
+            return false;
+        }
+        index_.insert( readString( r->directoryOffset, r->directoryLength ), i );
+    }
+    return true;
+}
+
+bool AppCatalog::isInFile( qint64 offset, qint64 length ) const
+{
+    return offset >= 0 && length >= 0 && offset + length <= dataSize_;
+}
+
+QString AppCatalog::readString( quint32 offset, quint32 length ) const
+{
+    return QString( reinterpret_cast<const QChar *>( data_ + offset ), (int)length );
+}
+
+const AppCatalog::EntryRecord * AppCatalog::record( int index ) const
+{
+    return reinterpret_cast<const EntryRecord *>( data_ + sizeof( FileHeader ) ) + index;
+}
+
+void AppCatalog::unload()
+{
+    if( file_ != NULL ) {
+        if( data_ != NULL ) {
+            file_->unmap( const_cast<uchar *>( data_ ) );
+        }
+        file_->close();
+        delete file_;
+        file_ = NULL;
+    }
+    data_ = NULL;
+    dataSize_ = 0;
+    entryCount_ = 0;
+    index_.clear();
+}
+
+bool AppCatalog::isLoaded() const
+{
+    return data_ != NULL;
+}
+
+int AppCatalog::size() const
+{
+    return entryCount_;
+}
+
+/***************************************************************************//**
+Looks up an app subdirectory.  Returns true (and fills in the entry) only if
+the subdirectory is in the catalog and its signature has not changed since it
+was cataloged.  The strings are copied out of the mapped file, so the entry
+stays valid after the catalog is unloaded.
+*******************************************************************************/
+bool AppCatalog::find( const QString & directory, Entry & entry ) const
+{
+    QHash<QString, int>::const_iterator it = index_.find( directory );
+
+    if( it == index_.end() ) {
+        return false;
+    }
+    const EntryRecord * r = record( it.value() );
+    QString appFilename = readString( r->appFilenameOffset, r->appFilenameLength ),
+            iconFilename = readString( r->iconFilenameOffset, r->iconFilenameLength );
+    Signature cataloged,
+              signature = Signature::read( directory, appFilename, iconFilename );
+    cataloged.directoryModified = r->directoryModified;
+    cataloged.appSize = r->appSize;
+    cataloged.appModified = r->appModified;
+    cataloged.iconSize = r->iconSize;
+    cataloged.iconModified = r->iconModified;
+
+    if( !signature.equals( cataloged ) ) {
+        return false;
+    }
+    entry.directory = directory;
+    entry.appFilename = appFilename;
+    entry.iconFilename = iconFilename;
+    entry.signature = signature;
+    return true;
+}
+
+/***************************************************************************//**
+Replaces the catalog file with the given entries.  The catalog is unloaded
+first (the file cannot be replaced while it is mapped), and the new file is
+written with a QSaveFile, so an interrupted save leaves the old catalog.
+*******************************************************************************/
+bool AppCatalog::save( const std::vector<Entry> & entries )
+{
+    unload();
+    QDir().mkpath( CACHE_DIRECTORY );
+    std::vector<EntryRecord> records( entries.size() );
+    qint64 offset = sizeof( FileHeader ) + entries.size() * sizeof( EntryRecord );
+
+    for( int i = 0; i < (int)entries.size(); ++i ) {
+        const Entry & entry = entries.at( i );
+        EntryRecord & r = records.at( i );
+        r.directoryModified = entry.signature.directoryModified;
+        r.appSize = entry.signature.appSize;
+        r.appModified = entry.signature.appModified;
+        r.iconSize = entry.signature.iconSize;
+        r.iconModified = entry.signature.iconModified;
+        r.directoryOffset = (quint32)offset;
+        r.directoryLength = entry.directory.size();
+        offset += entry.directory.size() * sizeof( QChar );
+        r.appFilenameOffset = (quint32)offset;
+        r.appFilenameLength = entry.appFilename.size();
+        offset += entry.appFilename.size() * sizeof( QChar );
+        r.iconFilenameOffset = (quint32)offset;
+        r.iconFilenameLength = entry.iconFilename.size();
+        offset += entry.iconFilename.size() * sizeof( QChar );
+    }
+    FileHeader header;
+    header.magic = MAGIC;
+    header.version = FILE_VERSION;
+    header.entryCount = (quint32)entries.size();
+    header.reserved = 0;
+
+    QSaveFile file( CACHE_DIRECTORY + "/" + CATALOG_FILE );
+
+    if( !file.open( QIODevice::WriteOnly ) ) {
+        return false;
+    }
+    file.write( reinterpret_cast<const char *>( &header ), sizeof( FileHeader ) );
+
+    if( !records.empty() ) {
+        file.write( reinterpret_cast<const char *>( &records[0] ), records.size() * sizeof( EntryRecord ) );
+    }
+    for( int i = 0; i < (int)entries.size(); ++i ) {
+        const Entry & entry = entries.at( i );
+        file.write( reinterpret_cast<const char *>( entry.directory.constData() ),
+                    entry.directory.size() * sizeof( QChar ) );
+        file.write( reinterpret_cast<const char *>( entry.appFilename.constData() ),
+                    entry.appFilename.size() * sizeof( QChar ) );
+        file.write( reinterpret_cast<const char *>( entry.iconFilename.constData() ),
+                    entry.iconFilename.size() * sizeof( QChar ) );
+    }
+    return file.commit();
+}
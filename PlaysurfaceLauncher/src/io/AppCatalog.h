@@ -0,0 +1,165 @@
+/*******************************************************************************
+AppCatalog
+
+PURPOSE: A memory-mappable on-disk catalog of the multitouch apps found on the
+         last scan, with the signatures used to skip unchanged app
+         directories.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef IO_APPCATALOG_H
+#define IO_APPCATALOG_H
+
+#include <QString>
+#include <QHash>
+#include <vector>
+
+class QFile;
+
+namespace io
+{
+    /***********************************************************************//**
+    An on-disk catalog of the multitouch apps found on the last scan, so that
+    an app subdirectory that has not changed does not have to be searched
+    again.
+
+    For each app subdirectory, the catalog keeps the names of the app and
+    icon files and a Signature (the modification time of the subdirectory 
+    plus the size and modification time of the two files).  The icon pixels
+    are not kept here; the icons are decoded lazily by the gui::IconLoader 
+    and cached in the gui::IconAtlas, one key per icon file, so an unchanged
+    icon is reused even when other apps change.  The file is a fixed-layout binary
+    format (a header, a table of fixed-size entry records, and then the 
+    strings), so load() just maps the file into memory and indexes the 
+    records.  The layout uses the byte order of the machine that wrote it, 
+    which is fine for a local cache.
+
+    After load(), find() only reads the mapped file, so it may be called from
+    several worker threads at once.  save() unmaps the file before replacing
+    it, so it must not be called while a scan is using the catalog.
+    ***************************************************************************/
+    class AppCatalog
+    {
+    public:
+        /*******************************************************************//**
+        The sizes and modification times that tell whether an app
+        subdirectory has changed since it was cataloged.  Adding or removing
+        a file changes the modification time of the subdirectory.
+        ***********************************************************************/
+        class Signature
+        {
+        public:
+            static Signature read( const QString & directory,
+                                   const QString & appFilename,
+                                   const QString & iconFilename );
+            Signature();
+
+            bool equals( const Signature & other ) const;
+
+            qint64 directoryModified,
+                   appSize,
+                   appModified,
+                   iconSize,
+                   iconModified;
+        };
+
+        /*******************************************************************//**
+        One cataloged app subdirectory.
+        ***********************************************************************/
+        class Entry
+        {
+        public:
+            QString directory,
+                    appFilename,
+                    iconFilename;
+            Signature signature;
+        };
+
+        static const QString CACHE_DIRECTORY,
+                             CATALOG_FILE;
+        static const quint32 MAGIC;
+        static const int FILE_VERSION;
+
+        AppCatalog();
+        virtual ~AppCatalog();
+
+        bool load();
+        void unload();
+        bool isLoaded() const;
+        int size() const;
+        bool find( const QString & directory, Entry & entry ) const;
+        bool save( const std::vector<Entry> & entries );
+
+    private:
+        /*******************************************************************//**
+        The first bytes of the catalog file.
+        ***********************************************************************/
+        class FileHeader
+        {
+        public:
+            quint32 magic,
+                    version,
+                    entryCount,
+                    reserved;
+        };
+
+        /*******************************************************************//**
+        The fixed-size record for one entry.  The strings are stored as UTF-16
+        and their lengths are in QChars; all offsets are in bytes from the
+        start of the file.  The 64-bit fields come first so that the record
+        has no padding.
+        ***********************************************************************/
+        class EntryRecord
+        {
+        public:
+            qint64 directoryModified,
+                   appSize,
+                   appModified,
+                   iconSize,
+                   iconModified;
+            quint32 directoryOffset,
+                    directoryLength,
+                    appFilenameOffset,
+                    appFilenameLength,
+                    iconFilenameOffset,
+                    iconFilenameLength;
+        };
+
+        bool indexRecords();
+        bool isInFile( qint64 offset, qint64 length ) const;
+        QString readString( quint32 offset, quint32 length ) const;
+        const EntryRecord * record( int index ) const;
+
+        QFile * file_;
+        const uchar * data_;
+        qint64 dataSize_;
+        int entryCount_;
+        QHash<QString, int> index_;
+    };
+}
+
+#endif
@@ -36,11 +36,16 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 */
 #include "io/DirectoryReader.h"
 #include "app/AppInfo.h"
-#include "app/AppInfoList.h"
 #include "exceptions/FileNotFoundException.h"
 #include "exceptions/FileNotReadableException.h"
+#include "logger/FileLogger.h"
+#include "metrics/Metrics.h"
 #include <QFileInfo>
 #include <QDir>
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <QtConcurrentRun>
+#include <QtConcurrentMap>
 #include <iostream>
 
 using io::DirectoryReader;
@@ -60,29 +65,89 @@ const QString DirectoryReader::BIG_BLOBBY_DIR = "./BigBlobby",
               DirectoryReader::MULTI_TOUCH_DIR = "./MultitouchApps",
               DirectoryReader::USB_DRIVE_MULTI_TOUCH_DIR = "MultitouchAppsUsbDrive",
               DirectoryReader::DRIVE_SYMBOL = ":/";
+const int DirectoryReader::WATCH_DELAY_MILLISECONDS = 1000;
+
+DirectoryReader::ScanResult::ScanResult() :
+  appInfo( NULL ),
+  catalogEntry(),
+  fromCatalog( false ),
+  errors()
+{
+}
+
+DirectoryReader::SubdirScanner::SubdirScanner( const io::AppCatalog * catalog ) :
+  catalog_( catalog )
+{
+}
+
+DirectoryReader::ScanResult DirectoryReader::SubdirScanner::operator()( const QString & fullSubdirName ) const
+{
+    return DirectoryReader::scanSubdir( fullSubdirName, catalog_ );
+}
 
 DirectoryReader::DirectoryReader() :
   errors_(),
-  drivesInUse_()
+  drivesInUse_(),
+  catalog_( new io::AppCatalog() ),
+  catalogEntries_(),
+  catalogChanged_( false ),
+  subdirs_(),
+  appDirs_(),
+  updateSubdirs_(),
+  pendingChanges_(),
+  fileWatcher_( new QFileSystemWatcher( this ) ),
+  changeTimer_( new QTimer( this ) ),
+  updateWatcher_( new QFutureWatcher<ScanResult>( this ) ),
+  listWatcher_( new QFutureWatcher<QStringList>( this ) ),
+  scanWatcher_( new QFutureWatcher<ScanResult>( this ) ),
+  resultReady_(),
+  nextResultToDeliver_( 0 ),
+  readStartedMicroseconds_( 0 ),
+  reading_( false ),
+  updating_( false ),
+  rescanRequested_( false )
 {
+    changeTimer_->setSingleShot( true );
+    changeTimer_->setInterval( WATCH_DELAY_MILLISECONDS );
+    connect( listWatcher_, SIGNAL( finished() ), this, SLOT( onSubdirsListed() ) );
+    connect( scanWatcher_, SIGNAL( resultReadyAt( int ) ), this, SLOT( onScanResultReady( int ) ) );
+    connect( scanWatcher_, SIGNAL( finished() ), this, SLOT( onScanFinished() ) );
+    connect( fileWatcher_, SIGNAL( directoryChanged( const QString & ) ), 
+             this, SLOT( onDirectoryChanged( const QString & ) ) );
+    connect( changeTimer_, SIGNAL( timeout() ), this, SLOT( applyPendingChanges() ) );
+    connect( updateWatcher_, SIGNAL( finished() ), this, SLOT( onUpdateFinished() ) );
 }
 
+/***************************************************************************//**
+Waits for any scan still running on the thread pool, and deletes the AppInfo
+objects that were never handed out with the appInfoRead() signal.
+*******************************************************************************/
 DirectoryReader::~DirectoryReader()
 {
+    listWatcher_->disconnect( this );
+    scanWatcher_->disconnect( this );
+    updateWatcher_->disconnect( this );
+    listWatcher_->waitForFinished();
+    scanWatcher_->waitForFinished();
+    updateWatcher_->waitForFinished();
+    deleteUndeliveredResults();
+    delete catalog_;
 }
 
 app::AppInfo * DirectoryReader::readBigBlobbyInfo()
 {
     checkThatFileExists( BIG_BLOBBY_EXECUTABLE, BIG_BLOBBY_DIR );
-    QImage iconImage = loadImage( BIG_BLOBBY_IMAGE_FILE, BIG_BLOBBY_DIR );
-    return new app::AppInfo( BIG_BLOBBY_EXECUTABLE, BIG_BLOBBY_DIR, iconImage );
+    checkThatImageIsReadable( BIG_BLOBBY_IMAGE_FILE, BIG_BLOBBY_DIR );
+    return new app::AppInfo( BIG_BLOBBY_EXECUTABLE, BIG_BLOBBY_DIR,
+                             BIG_BLOBBY_DIR + "/" + BIG_BLOBBY_IMAGE_FILE );
 }
 
 app::AppInfo * DirectoryReader::readTouchHooks2TuioInfo()
 {
     checkThatFileExists( TOUCH_HOOKS_EXECUTABLE, TOUCH_HOOKS_DIR );
-    QImage iconImage = loadImage( TOUCH_HOOKS_IMAGE_FILE, TOUCH_HOOKS_DIR );
-    return new app::AppInfo( TOUCH_HOOKS_EXECUTABLE, TOUCH_HOOKS_DIR, iconImage );
+    checkThatImageIsReadable( TOUCH_HOOKS_IMAGE_FILE, TOUCH_HOOKS_DIR );
+    return new app::AppInfo( TOUCH_HOOKS_EXECUTABLE, TOUCH_HOOKS_DIR,
+                             TOUCH_HOOKS_DIR + "/" + TOUCH_HOOKS_IMAGE_FILE );
 }
 
 void DirectoryReader::checkThatFileExists( const QString & filename, 
@@ -98,46 +163,382 @@ void DirectoryReader::checkThatFileExists( const QString & filename,
     }
 }
 
-QImage DirectoryReader::loadImage( const QString & filename, 
-                                   const QString & fullSubdirName )
+/***************************************************************************//**
+Only checks that the image file is there and can be read; the image is not
+decoded until its icon is first shown (see gui::IconLoader).
+*******************************************************************************/
+void DirectoryReader::checkThatImageIsReadable( const QString & filename, 
+                                                const QString & fullSubdirName )
 {
-    QImage image;
     QString pathToImageFile = fullSubdirName + "/" + filename;
-    bool ok = image.load( pathToImageFile );
+    QFileInfo fileInfo( pathToImageFile );
 
-    if( !ok ) {
-        QFileInfo fileInfo( pathToImageFile );
-        
-        if( fileInfo.exists() && !fileInfo.isReadable() ) {
-            throw FileNotReadableException( "Image Not Readable: " + pathToImageFile,
-                                            "DirectoryReader::loadImage()",
-                                            pathToImageFile );
-        }
-        else {
-            throw FileNotFoundException( "Image Not Found: " + pathToImageFile,
-                                         "DirectoryReader::loadImage()",
-                                         pathToImageFile );
-        }
+    if( !fileInfo.exists() ) {
+        throw FileNotFoundException( "Image Not Found: " + pathToImageFile,
+                                     "DirectoryReader::checkThatImageIsReadable()",
+                                     pathToImageFile );
+    }
+    if( !fileInfo.isReadable() ) {
+        throw FileNotReadableException( "Image Not Readable: " + pathToImageFile,
+                                        "DirectoryReader::checkThatImageIsReadable()",
+                                        pathToImageFile );
     }
-    return image;
 }
 
 app::AppInfo * DirectoryReader::readFlashPlayerInfo()
 {
     checkThatFileExists( FLASH_PLAYER_EXECUTABLE, FLASH_PLAYER_DIR );
-    QImage iconImage = loadImage( FLASH_PLAYER_IMAGE_FILE, FLASH_PLAYER_DIR );
-    return new app::AppInfo( FLASH_PLAYER_EXECUTABLE, FLASH_PLAYER_DIR, iconImage );
+    checkThatImageIsReadable( FLASH_PLAYER_IMAGE_FILE, FLASH_PLAYER_DIR );
+    return new app::AppInfo( FLASH_PLAYER_EXECUTABLE, FLASH_PLAYER_DIR,
+                             FLASH_PLAYER_DIR + "/" + FLASH_PLAYER_IMAGE_FILE );
 }
 
-void DirectoryReader::readMultitouchAppsInfo( app::AppInfoList * appInfoList )
+/***************************************************************************//**
+Starts reading the multitouch apps in the background.  The signal
+multitouchAppsReadStarted() is emitted right away, then appInfoRead() once
+for each app found, and finally multitouchAppsReadFinished().  If a read is
+already running, another read is started as soon as it finishes, so that
+changes made to the directories in the meantime are not missed.
+*******************************************************************************/
+void DirectoryReader::startReadingMultitouchAppsInfo()
 {
+    if( reading_ || updating_ ) {
+        rescanRequested_ = true;
+        return;
+    }
+    reading_ = true;
+    rescanRequested_ = false;
+    errors_.clear();
     clearListOfDriveNames();
-    readMultitouchAppsInfo( MULTI_TOUCH_DIR, appInfoList );
-    readMultitouchAppsOnUsbDrive( appInfoList );
+    catalogEntries_.clear();
+    catalogChanged_ = false;
+    appDirs_.clear();
+    pendingChanges_.clear();
+    changeTimer_->stop();
+
+    readStartedMicroseconds_ = metrics::Metrics::microseconds();
+
+    if( !catalog_->isLoaded() ) {
+        catalog_->load();
+    }
+    emit multitouchAppsReadStarted();
+    listWatcher_->setFuture( QtConcurrent::run( &DirectoryReader::listMultitouchAppsSubdirs ) );
+}
+
+bool DirectoryReader::isReadingMultitouchAppsInfo()
+{
+    return reading_;
+}
+
+void DirectoryReader::onSubdirsListed()
+{
+    QStringList subdirs = listWatcher_->result();
+    subdirs_ = subdirs;
+    watchDirectories();
+    resultReady_.assign( subdirs.size(), false );
+    nextResultToDeliver_ = 0;
+    scanWatcher_->setFuture( QtConcurrent::mapped( subdirs, SubdirScanner( catalog_ ) ) );
+}
+
+/***************************************************************************//**
+Results come back from the thread pool in whatever order the scans finish,
+so each one is only marked as ready here, and results are handed out in
+directory order by deliverReadyResults().
+*******************************************************************************/
+void DirectoryReader::onScanResultReady( int index )
+{
+    if( index >= 0 && index < (int)resultReady_.size() ) {
+        resultReady_[index] = true;
+        deliverReadyResults();
+    }
+}
+
+void DirectoryReader::deliverReadyResults()
+{
+    while( nextResultToDeliver_ < (int)resultReady_.size() 
+           && resultReady_[nextResultToDeliver_] ) 
+    {
+        deliver( scanWatcher_->resultAt( nextResultToDeliver_ ) );
+        ++nextResultToDeliver_;
+    }
+}
+
+void DirectoryReader::deliver( const ScanResult & result )
+{
+    errors_.insert( errors_.end(), result.errors.begin(), result.errors.end() );
+
+    if( result.appInfo != NULL ) {
+        catalogEntries_.insert( result.appInfo->directory(), result.catalogEntry );
+        catalogChanged_ = catalogChanged_ || !result.fromCatalog;
+        appDirs_ << result.appInfo->directory();
+        addDrivenameToList( result.appInfo->directory() );
+        emit appInfoRead( result.appInfo );
+    }
+}
+
+void DirectoryReader::onScanFinished()
+{
+    deliverReadyResults();
+    resultReady_.clear();
+    nextResultToDeliver_ = 0;
+    saveCatalogIfChanged();
+    reading_ = false;
+    metrics::Metrics::instance().directoryScanTime.observeSince( readStartedMicroseconds_ );
+    emit multitouchAppsReadFinished();
+    startPendingWork();
+}
+
+/***************************************************************************//**
+Starts a full read that was requested while the last read or update was
+running, or else applies any changes that were seen in the meantime.
+*******************************************************************************/
+void DirectoryReader::startPendingWork()
+{
+    if( rescanRequested_ ) {
+        startReadingMultitouchAppsInfo();
+    }
+    else if( !pendingChanges_.isEmpty() ) {
+        changeTimer_->start();
+    }
+}
+
+/***************************************************************************//**
+Saves the current apps as the new catalog, unless every one of them came
+from the catalog and none were removed.  The catalog is unloaded by the save,
+and loaded again (from the new file) when the next read or update starts.
+*******************************************************************************/
+void DirectoryReader::saveCatalogIfChanged()
+{
+    if( catalogChanged_ || catalogEntries_.size() != catalog_->size() ) {
+        std::vector<io::AppCatalog::Entry> entries;
+        entries.reserve( catalogEntries_.size() );
+
+        for( QMap<QString, io::AppCatalog::Entry>::const_iterator it = catalogEntries_.constBegin();
+             it != catalogEntries_.constEnd(); ++it ) 
+        {
+            entries.push_back( it.value() );
+        }
+        if( !catalog_->save( entries ) ) {
+            logger::FileLogger::instance().writeWarning( "DirectoryReader: could not save the app catalog." );
+        }
+    }
+    catalogChanged_ = false;
+}
+
+/***************************************************************************//**
+Watches the MultitouchApps directory (for apps being added or removed) and
+each of its app subdirectories (for apps being changed).
+*******************************************************************************/
+void DirectoryReader::watchDirectories()
+{
+    QStringList wanted;
+
+    if( QDir( MULTI_TOUCH_DIR ).exists() ) {
+        wanted << MULTI_TOUCH_DIR;
+    }
+    for( int i = 0; i < subdirs_.size(); ++i ) {
+        if( isWatchedSubdir( subdirs_.at( i ) ) ) {
+            wanted << subdirs_.at( i );
+        }
+    }
+    QStringList watched = fileWatcher_->directories(),
+                toRemove,
+                toAdd;
+
+    for( int i = 0; i < watched.size(); ++i ) {
+        if( !wanted.contains( watched.at( i ) ) ) {
+            toRemove << watched.at( i );
+        }
+    }
+    for( int i = 0; i < wanted.size(); ++i ) {
+        if( !watched.contains( wanted.at( i ) ) ) {
+            toAdd << wanted.at( i );
+        }
+    }
+    if( !toRemove.isEmpty() ) {
+        fileWatcher_->removePaths( toRemove );
+    }
+    if( !toAdd.isEmpty() ) {
+        fileWatcher_->addPaths( toAdd );
+    }
+}
+
+bool DirectoryReader::isWatchedSubdir( const QString & fullSubdirName )
+{
+    return fullSubdirName.startsWith( MULTI_TOUCH_DIR + "/" );
+}
+
+/***************************************************************************//**
+Copying an app into the MultitouchApps directory changes the directories
+many times, so the changes are collected until none have been seen for
+WATCH_DELAY_MILLISECONDS.
+*******************************************************************************/
+void DirectoryReader::onDirectoryChanged( const QString & path )
+{
+    pendingChanges_.insert( path );
+    changeTimer_->start();
+}
+
+/***************************************************************************//**
+Relists the MultitouchApps directory if it changed (removing the apps whose
+subdirectories are gone), and then scans only the new subdirectories and
+the ones that changed.  If a read or update is running, the changes are
+kept until it finishes.
+*******************************************************************************/
+void DirectoryReader::applyPendingChanges()
+{
+    if( reading_ || updating_ || pendingChanges_.isEmpty() ) {
+        return;
+    }
+    QSet<QString> changes = pendingChanges_;
+    pendingChanges_.clear();
+    QStringList toScan;
+
+    if( changes.contains( MULTI_TOUCH_DIR ) ) {
+        QStringList localSubdirs,
+                    newSubdirs;
+        appendSubdirs( MULTI_TOUCH_DIR, localSubdirs );
+        newSubdirs = localSubdirs;
+
+        for( int i = 0; i < subdirs_.size(); ++i ) {
+            if( !isWatchedSubdir( subdirs_.at( i ) ) ) {
+                newSubdirs << subdirs_.at( i );
+            }
+            else if( !localSubdirs.contains( subdirs_.at( i ) ) ) {
+                removeApp( subdirs_.at( i ) );
+            }
+        }
+        for( int i = 0; i < localSubdirs.size(); ++i ) {
+            if( !subdirs_.contains( localSubdirs.at( i ) ) ) {
+                toScan << localSubdirs.at( i );
+            }
+        }
+        subdirs_ = newSubdirs;
+        watchDirectories();
+    }
+    for( QSet<QString>::const_iterator it = changes.constBegin(); it != changes.constEnd(); ++it ) {
+        if( *it != MULTI_TOUCH_DIR && subdirs_.contains( *it ) && !toScan.contains( *it ) ) {
+            toScan << *it;
+        }
+    }
+    if( toScan.isEmpty() ) {
+        if( catalogChanged_ ) {
+            saveCatalogIfChanged();
+        }
+        return;
+    }
+    if( !catalog_->isLoaded() ) {
+        catalog_->load();
+    }
+    updating_ = true;
+    updateSubdirs_ = toScan;
+    updateWatcher_->setFuture( QtConcurrent::mapped( toScan, SubdirScanner( catalog_ ) ) );
+}
+
+void DirectoryReader::onUpdateFinished()
+{
+    QList<ScanResult> results = updateWatcher_->future().results();
+
+    for( int i = 0; i < results.size() && i < updateSubdirs_.size(); ++i ) {
+        applyUpdateResult( updateSubdirs_.at( i ), results.at( i ) );
+    }
+    updateSubdirs_.clear();
+    updating_ = false;
+    saveCatalogIfChanged();
+    startPendingWork();
+}
+
+void DirectoryReader::applyUpdateResult( const QString & fullSubdirName, 
+                                         const ScanResult & result )
+{
+    int index = appDirs_.indexOf( fullSubdirName );
+
+    if( result.appInfo == NULL ) {
+        removeApp( fullSubdirName );
+    }
+    else if( index >= 0 && result.fromCatalog ) {
+        delete result.appInfo; // Nothing that matters to the app has changed.
+    }
+    else {
+        catalogEntries_.insert( fullSubdirName, result.catalogEntry );
+        catalogChanged_ = catalogChanged_ || !result.fromCatalog;
+
+        if( index >= 0 ) {
+            emit appInfoReplaced( index, result.appInfo );
+        }
+        else {
+            index = insertionIndex( fullSubdirName );
+            appDirs_.insert( index, fullSubdirName );
+            addDrivenameToList( fullSubdirName );
+            emit appInfoInserted( index, result.appInfo );
+        }
+    }
+}
+
+void DirectoryReader::removeApp( const QString & fullSubdirName )
+{
+    int index = appDirs_.indexOf( fullSubdirName );
+
+    if( index >= 0 ) {
+        appDirs_.removeAt( index );
+        catalogEntries_.remove( fullSubdirName );
+        catalogChanged_ = true;
+        rebuildListOfDriveNames();
+        emit appInfoRemoved( index );
+    }
+}
+
+/***************************************************************************//**
+The apps are kept in the same order as their subdirectories, so a new app 
+goes in front of the first app whose subdirectory comes after its own.
+*******************************************************************************/
+int DirectoryReader::insertionIndex( const QString & fullSubdirName )
+{
+    int position = subdirs_.indexOf( fullSubdirName );
+
+    for( int i = 0; i < appDirs_.size(); ++i ) {
+        if( subdirs_.indexOf( appDirs_.at( i ) ) > position ) {
+            return i;
+        }
+    }
+    return appDirs_.size();
 }
 
-void DirectoryReader::readMultitouchAppsInfo( const QString & multitouchDirName,
-                                              app::AppInfoList * appInfoList )
+void DirectoryReader::deleteUndeliveredResults()
+{
+    if( !resultReady_.empty() ) { // A read was still being scanned.
+        QList<ScanResult> results = scanWatcher_->future().results();
+
+        for( int i = nextResultToDeliver_; i < results.size(); ++i ) {
+            delete results.at( i ).appInfo;
+        }
+    }
+    if( updating_ ) {
+        QList<ScanResult> updateResults = updateWatcher_->future().results();
+
+        for( int i = 0; i < updateResults.size(); ++i ) {
+            delete updateResults.at( i ).appInfo;
+        }
+        updating_ = false;
+    }
+    resultReady_.clear();
+    nextResultToDeliver_ = 0;
+}
+
+/***************************************************************************//**
+Lists the app subdirectories of the MultitouchApps directory, followed by
+those of the MultitouchAppsUsbDrive directory on any drive.  Runs on a
+worker thread, since searching the drives can block for a while.
+*******************************************************************************/
+QStringList DirectoryReader::listMultitouchAppsSubdirs()
+{
+    QStringList subdirs;
+    appendSubdirs( MULTI_TOUCH_DIR, subdirs );
+    appendSubdirsOnUsbDrives( subdirs );
+    return subdirs;
+}
+
+void DirectoryReader::appendSubdirs( const QString & multitouchDirName, QStringList & subdirs )
 {
     QDir::Filters filters = QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks;
     QDir multitouchDir( multitouchDirName );
@@ -147,30 +548,51 @@ void DirectoryReader::readMultitouchAppsInfo( const QString & multitouchDirName,
         QFileInfo fileInfo = dirInfoList.at( i );
         QString fullSubdirName = multitouchDirName + "/" + fileInfo.fileName();
         //std::cout << "pathToSubdir = " << fullSubdirName.toStdString() << "\n";
-        readDir( fullSubdirName, appInfoList );
+        subdirs << fullSubdirName;
     }
 }
 
-void DirectoryReader::readDir( const QString & fullSubdirName, 
-                               app::AppInfoList * appInfoList )
+/***************************************************************************//**
+Finds the app and icon files in one app subdirectory, unless the 
+subdirectory is unchanged since it was saved in the catalog.  
+Runs on the QtConcurrent thread pool, so it only touches its own arguments
+(the catalog is only read) and returns any errors with the result instead 
+of storing them.
+*******************************************************************************/
+DirectoryReader::ScanResult DirectoryReader::scanSubdir( const QString & fullSubdirName,
+                                                         const io::AppCatalog * catalog )
 {
+    ScanResult result;
+
+    if( catalog != NULL && catalog->find( fullSubdirName, result.catalogEntry ) ) {
+        result.appInfo = createAppInfo( result.catalogEntry );
+        result.fromCatalog = true;
+        return result;
+    }
     QString appFilename = multitouchAppFilename( fullSubdirName );
 
     if( appFilename.size() > 0 ) {
         QString iconFilename = iconImageFilename( fullSubdirName );
 
         if( iconFilename.size() > 0 ) {
-            createAppInfo( appFilename, iconFilename, fullSubdirName, appInfoList );
+            try {
+                result.appInfo = createAppInfo( appFilename, iconFilename, 
+                                                fullSubdirName, result.catalogEntry );
+            }
+            catch( IOException e ) {
+                result.errors.push_back( e );
+            }
         }
         else { 
-            QString errorSrc = "DirectoryReader::readDir";
+            QString errorSrc = "DirectoryReader::scanSubdir";
             QString msg = "An image file ending with '-playsurface-icon.png' was\n";
             msg += "not found for '" + appFilename + "'\n";
             msg += "in the directory '" + fullSubdirName + "'.\n";
             FileNotFoundException e( msg, errorSrc, "*-playsurface-icon.png" );
-            errors_.push_back( e );
+            result.errors.push_back( e );
         }
     }
+    return result;
 }
 
 QString DirectoryReader::multitouchAppFilename( const QString & fullSubdirName )
@@ -202,20 +624,32 @@ QString DirectoryReader::iconImageFilename( const QString & fullSubdirName )
     return filename( fullSubdirName, nameFilters );
 }
 
-void DirectoryReader::createAppInfo( const QString & appFilename, 
-                                     const QString & iconFilename, 
-                                     const QString & fullSubdirName,
-                                     app::AppInfoList * appInfoList )
+/***************************************************************************//**
+Checks the app and icon files and fills in the catalog entry for the 
+subdirectory.  The signature is read before the files are checked, so a 
+file changed in the meantime gets a signature that no longer matches on 
+the next scan.
+*******************************************************************************/
+app::AppInfo * DirectoryReader::createAppInfo( const QString & appFilename, 
+                                               const QString & iconFilename, 
+                                               const QString & fullSubdirName,
+                                               io::AppCatalog::Entry & catalogEntry )
 {
-    try {
-        QImage iconImage = loadImage( iconFilename, fullSubdirName );
-        checkThatFileExists( appFilename, fullSubdirName );
-        appInfoList->add( new app::AppInfo( appFilename, fullSubdirName, iconImage ) );
-        addDrivenameToList( fullSubdirName );
-    }
-    catch( IOException e ) {
-        errors_.push_back( e );
-    }
+    io::AppCatalog::Signature signature =
+        io::AppCatalog::Signature::read( fullSubdirName, appFilename, iconFilename );
+    checkThatImageIsReadable( iconFilename, fullSubdirName );
+    checkThatFileExists( appFilename, fullSubdirName );
+    catalogEntry.directory = fullSubdirName;
+    catalogEntry.appFilename = appFilename;
+    catalogEntry.iconFilename = iconFilename;
+    catalogEntry.signature = signature;
+    return createAppInfo( catalogEntry );
+}
+
+app::AppInfo * DirectoryReader::createAppInfo( const io::AppCatalog::Entry & catalogEntry )
+{
+    QString iconPath = catalogEntry.directory + "/" + catalogEntry.iconFilename;
+    return new app::AppInfo( catalogEntry.appFilename, catalogEntry.directory, iconPath );
 }
 
 void DirectoryReader::addDrivenameToList( const QString & fullSubDirname )
@@ -235,7 +669,20 @@ void DirectoryReader::clearListOfDriveNames()
     drivesInUse_.clear();
 }
 
-void DirectoryReader::readMultitouchAppsOnUsbDrive( app::AppInfoList * appInfoList )
+/***************************************************************************//**
+Called when an app is removed, since it may have been the last app on its
+drive.
+*******************************************************************************/
+void DirectoryReader::rebuildListOfDriveNames()
+{
+    clearListOfDriveNames();
+
+    for( int i = 0; i < appDirs_.size(); ++i ) {
+        addDrivenameToList( appDirs_.at( i ) );
+    }
+}
+
+void DirectoryReader::appendSubdirsOnUsbDrives( QStringList & subdirs )
 {
     QFileInfoList driveList = QDir::drives();
 
@@ -246,7 +693,7 @@ void DirectoryReader::readMultitouchAppsOnUsbDrive( app::AppInfoList * appInfoLi
         
         if( multitouchDirName.size() > 0 ) {
             //std::cout << "multitouchDirName: " << multitouchDirName.toStdString() << "\n";
-            readMultitouchAppsInfo( multitouchDirName, appInfoList );
+            appendSubdirs( multitouchDirName, subdirs );
         }
     }
 }
@@ -37,24 +37,70 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #ifndef IO_DIRECTORYREADER_H
 #define IO_DIRECTORYREADER_H
 
+#include "io/AppCatalog.h"
 #include "exceptions/IOException.h"
 #include <QObject>
-#include <QImage>
 #include <QString>
+#include <QStringList>
 #include <QSet>
+#include <QMap>
+#include <QFutureWatcher>
 #include <vector>
 
 namespace app { class AppInfo; }
 namespace app { class AppInfoList; }
 class QDir;
+class QFileSystemWatcher;
+class QTimer;
 
 namespace io
 {
+    /***********************************************************************//**
+    Reads the info (executable and icon) for the BigBlobby, TouchHooks2Tuio,
+    and Flash Player apps, and for every multitouch app in the MultitouchApps
+    directory and on any USB drive with a MultitouchAppsUsbDrive directory.
+
+    The multitouch apps are read in the background so that the GUI keeps
+    running while slow (e.g., USB) drives are searched.  The icon images 
+    are not decoded here at all; the PaintWidget decodes each one when it is
+    first shown.  The list of app subdirectories is made on one worker 
+    thread, and then the subdirectories are scanned in parallel on the 
+    QtConcurrent thread pool.  Each AppInfo is handed to the GUI thread 
+    with the appInfoRead() signal as soon as it and all of the 
+    subdirectories before it have been scanned, so the apps always arrive 
+    in the same order.
+
+    The apps found are saved in an AppCatalog, and a subdirectory whose 
+    signature has not changed since the last scan is taken from the catalog 
+    instead of being searched again.
+
+    After the first read, the MultitouchApps directory and its app 
+    subdirectories are watched for changes.  When apps are added, changed, 
+    or removed, only the affected subdirectories are scanned, and the 
+    changes are reported one app at a time with the appInfoInserted(), 
+    appInfoReplaced(), and appInfoRemoved() signals.  USB drives are not 
+    watched (a watched directory cannot be safely ejected on Windows); they
+    are read again when a drive arrives or is removed.
+    ***************************************************************************/
     class DirectoryReader : public QObject
     {
         Q_OBJECT
 
     public:
+        /*******************************************************************//**
+        The result of scanning one app subdirectory on a worker thread.
+        ***********************************************************************/
+        class ScanResult
+        {
+        public:
+            ScanResult();
+
+            app::AppInfo * appInfo;
+            io::AppCatalog::Entry catalogEntry;
+            bool fromCatalog;
+            std::vector<exceptions::IOException> errors;
+        };
+
         static const QString BIG_BLOBBY_DIR,
                              BIG_BLOBBY_EXECUTABLE,
                              BIG_BLOBBY_IMAGE_FILE,
@@ -67,6 +113,10 @@ namespace io
                              MULTI_TOUCH_DIR,
                              USB_DRIVE_MULTI_TOUCH_DIR,
                              DRIVE_SYMBOL;
+        static const int WATCH_DELAY_MILLISECONDS;
+
+        static QStringList listMultitouchAppsSubdirs();
+        static ScanResult scanSubdir( const QString & fullSubdirName, const io::AppCatalog * catalog );
 
         DirectoryReader();
         virtual ~DirectoryReader();
@@ -74,7 +124,8 @@ namespace io
         app::AppInfo * readBigBlobbyInfo();
         app::AppInfo * readTouchHooks2TuioInfo();
         app::AppInfo * readFlashPlayerInfo();
-        void readMultitouchAppsInfo( app::AppInfoList * appInfoList );
+        void startReadingMultitouchAppsInfo();
+        bool isReadingMultitouchAppsInfo();
         bool hasAppInfoErrors();
         std::vector<exceptions::IOException> appInfoErrors();
         bool hasMultitouchAppsUsbDriveDir( char driveLetter );
@@ -83,26 +134,84 @@ namespace io
     public slots:
 
     signals:
+        void multitouchAppsReadStarted();
+        void appInfoRead( app::AppInfo * appInfo );
+        void multitouchAppsReadFinished();
+        void appInfoInserted( int index, app::AppInfo * appInfo );
+        void appInfoReplaced( int index, app::AppInfo * appInfo );
+        void appInfoRemoved( int index );
+
+    private slots:
+        void onSubdirsListed();
+        void onScanResultReady( int index );
+        void onScanFinished();
+        void onDirectoryChanged( const QString & path );
+        void applyPendingChanges();
+        void onUpdateFinished();
 
     private:
-        void checkThatFileExists( const QString & filename, const QString & fullSubdirName );
-        QImage loadImage( const QString & filename, const QString & fullSubdirName );
-        void readMultitouchAppsInfo( const QString & multitouchDirName, app::AppInfoList * appInfoList );
-        void readDir( const QString & fullSubdirName, app::AppInfoList * appInfoList );
-        QString multitouchAppFilename( const QString & fullSubdirName );
-        QString filename( const QString & fullSubdirName, const QStringList & nameFilters );
-        QString iconImageFilename( const QString & fullSubdirName );
-        void createAppInfo( const QString & appFilename, 
-                            const QString & iconFilename, 
-                            const QString & fullSubdirName,
-                            app::AppInfoList * appInfoList );
+        /*******************************************************************//**
+        Calls scanSubdir() with the catalog, for QtConcurrent::mapped().
+        ***********************************************************************/
+        class SubdirScanner
+        {
+        public:
+            typedef ScanResult result_type;
+
+            SubdirScanner( const io::AppCatalog * catalog );
+            ScanResult operator()( const QString & fullSubdirName ) const;
+
+        private:
+            const io::AppCatalog * catalog_;
+        };
+
+        static void checkThatFileExists( const QString & filename, const QString & fullSubdirName );
+        static void checkThatImageIsReadable( const QString & filename, const QString & fullSubdirName );
+        static void appendSubdirs( const QString & multitouchDirName, QStringList & subdirs );
+        static void appendSubdirsOnUsbDrives( QStringList & subdirs );
+        static QString multitouchAppFilename( const QString & fullSubdirName );
+        static QString filename( const QString & fullSubdirName, const QStringList & nameFilters );
+        static QString iconImageFilename( const QString & fullSubdirName );
+        static app::AppInfo * createAppInfo( const QString & appFilename, 
+                                             const QString & iconFilename, 
+                                             const QString & fullSubdirName,
+                                             io::AppCatalog::Entry & catalogEntry );
+        static app::AppInfo * createAppInfo( const io::AppCatalog::Entry & catalogEntry );
+        static QString multitouchDirectory( const QDir & dir );
+        void deliverReadyResults();
+        void deliver( const ScanResult & result );
+        void deleteUndeliveredResults();
+        void saveCatalogIfChanged();
+        void watchDirectories();
+        bool isWatchedSubdir( const QString & fullSubdirName );
+        void applyUpdateResult( const QString & fullSubdirName, const ScanResult & result );
+        void removeApp( const QString & fullSubdirName );
+        int insertionIndex( const QString & fullSubdirName );
+        void startPendingWork();
         void addDrivenameToList( const QString & fullSubDirname );
         void clearListOfDriveNames();
-        void readMultitouchAppsOnUsbDrive( app::AppInfoList * appInfoList );
-        QString multitouchDirectory( const QDir & dir );
+        void rebuildListOfDriveNames();
 
         std::vector<exceptions::IOException> errors_;
         QSet<QString> drivesInUse_;
+        io::AppCatalog * catalog_;
+        QMap<QString, io::AppCatalog::Entry> catalogEntries_;
+        bool catalogChanged_;
+        QStringList subdirs_,
+                    appDirs_,
+                    updateSubdirs_;
+        QSet<QString> pendingChanges_;
+        QFileSystemWatcher * fileWatcher_;
+        QTimer * changeTimer_;
+        QFutureWatcher<ScanResult> * updateWatcher_;
+        QFutureWatcher<QStringList> * listWatcher_;
+        QFutureWatcher<ScanResult> * scanWatcher_;
+        std::vector<bool> resultReady_;
+        int nextResultToDeliver_;
+        long long readStartedMicroseconds_;
+        bool reading_,
+             updating_,
+             rescanRequested_;
     };
 }
 
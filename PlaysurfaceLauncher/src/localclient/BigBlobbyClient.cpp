@@ -211,10 +211,14 @@ void BigBlobbyClient::sessionOpened()
 
 void BigBlobbyClient::logWarning( const QString & message )
 {
-    log_.writeWarning( "BigBlobbyClient Warning: " + message.toStdString() );
+    if( log_.isEnabled( logger::Log::WARNING_LEVEL ) ) {
+        log_.writeWarning( "BigBlobbyClient Warning: " + message.toStdString() );
+    }
 }
 
 void BigBlobbyClient::logInfo( const QString & message )
 {
-    log_.writeInfo( "BigBlobbyClient Info: " + message.toStdString() );
+    if( log_.isEnabled( logger::Log::INFO_LEVEL ) ) {
+        log_.writeInfo( "BigBlobbyClient Info: " + message.toStdString() );
+    }
 }
@@ -177,10 +177,14 @@ void TouchHooksClient::displayError( QLocalSocket::LocalSocketError socketError
 
 void TouchHooksClient::logWarning( const QString & message )
 {
-    log_.writeWarning( "TouchHooksClient Warning: " + message.toStdString() );
+    if( log_.isEnabled( logger::Log::WARNING_LEVEL ) ) {
+        log_.writeWarning( "TouchHooksClient Warning: " + message.toStdString() );
+    }
 }
 
 void TouchHooksClient::logInfo( const QString & message )
 {
-    log_.writeInfo( "TouchHooksClient Info: " + message.toStdString() );
+    if( log_.isEnabled( logger::Log::INFO_LEVEL ) ) {
+        log_.writeInfo( "TouchHooksClient Info: " + message.toStdString() );
+    }
 }
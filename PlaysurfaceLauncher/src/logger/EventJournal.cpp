@@ -0,0 +1,291 @@
+/*******************************************************************************
+EventJournal
+
+PURPOSE: A compact binary journal of touch frames, gestures, app launches and
+         exits, TUIO generator restarts, and drive events, written to a
+         memory-mapped ring file.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "logger/EventJournal.h"
+#include "logger/FileLogger.h"
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <chrono>
+#include <fstream>
+#include <cstring>
+
+using logger::EventJournal;
+
+const std::string EventJournal::JOURNAL_FILE( "Data/Log/PlaysurfaceLauncher-Journal.bin" );
+const char * const EventJournal::MAGIC = "PSJRNL1";
+
+const int EventJournal::VERSION = 2,
+          EventJournal::CAPACITY = 1024 * 1024,
+          EventJournal::MAX_NAMES = 256;
+
+/***************************************************************************//**
+The Singleton Design Pattern is used here so that the file is only mapped
+once.  The first call should be made on the GUI thread, before the TUIO
+thread starts.
+*******************************************************************************/
+EventJournal & EventJournal::instance()
+{
+    static EventJournal instance;
+    return instance;
+}
+
+const char * EventJournal::eventName( int type )
+{
+    switch( type ) {
+        case JOURNAL_OPENED:      return "JOURNAL_OPENED";
+        case TOUCH_FRAME:         return "TOUCH_FRAME";
+        case GESTURE:             return "GESTURE";
+        case APP_LAUNCHED:        return "APP_LAUNCHED";
+        case APP_EXITED:          return "APP_EXITED";
+        case APP_CRASHED:         return "APP_CRASHED";
+        case TRACKER_STARTED:     return "TRACKER_STARTED";
+        case TRACKER_LOST:        return "TRACKER_LOST";
+        case TRACKER_RESTARTING:  return "TRACKER_RESTARTING";
+        case TRACKER_RESTORED:    return "TRACKER_RESTORED";
+        case TRACKER_GAVE_UP:     return "TRACKER_GAVE_UP";
+        case DEVICE_ARRIVED:      return "DEVICE_ARRIVED";
+        case DEVICE_REMOVED:      return "DEVICE_REMOVED";
+        default:                  return "UNKNOWN";
+    }
+}
+
+bool EventJournal::hasName( int type )
+{
+    return (type >= APP_LAUNCHED && type <= TRACKER_GAVE_UP);
+}
+
+/***************************************************************************//**
+If the file cannot be mapped, a warning is logged and the journal stays
+closed (recording then does nothing).
+*******************************************************************************/
+EventJournal::EventJournal() :
+  mapping_( NULL ),
+  region_( NULL ),
+  header_( NULL ),
+  names_( NULL ),
+  records_( NULL ),
+  nameMutex_(),
+  nameIndexes_()
+{
+    nextSequence_.store( 1 );
+    open();
+}
+
+EventJournal::~EventJournal()
+{
+    if( region_ != NULL ) {
+        region_->flush();
+    }
+    delete region_;
+    delete mapping_;
+}
+
+bool EventJournal::isOpen()
+{
+    return (records_ != NULL);
+}
+
+void EventJournal::record( EventType type, int value0, int value1, int value2, int value3 )
+{
+    int values[4] = { value0, value1, value2, value3 };
+    write( type, values );
+}
+
+/***************************************************************************//**
+The text is stored in the name table (the first time it is seen), and the 
+record keeps its index.  Names longer than NAME_LENGTH - 1 are cut short.
+*******************************************************************************/
+void EventJournal::recordText( EventType type, int value, const std::string & text )
+{
+    if( records_ == NULL ) {
+        return;
+    }
+    int values[4] = { value, nameIndex( text ), 0, 0 };
+    write( type, values );
+}
+
+/***************************************************************************//**
+Text events are rare (launches, exits, and TUIO generator restarts), so the
+name table is guarded by a mutex.  The name is written before the header's
+nameCount is raised, so a name that was only half written reads as absent.
+*******************************************************************************/
+int EventJournal::nameIndex( const std::string & name )
+{
+    std::string key = name.substr( 0, NAME_LENGTH - 1 );
+    std::lock_guard<std::mutex> lock( nameMutex_ );
+    std::map<std::string, int>::const_iterator it = nameIndexes_.find( key );
+
+    if( it != nameIndexes_.end() ) {
+        return it->second;
+    }
+    int index = (int)header_->nameCount;
+
+    if( index >= MAX_NAMES ) {
+        return -1;
+    }
+    memset( names_[index].text, 0, NAME_LENGTH );
+    memcpy( names_[index].text, key.data(), key.size() );
+    std::atomic_thread_fence( std::memory_order_release );
+    header_->nameCount = index + 1;
+    nameIndexes_[key] = index;
+    return index;
+}
+
+/***************************************************************************//**
+May be called from any thread.  Each caller claims its own slot with one
+atomic increment, so writers never wait for each other.
+*******************************************************************************/
+void EventJournal::write( EventType type, const int * values )
+{
+    if( records_ == NULL ) {
+        return;
+    }
+    unsigned int sequence = nextSequence_.fetch_add( 1 );
+
+    if( sequence == 0 ) { // 0 marks an empty record, so skip it when wrapping.
+        sequence = nextSequence_.fetch_add( 1 );
+    }
+    Record * record = &records_[(sequence - 1) % CAPACITY];
+    record->sequence = 0;
+    std::atomic_thread_fence( std::memory_order_release );
+
+    record->timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch() ).count();
+    record->type = (unsigned short)type;
+    record->reserved = 0;
+    memcpy( record->values, values, sizeof( record->values ) );
+
+    std::atomic_thread_fence( std::memory_order_release );
+    record->sequence = sequence;
+    header_->lastSequence = sequence;
+}
+
+void EventJournal::open()
+{
+    boost::system::error_code error;
+    boost::filesystem::create_directories( boost::filesystem::path( JOURNAL_FILE ).parent_path(), error );
+
+    try {
+        if( !hasValidFile() ) {
+            createFile();
+        }
+        mapping_ = new boost::interprocess::file_mapping( JOURNAL_FILE.c_str(), 
+                                                          boost::interprocess::read_write );
+        region_ = new boost::interprocess::mapped_region( *mapping_, boost::interprocess::read_write );
+        header_ = (FileHeader *)region_->get_address();
+        names_ = (Name *)((char *)header_ + sizeof( FileHeader ));
+        records_ = (Record *)((char *)names_ + MAX_NAMES * sizeof( Name ));
+    }
+    catch( std::exception & e ) {
+        FileLogger::instance().writeWarning( "EventJournal: could not open " + JOURNAL_FILE 
+                                             + " (" + e.what() + ")" );
+        delete region_;
+        delete mapping_;
+        region_ = NULL;
+        mapping_ = NULL;
+        header_ = NULL;
+        names_ = NULL;
+        records_ = NULL;
+        return;
+    }
+    readNames();
+    nextSequence_.store( findLastSequence() + 1 );
+    record( JOURNAL_OPENED, VERSION );
+}
+
+bool EventJournal::hasValidFile()
+{
+    std::ifstream file( JOURNAL_FILE.c_str(), std::ios::in | std::ios::binary );
+    FileHeader header;
+
+    if( !file.read( (char *)&header, sizeof( header ) ) ) {
+        return false;
+    }
+    boost::system::error_code error;
+    unsigned long long expectedSize = sizeof( FileHeader ) + MAX_NAMES * sizeof( Name ) 
+                                      + (unsigned long long)CAPACITY * sizeof( Record );
+
+    return (strncmp( header.magic, MAGIC, sizeof( header.magic ) ) == 0
+            && header.version == (unsigned int)VERSION
+            && header.recordSize == sizeof( Record )
+            && header.capacity == (unsigned int)CAPACITY
+            && header.nameCount <= (unsigned int)MAX_NAMES
+            && boost::filesystem::file_size( JOURNAL_FILE, error ) == expectedSize);
+}
+
+/***************************************************************************//**
+Writes the header and sizes the file for the name table and CAPACITY 
+records.  The names and records are all zeros, which reads as empty.
+*******************************************************************************/
+void EventJournal::createFile()
+{
+    std::ofstream file( JOURNAL_FILE.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    FileHeader header;
+    memset( &header, 0, sizeof( header ) );
+    memcpy( header.magic, MAGIC, sizeof( header.magic ) );
+    header.version = VERSION;
+    header.recordSize = sizeof( Record );
+    header.capacity = CAPACITY;
+
+    file.write( (const char *)&header, sizeof( header ) );
+    file.seekp( (std::streamoff)(MAX_NAMES * sizeof( Name ) + sizeof( Record ) * CAPACITY) - 1, 
+                std::ios::cur );
+    file.put( 0 );
+}
+
+/***************************************************************************//**
+Finds where the last run stopped.  The header's lastSequence is stored after
+each record, but two threads writing at once may store theirs out of order, 
+so the records that follow it are checked too (usually none or one).
+*******************************************************************************/
+unsigned int EventJournal::findLastSequence()
+{
+    unsigned int last = header_->lastSequence;
+
+    for( int i = 0; i < CAPACITY && records_[last % CAPACITY].sequence == last + 1; ++i ) {
+        ++last;
+    }
+    return last;
+}
+
+void EventJournal::readNames()
+{
+    std::lock_guard<std::mutex> lock( nameMutex_ );
+    nameIndexes_.clear();
+
+    for( int i = 0; i < (int)header_->nameCount; ++i ) {
+        const char * text = names_[i].text;
+        nameIndexes_[std::string( text, strnlen( text, NAME_LENGTH ) )] = i;
+    }
+}
@@ -0,0 +1,180 @@
+/*******************************************************************************
+EventJournal
+
+PURPOSE: A compact binary journal of touch frames, gestures, app launches and
+         exits, TUIO generator restarts, and drive events, written to a
+         memory-mapped ring file.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef LOGGER_EVENTJOURNAL_H
+#define LOGGER_EVENTJOURNAL_H
+
+#include <atomic>
+#include <mutex>
+#include <map>
+#include <string>
+
+namespace boost { namespace interprocess { class file_mapping; class mapped_region; } }
+
+namespace logger
+{
+    /***********************************************************************//**
+    A binary journal of what happened on the table (touch frames, gestures,
+    app launches and exits, TUIO generator restarts, and drives coming and
+    going), for working out afterwards what led up to a problem.
+
+    Every event is one fixed-size Record in a memory-mapped file that is
+    used as a ring: when the file is full, the oldest records are written
+    over.  Writing a record is a few stores into the mapping, with no system
+    call, and the operating system writes the pages to disk even if the
+    launcher crashes.  A record's sequence number is stored last, so a record
+    that was only half written when the launcher died still reads as empty.
+    The newest sequence number is also kept in the file header, so opening
+    the journal does not have to search the records for where it left off.
+
+    Names (of apps and TUIO generators) are kept in a table of up to 
+    MAX_NAMES entries between the header and the records.  Each name is 
+    written there once, and an event that carries a name (hasName()) only 
+    stores the name's index in the table.  The table is not a ring, so a 
+    name outlives the records that were written over.
+
+    The journal is read with the -decodejournal command line option (see
+    JournalDecoder).
+    ***************************************************************************/
+    class EventJournal
+    {
+    private:
+        EventJournal();
+
+    public:
+        static const int NAME_LENGTH = 256;
+
+        enum EventType
+        {
+            NO_EVENT,
+            JOURNAL_OPENED,
+            TOUCH_FRAME,
+            GESTURE,
+            APP_LAUNCHED,
+            APP_EXITED,
+            APP_CRASHED,
+            TRACKER_STARTED,
+            TRACKER_LOST,
+            TRACKER_RESTARTING,
+            TRACKER_RESTORED,
+            TRACKER_GAVE_UP,
+            DEVICE_ARRIVED,
+            DEVICE_REMOVED,
+            NUMBER_OF_EVENT_TYPES
+        };
+
+        enum Gesture
+        {
+            PLUS_SIGN_GESTURE,
+            HORIZONTAL_LINE_GESTURE,
+            VERTICAL_LINE_GESTURE
+        };
+
+        /*******************************************************************//**
+        One event (32 bytes).  Events that carry a name (hasName()) keep the
+        index of the name in values[1] (-1 if the name table was full).
+        ***********************************************************************/
+        class Record
+        {
+        public:
+            long long timestamp; // Milliseconds since the epoch.
+            unsigned int sequence; // 0 for an empty or half-written record.
+            unsigned short type,
+                           reserved;
+            int values[4];
+        };
+
+        /*******************************************************************//**
+        The start of the file, padded to the size of a Record.
+        ***********************************************************************/
+        class FileHeader
+        {
+        public:
+            char magic[8];
+            unsigned int version,
+                         recordSize,
+                         capacity,
+                         lastSequence,
+                         nameCount,
+                         reserved;
+        };
+
+        /*******************************************************************//**
+        One entry of the name table, null-terminated.
+        ***********************************************************************/
+        class Name
+        {
+        public:
+            char text[NAME_LENGTH];
+        };
+
+        static const std::string JOURNAL_FILE;
+        static const char * const MAGIC;
+        static const int VERSION,
+                         CAPACITY,
+                         MAX_NAMES;
+
+        static EventJournal & instance();
+        static const char * eventName( int type );
+        static bool hasName( int type );
+
+        virtual ~EventJournal();
+
+        bool isOpen();
+        void record( EventType type, int value0 = 0, int value1 = 0, int value2 = 0, int value3 = 0 );
+        void recordText( EventType type, int value, const std::string & text );
+
+    private:
+        EventJournal( const EventJournal & );
+        EventJournal & operator=( const EventJournal & );
+
+        void open();
+        bool hasValidFile();
+        void createFile();
+        unsigned int findLastSequence();
+        void readNames();
+        int nameIndex( const std::string & name );
+        void write( EventType type, const int * values );
+
+        boost::interprocess::file_mapping * mapping_;
+        boost::interprocess::mapped_region * region_;
+        FileHeader * header_;
+        Name * names_;
+        Record * records_;
+        std::atomic<unsigned int> nextSequence_;
+        std::mutex nameMutex_;
+        std::map<std::string, int> nameIndexes_; // Guarded by nameMutex_.
+    };
+}
+
+#endif
@@ -32,45 +32,68 @@ CREATED: 4/19/2015
  Boston, MA  02111-1307  USA
 */
 #include "logger/FileLogger.h"
-
-// Disable deprecation warning for _vsnwprintf in boost/log/snprintf.hpp.
-#pragma warning(push)
-#pragma warning(disable: 4996)
-#include <boost/log/core.hpp>
-#include <boost/log/trivial.hpp>
-#include <boost/log/expressions.hpp>
-#include <boost/log/sinks/text_file_backend.hpp>
-#include <boost/log/utility/setup/file.hpp>
-#include <boost/log/utility/setup/common_attributes.hpp>
-#include <boost/log/sources/severity_logger.hpp>
-#include <boost/log/sources/record_ostream.hpp>
-#pragma warning(pop)
+#include "logger/LogRing.h"
+#include <boost/filesystem.hpp>
+#include <cassert>
+#include <chrono>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
 
 using logger::FileLogger;
+using logger::LogRing;
 
-const std::string FileLogger::LOG_FILE_NAME( "Data/Log/PlaysurfaceLauncher-Log_%N.log" ),
-                  FileLogger::LOG_DIRECTORY( "Data/Log" ),
-                  FileLogger::MESSAGE_FORMAT( "[%TimeStamp%] %Message%" );
+const std::string FileLogger::LOG_DIRECTORY( "Data/Log" ),
+                  FileLogger::LOG_FILE_PREFIX( "PlaysurfaceLauncher-Log_" ),
+                  FileLogger::LOG_FILE_SUFFIX( ".log" );
 
 const int FileLogger::MAX_FILE_SIZE = 100 * 1024,
           FileLogger::MAX_DIRECTORY_SIZE = 2 * 1024 * 1024,
-          FileLogger::DEFAULT_SEVERITY_LEVEL = boost::log::trivial::warning;;
+          FileLogger::RING_CAPACITY = 1024,
+          FileLogger::FLUSH_MILLISECONDS = 250;
+
+const logger::Log::Severity FileLogger::DEFAULT_SEVERITY_LEVEL = logger::Log::INFO_LEVEL;
 
 /***************************************************************************//**
-The constructor initializes the Boost Log library.
+The constructor starts the writer thread.
 *******************************************************************************/
-FileLogger::FileLogger()
+FileLogger::FileLogger() :
+  ring_( new LogRing( RING_CAPACITY ) ),
+  wakeMutex_(),
+  wakeCondition_(),
+  wakeRequested_( false ),
+  writerThread_(),
+  file_(),
+  fileNumber_( 0 ),
+  fileSize_( 0 ),
+  batch_()
 {
+    minimumSeverity_.store( DEFAULT_SEVERITY_LEVEL );
+    stopping_.store( false );
     initialize();
 }
 
+/***************************************************************************//**
+The writer thread should have been stopped by shutdown() before main() 
+returned.  If it was not, it is detached rather than joined (see the class
+comment), and whatever is still in the ring is lost.
+*******************************************************************************/
 FileLogger::~FileLogger()
 {
+    assert( !writerThread_.joinable() );
+
+    if( writerThread_.joinable() ) {
+        writerThread_.detach();
+    }
+    else {
+        delete ring_;
+    }
 }
 
 /***************************************************************************//**
-The Singleton Design Pattern is used here so that the Boost Log library code 
-is only initialized once.
+The Singleton Design Pattern is used here so that there is only one writer
+thread and one open log file.
 *******************************************************************************/
 logger::Log & FileLogger::instance()
 {
@@ -78,70 +101,232 @@ logger::Log & FileLogger::instance()
     return instance;
 }
 
-void FileLogger::initialize()
+/***************************************************************************//**
+Stops the writer thread, after it has written out whatever is still in the 
+ring, and closes the log file.  Called from main() before it returns.
+*******************************************************************************/
+void FileLogger::shutdown()
 {
-    setFileInfo();
-    setFilter();
-    addCommonAttributes();
+    static_cast<FileLogger &>( instance() ).stopWriter();
 }
 
-void FileLogger::setFileInfo()
+void FileLogger::stopWriter()
 {
-    boost::log::add_file_log
-    (
-        boost::log::keywords::file_name = LOG_FILE_NAME,
-        boost::log::keywords::target = LOG_DIRECTORY,
-        boost::log::keywords::rotation_size = MAX_FILE_SIZE,
-        boost::log::keywords::max_size = MAX_DIRECTORY_SIZE,
-        boost::log::keywords::format = MESSAGE_FORMAT
-    );
+    stopping_.store( true );
+    wakeWriter();
+
+    if( writerThread_.joinable() ) {
+        writerThread_.join();
+    }
+    file_.close();
 }
 
-void FileLogger::setFilter()
+void FileLogger::initialize()
 {
-    boost::log::core::get()->set_filter
-    ( 
-        boost::log::trivial::severity >= DEFAULT_SEVERITY_LEVEL 
-    );
+    if( !writerThread_.joinable() && !stopping_.load() ) {
+        writerThread_ = std::thread( &FileLogger::runWriter, this );
+    }
 }
 
-void FileLogger::addCommonAttributes()
+bool FileLogger::isEnabled( Severity severity )
 {
-    boost::log::add_common_attributes();
+    return severity >= minimumSeverity_.load( std::memory_order_relaxed );
 }
 
 void FileLogger::writeTrace( const std::string & message )
 {
-    boost::log::sources::severity_logger< boost::log::trivial::severity_level > severityLogger;
-    BOOST_LOG_SEV( severityLogger, boost::log::trivial::trace ) << message;
+    write( TRACE_LEVEL, message );
 }
 
 void FileLogger::writeDebug( const std::string & message )
 {
-    boost::log::sources::severity_logger< boost::log::trivial::severity_level > severityLogger;
-    BOOST_LOG_SEV( severityLogger, boost::log::trivial::debug ) << message;
+    write( DEBUG_LEVEL, message );
 }
 
 void FileLogger::writeInfo( const std::string & message )
 {
-    boost::log::sources::severity_logger< boost::log::trivial::severity_level > severityLogger;
-    BOOST_LOG_SEV( severityLogger, boost::log::trivial::info ) << message;
+    write( INFO_LEVEL, message );
 }
 
 void FileLogger::writeWarning( const std::string & message )
 {
-    boost::log::sources::severity_logger< boost::log::trivial::severity_level > severityLogger;
-    BOOST_LOG_SEV( severityLogger, boost::log::trivial::warning ) << message;
+    write( WARNING_LEVEL, message );
 }
 
 void FileLogger::writeError( const std::string & message )
 {
-    boost::log::sources::severity_logger< boost::log::trivial::severity_level > severityLogger;
-    BOOST_LOG_SEV( severityLogger, boost::log::trivial::error ) << message;
+    write( ERROR_LEVEL, message );
 }
 
 void FileLogger::writeFatal( const std::string & message )
 {
-    boost::log::sources::severity_logger< boost::log::trivial::severity_level > severityLogger;
-    BOOST_LOG_SEV( severityLogger, boost::log::trivial::fatal ) << message;
+    write( FATAL_LEVEL, message );
+}
+
+/***************************************************************************//**
+Runs on the caller's thread, so it only filters, timestamps, and copies the
+message into the ring.  Errors wake the writer thread so that they reach the
+file even if the app is about to crash.
+*******************************************************************************/
+void FileLogger::write( Severity severity, const std::string & message )
+{
+    if( !isEnabled( severity ) ) {
+        return;
+    }
+    long long timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch() ).count();
+    ring_->push( severity, timestamp, message.data(), (int)message.size() );
+
+    if( severity >= ERROR_LEVEL ) {
+        wakeWriter();
+    }
+}
+
+/***************************************************************************//**
+The flag is set under the mutex, so a wake-up that comes while the writer 
+thread is busy writing is not lost: the writer sees the flag the next time 
+it waits and goes straight on to the next batch.
+*******************************************************************************/
+void FileLogger::wakeWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock( wakeMutex_ );
+        wakeRequested_ = true;
+    }
+    wakeCondition_.notify_one();
+}
+
+const char * FileLogger::severityName( int severity )
+{
+    switch( severity ) {
+        case TRACE_LEVEL:    return "trace";
+        case DEBUG_LEVEL:    return "debug";
+        case INFO_LEVEL:     return "info";
+        case WARNING_LEVEL:  return "warning";
+        case ERROR_LEVEL:    return "error";
+        case FATAL_LEVEL:    return "fatal";
+        default:             return "unknown";
+    }
+}
+
+void FileLogger::appendRecord( std::string & batch, long long timestamp,
+                               int severity, const char * text, int length )
+{
+    time_t seconds = (time_t)(timestamp / 1000);
+    tm localTime;
+    char dateTime[32],
+         prefix[64];
+
+    localtime_s( &localTime, &seconds );
+    strftime( dateTime, sizeof( dateTime ), "%Y-%m-%d %H:%M:%S", &localTime );
+    sprintf_s( prefix, sizeof( prefix ), "[%s.%03d] [%s] ",
+               dateTime, (int)(timestamp % 1000), severityName( severity ) );
+    batch.append( prefix );
+    batch.append( text, length );
+    batch.push_back( '\n' );
+}
+
+void FileLogger::runWriter()
+{
+    while( !stopping_.load() ) {
+        {
+            std::unique_lock<std::mutex> lock( wakeMutex_ );
+            wakeCondition_.wait_for( lock, std::chrono::milliseconds( FLUSH_MILLISECONDS ),
+                                     [this] { return wakeRequested_; } );
+            wakeRequested_ = false;
+        }
+        writeBatch();
+    }
+    writeBatch();
+}
+
+/***************************************************************************//**
+Runs on the writer thread.  Everything in the ring is formatted into one
+string and written with a single call.
+*******************************************************************************/
+void FileLogger::writeBatch()
+{
+    batch_.clear();
+    const LogRing::Record * record = NULL;
+
+    while( (record = ring_->front()) != NULL ) {
+        appendRecord( batch_, record->timestamp, record->severity, record->text, record->length );
+        ring_->pop();
+    }
+    unsigned int dropped = ring_->takeDroppedCount();
+
+    if( dropped > 0 ) {
+        long long now = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch() ).count();
+        std::string message = "FileLogger: the log buffer was full, "
+                              + std::to_string( (unsigned long long)dropped )
+                              + " messages were dropped.";
+        appendRecord( batch_, now, WARNING_LEVEL, message.data(), (int)message.size() );
+    }
+    if( batch_.empty() ) {
+        return;
+    }
+    if( !file_.is_open() ) {
+        openLogFile();
+    }
+    file_.write( batch_.data(), batch_.size() );
+    file_.flush();
+    fileSize_ += batch_.size();
+
+    if( fileSize_ >= MAX_FILE_SIZE ) {
+        openLogFile();
+    }
+}
+
+/***************************************************************************//**
+Closes the current log file (if any) and opens a new one, numbered one
+higher than any log file already in the directory.
+*******************************************************************************/
+void FileLogger::openLogFile()
+{
+    file_.close();
+    boost::system::error_code error;
+    boost::filesystem::create_directories( LOG_DIRECTORY, error );
+    removeOldLogFiles();
+
+    char fileName[256];
+    sprintf_s( fileName, sizeof( fileName ), "%s/%s%d%s", LOG_DIRECTORY.c_str(),
+               LOG_FILE_PREFIX.c_str(), fileNumber_, LOG_FILE_SUFFIX.c_str() );
+    file_.open( fileName, std::ios::out | std::ios::app );
+    fileSize_ = 0;
+}
+
+/***************************************************************************//**
+Finds the log files in LOG_DIRECTORY, sets fileNumber_ to the number the next
+file should have, and deletes the oldest files until the rest (plus room for
+the next file) fit in MAX_DIRECTORY_SIZE.
+*******************************************************************************/
+void FileLogger::removeOldLogFiles()
+{
+    std::map<int, boost::filesystem::path> logFiles;
+    boost::system::error_code error;
+    boost::filesystem::directory_iterator it( LOG_DIRECTORY, error ),
+                                          end;
+    for( ; !error && it != end; it.increment( error ) ) {
+        std::string name = it->path().filename().string();
+
+        if( name.size() > LOG_FILE_PREFIX.size() + LOG_FILE_SUFFIX.size()
+            && name.compare( 0, LOG_FILE_PREFIX.size(), LOG_FILE_PREFIX ) == 0
+            && name.compare( name.size() - LOG_FILE_SUFFIX.size(), LOG_FILE_SUFFIX.size(), LOG_FILE_SUFFIX ) == 0 )
+        {
+            int number = atoi( name.c_str() + LOG_FILE_PREFIX.size() );
+            logFiles[number] = it->path();
+        }
+    }
+    fileNumber_ = logFiles.empty() ? 0 : logFiles.rbegin()->first + 1;
+    long long directorySize = MAX_FILE_SIZE;
+    std::map<int, boost::filesystem::path>::iterator file;
+
+    for( file = logFiles.begin(); file != logFiles.end(); ++file ) {
+        directorySize += (long long)boost::filesystem::file_size( file->second, error );
+    }
+    for( file = logFiles.begin(); file != logFiles.end() && directorySize > MAX_DIRECTORY_SIZE; ++file ) {
+        directorySize -= (long long)boost::filesystem::file_size( file->second, error );
+        boost::filesystem::remove( file->second, error );
+    }
 }
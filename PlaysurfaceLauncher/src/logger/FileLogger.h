@@ -35,26 +35,55 @@ CREATED: 4/19/2015
 #define LOGGER_FILELOGGER_H
 
 #include "logger/Log.h"
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+
+namespace logger { class LogRing; }
 
 namespace logger 
 {
+    /***********************************************************************//**
+    Writes the log to numbered files in LOG_DIRECTORY without making the
+    caller wait for the disk.  A write call that passes the severity filter
+    copies its message into a LogRing and returns; a background thread
+    takes the messages off the ring every FLUSH_MILLISECONDS (or right away
+    for an error), formats them, and writes them to the file in one batch.
+    The background thread also starts a new file when the current one gets
+    bigger than MAX_FILE_SIZE, and deletes the oldest files when the
+    directory gets bigger than MAX_DIRECTORY_SIZE.
+
+    Callers that build a message should call isEnabled() first, so that a
+    filtered-out message costs nothing to format.
+
+    shutdown() must be called before main() returns.  The writer thread 
+    cannot be left for the static instance's destructor to join, since with
+    the Visual Studio 2013 runtime, joining a std::thread after main() has 
+    returned can deadlock.  Messages written after shutdown() are dropped.
+    ***************************************************************************/
     class FileLogger : public Log
     {
     private:
         FileLogger();
 
     public:
-        static const std::string LOG_FILE_NAME,
-                                 LOG_DIRECTORY,
-                                 MESSAGE_FORMAT;
+        static const std::string LOG_DIRECTORY,
+                                 LOG_FILE_PREFIX,
+                                 LOG_FILE_SUFFIX;
         static const int MAX_FILE_SIZE,
                          MAX_DIRECTORY_SIZE,
-                         DEFAULT_SEVERITY_LEVEL;
+                         RING_CAPACITY,
+                         FLUSH_MILLISECONDS;
+        static const Severity DEFAULT_SEVERITY_LEVEL;
 
         virtual ~FileLogger();
         static Log & instance();
+        static void shutdown();
 
         virtual void initialize();
+        virtual bool isEnabled( Severity severity );
         virtual void writeTrace( const std::string & message );
         virtual void writeDebug( const std::string & message );
         virtual void writeInfo( const std::string & message );
@@ -63,9 +92,30 @@ namespace logger
         virtual void writeFatal( const std::string & message );
 
     private:
-        void setFileInfo();
-        void setFilter();
-        void addCommonAttributes();
+        static const char * severityName( int severity );
+        static void appendRecord( std::string & batch, long long timestamp,
+                                  int severity, const char * text, int length );
+
+        void write( Severity severity, const std::string & message );
+        void wakeWriter();
+        void runWriter();
+        void stopWriter();
+        void writeBatch();
+        void openLogFile();
+        void removeOldLogFiles();
+
+        LogRing * ring_;
+        std::atomic<int> minimumSeverity_;
+        std::atomic<bool> stopping_;
+        std::mutex wakeMutex_;
+        std::condition_variable wakeCondition_;
+        bool wakeRequested_; // Guarded by wakeMutex_.
+        std::thread writerThread_;
+        // The members below are only used by the writer thread.
+        std::ofstream file_;
+        int fileNumber_;
+        long long fileSize_;
+        std::string batch_;
     };
 }
 
@@ -0,0 +1,249 @@
+/*******************************************************************************
+JournalDecoder
+
+PURPOSE: Turns an EventJournal file into text or CSV (PlaysurfaceLauncher.exe
+         -decodejournal).
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "logger/JournalDecoder.h"
+#include <fstream>
+#include <algorithm>
+#include <ctime>
+#include <cstdio>
+#include <cstring>
+
+using logger::JournalDecoder;
+using logger::EventJournal;
+
+const std::string JournalDecoder::COMMAND_LINE_ARG( "-decodejournal" ),
+                  JournalDecoder::CSV_ARG( "-csv" );
+
+static bool isOlder( const EventJournal::Record & a, const EventJournal::Record & b )
+{
+    return a.sequence < b.sequence;
+}
+
+bool JournalDecoder::isDecodeRequested( int argc, char * argv[] )
+{
+    return (argc > 1 && _stricmp( argv[1], COMMAND_LINE_ARG.c_str() ) == 0);
+}
+
+/***************************************************************************//**
+Command line usage:
+
+    PlaysurfaceLauncher.exe -decodejournal [journalFile] [-csv] > events.txt
+
+Returns 0 on success, or 1 if the file is not a journal.
+*******************************************************************************/
+int JournalDecoder::run( int argc, char * argv[], std::ostream & out )
+{
+    std::string fileName = EventJournal::JOURNAL_FILE;
+    bool csv = false;
+
+    for( int i = 2; i < argc; ++i ) {
+        if( _stricmp( argv[i], CSV_ARG.c_str() ) == 0 ) {
+            csv = true;
+        }
+        else {
+            fileName = argv[i];
+        }
+    }
+    JournalDecoder decoder;
+
+    if( !decoder.readJournalFile( fileName ) ) {
+        out << "JournalDecoder: " << fileName << " is not a readable event journal.\n";
+        return 1;
+    }
+    if( csv ) {
+        decoder.printCsv( out );
+    }
+    else {
+        decoder.printText( out );
+    }
+    return 0;
+}
+
+JournalDecoder::JournalDecoder() :
+  names_(),
+  records_()
+{
+}
+
+JournalDecoder::~JournalDecoder()
+{
+}
+
+/***************************************************************************//**
+Reads the name table, and keeps the records that were completely written, 
+sorted by sequence number.
+*******************************************************************************/
+bool JournalDecoder::readJournalFile( const std::string & fileName )
+{
+    std::ifstream file( fileName.c_str(), std::ios::in | std::ios::binary );
+    EventJournal::FileHeader header;
+    names_.clear();
+    records_.clear();
+
+    if( !file.read( (char *)&header, sizeof( header ) )
+        || memcmp( header.magic, EventJournal::MAGIC, sizeof( header.magic ) ) != 0
+        || header.version != (unsigned int)EventJournal::VERSION
+        || header.recordSize != sizeof( EventJournal::Record ) )
+    {
+        return false;
+    }
+    EventJournal::Name name;
+
+    for( int i = 0; i < EventJournal::MAX_NAMES && file.read( (char *)&name, sizeof( name ) ); ++i ) {
+        if( i < (int)header.nameCount ) {
+            names_.push_back( std::string( name.text, strnlen( name.text, EventJournal::NAME_LENGTH ) ) );
+        }
+    }
+    EventJournal::Record record;
+
+    for( unsigned int i = 0; i < header.capacity && file.read( (char *)&record, sizeof( record ) ); ++i ) {
+        if( record.sequence != 0 ) {
+            records_.push_back( record );
+        }
+    }
+    std::sort( records_.begin(), records_.end(), isOlder );
+    return true;
+}
+
+int JournalDecoder::numberOfRecords()
+{
+    return (int)records_.size();
+}
+
+void JournalDecoder::printText( std::ostream & out )
+{
+    for( size_t i = 0; i < records_.size(); ++i ) {
+        const EventJournal::Record & record = records_[i];
+        out << formatTime( record.timestamp ) << "  "
+            << EventJournal::eventName( record.type ) << "  "
+            << describe( record ) << "\n";
+    }
+}
+
+void JournalDecoder::printCsv( std::ostream & out )
+{
+    out << "sequence,timestamp_ms,time,event,value0,value1,value2,value3,text\n";
+
+    for( size_t i = 0; i < records_.size(); ++i ) {
+        const EventJournal::Record & record = records_[i];
+        out << record.sequence << "," << record.timestamp << ","
+            << formatTime( record.timestamp ) << ","
+            << EventJournal::eventName( record.type ) << ","
+            << record.values[0] << ",";
+
+        if( EventJournal::hasName( record.type ) ) {
+            std::string text = nameOf( record );
+            std::string::size_type quote = 0;
+
+            while( (quote = text.find( '"', quote )) != std::string::npos ) {
+                text.insert( quote, 1, '"' );
+                quote += 2;
+            }
+            out << ",,,\"" << text << "\"\n";
+        }
+        else {
+            out << record.values[1] << "," << record.values[2] << ","
+                << record.values[3] << ",\n";
+        }
+    }
+}
+
+std::string JournalDecoder::formatTime( long long timestamp )
+{
+    time_t seconds = (time_t)(timestamp / 1000);
+    tm localTime;
+    char dateTime[32],
+         text[48];
+
+    localtime_s( &localTime, &seconds );
+    strftime( dateTime, sizeof( dateTime ), "%Y-%m-%d %H:%M:%S", &localTime );
+    sprintf_s( text, sizeof( text ), "%s.%03d", dateTime, (int)(timestamp % 1000) );
+    return text;
+}
+
+std::string JournalDecoder::describe( const EventJournal::Record & record )
+{
+    const int * v = record.values;
+    std::string text = EventJournal::hasName( record.type ) ? nameOf( record ) : "";
+    char line[EventJournal::NAME_LENGTH + 64];
+    line[0] = '\0';
+
+    switch( record.type ) {
+        case EventJournal::JOURNAL_OPENED:
+            sprintf_s( line, sizeof( line ), "version %d", v[0] );
+            break;
+        case EventJournal::TOUCH_FRAME:
+            sprintf_s( line, sizeof( line ), "%d cursors, %d blobs, %d objects", v[0], v[1], v[2] );
+            break;
+        case EventJournal::GESTURE:
+            sprintf_s( line, sizeof( line ), "%s at (%d, %d)",
+                       (v[0] == EventJournal::PLUS_SIGN_GESTURE) ? "plus sign"
+                       : (v[0] == EventJournal::HORIZONTAL_LINE_GESTURE) ? "horizontal line"
+                       : "vertical line",
+                       v[1], v[2] );
+            break;
+        case EventJournal::APP_LAUNCHED:
+            sprintf_s( line, sizeof( line ), "%s (icon %d)", text.c_str(), v[0] );
+            break;
+        case EventJournal::APP_EXITED:
+        case EventJournal::APP_CRASHED:
+            sprintf_s( line, sizeof( line ), "%s, exit code %d", text.c_str(), v[0] );
+            break;
+        case EventJournal::TRACKER_STARTED:
+            sprintf_s( line, sizeof( line ), "%s", text.c_str() );
+            break;
+        case EventJournal::TRACKER_LOST:
+        case EventJournal::TRACKER_GAVE_UP:
+            sprintf_s( line, sizeof( line ), "%s after %d restarts", text.c_str(), v[0] );
+            break;
+        case EventJournal::TRACKER_RESTARTING:
+            sprintf_s( line, sizeof( line ), "%s, restart %d", text.c_str(), v[0] );
+            break;
+        case EventJournal::TRACKER_RESTORED:
+            sprintf_s( line, sizeof( line ), "%s after %.1f s without input", text.c_str(), v[0] / 1000.0 );
+            break;
+        case EventJournal::DEVICE_ARRIVED:
+        case EventJournal::DEVICE_REMOVED:
+            sprintf_s( line, sizeof( line ), "drive %c:", (char)v[0] );
+            break;
+        default:
+            sprintf_s( line, sizeof( line ), "%d %d %d %d", v[0], v[1], v[2], v[3] );
+            break;
+    }
+    return line;
+}
+
+std::string JournalDecoder::nameOf( const EventJournal::Record & record )
+{
+    int index = record.values[1];
+    return (index >= 0 && index < (int)names_.size()) ? names_[index] : "(unknown name)";
+}
@@ -0,0 +1,76 @@
+/*******************************************************************************
+JournalDecoder
+
+PURPOSE: Turns an EventJournal file into text or CSV (PlaysurfaceLauncher.exe
+         -decodejournal).
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef LOGGER_JOURNALDECODER_H
+#define LOGGER_JOURNALDECODER_H
+
+#include "logger/EventJournal.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace logger
+{
+    /***********************************************************************//**
+    Reads an EventJournal file and prints its records, oldest first, either
+    as text (one event per line) or as CSV for a spreadsheet.  The journal
+    does not have to be closed, so the file of a running (or crashed)
+    launcher can be decoded as it is.
+    ***************************************************************************/
+    class JournalDecoder
+    {
+    public:
+        static const std::string COMMAND_LINE_ARG,
+                                 CSV_ARG;
+
+        static bool isDecodeRequested( int argc, char * argv[] );
+        static int run( int argc, char * argv[], std::ostream & out );
+
+        JournalDecoder();
+        virtual ~JournalDecoder();
+
+        bool readJournalFile( const std::string & fileName );
+        int numberOfRecords();
+        void printText( std::ostream & out );
+        void printCsv( std::ostream & out );
+
+    private:
+        static std::string formatTime( long long timestamp );
+        std::string describe( const EventJournal::Record & record );
+        std::string nameOf( const EventJournal::Record & record );
+
+        std::vector<std::string> names_;
+        std::vector<EventJournal::Record> records_;
+    };
+}
+
+#endif
@@ -41,10 +41,22 @@ namespace logger
     class Log
     {
     public:
+        // The names have a suffix because windows.h defines ERROR.
+        enum Severity
+        {
+            TRACE_LEVEL,
+            DEBUG_LEVEL,
+            INFO_LEVEL,
+            WARNING_LEVEL,
+            ERROR_LEVEL,
+            FATAL_LEVEL
+        };
+
         Log() {};
         virtual ~Log() {};
 
         virtual void initialize() = 0;
+        virtual bool isEnabled( Severity severity ) = 0;
         virtual void writeTrace( const std::string & message ) = 0;
         virtual void writeDebug( const std::string & message ) = 0;
         virtual void writeInfo( const std::string & message ) = 0;
@@ -0,0 +1,132 @@
+/*******************************************************************************
+LogRing
+
+PURPOSE: A lock-free ring of preallocated log records, which the FileLogger's
+         writer thread drains.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "logger/LogRing.h"
+#include <cstring>
+
+using logger::LogRing;
+
+/***************************************************************************//**
+The capacity is rounded up to a power of two, so that a position can be
+turned into a slot index with a mask.
+*******************************************************************************/
+LogRing::LogRing( int capacity ) :
+  slots_( NULL ),
+  mask_( 0 ),
+  readPosition_( 0 )
+{
+    size_t size = 2;
+
+    while( size < (size_t)capacity ) {
+        size *= 2;
+    }
+    slots_ = new Slot[size];
+    mask_ = size - 1;
+
+    for( size_t i = 0; i < size; ++i ) {
+        slots_[i].sequence.store( i, std::memory_order_relaxed );
+    }
+    writePosition_.store( 0, std::memory_order_relaxed );
+    droppedCount_.store( 0, std::memory_order_relaxed );
+}
+
+LogRing::~LogRing()
+{
+    delete [] slots_;
+}
+
+/***************************************************************************//**
+May be called from any thread.  Returns false (and counts the message as
+dropped) if the ring is full.
+*******************************************************************************/
+bool LogRing::push( int severity, long long timestamp, const char * text, int length )
+{
+    size_t position = writePosition_.load( std::memory_order_relaxed );
+    Slot * slot = NULL;
+
+    while( true ) {
+        slot = &slots_[position & mask_];
+        size_t sequence = slot->sequence.load( std::memory_order_acquire );
+        ptrdiff_t difference = (ptrdiff_t)sequence - (ptrdiff_t)position;
+
+        if( difference == 0 ) {
+            if( writePosition_.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) ) {
+                break;
+            }
+        }
+        else if( difference < 0 ) {
+            droppedCount_.fetch_add( 1, std::memory_order_relaxed );
+            return false;
+        }
+        else {
+            position = writePosition_.load( std::memory_order_relaxed );
+        }
+    }
+    Record & record = slot->record;
+    record.timestamp = timestamp;
+    record.severity = severity;
+    record.length = (length < MAX_MESSAGE_LENGTH) ? length : (int)MAX_MESSAGE_LENGTH;
+    memcpy( record.text, text, record.length );
+    slot->sequence.store( position + 1, std::memory_order_release );
+    return true;
+}
+
+/***************************************************************************//**
+Consumer only.  Returns the oldest published record, or NULL if there is
+none.  The record stays valid until pop() is called.
+*******************************************************************************/
+const LogRing::Record * LogRing::front()
+{
+    Slot & slot = slots_[readPosition_ & mask_];
+    size_t sequence = slot.sequence.load( std::memory_order_acquire );
+
+    if( sequence != readPosition_ + 1 ) {
+        return NULL;
+    }
+    return &slot.record;
+}
+
+/***************************************************************************//**
+Consumer only.  Hands the slot of the record returned by front() back to the
+producers.
+*******************************************************************************/
+void LogRing::pop()
+{
+    Slot & slot = slots_[readPosition_ & mask_];
+    slot.sequence.store( readPosition_ + mask_ + 1, std::memory_order_release );
+    ++readPosition_;
+}
+
+unsigned int LogRing::takeDroppedCount()
+{
+    return droppedCount_.exchange( 0, std::memory_order_relaxed );
+}
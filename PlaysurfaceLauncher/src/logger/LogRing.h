@@ -0,0 +1,99 @@
+/*******************************************************************************
+LogRing
+
+PURPOSE: A lock-free ring of preallocated log records, which the FileLogger's
+         writer thread drains.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef LOGGER_LOGRING_H
+#define LOGGER_LOGRING_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace logger
+{
+    /***********************************************************************//**
+    A fixed-size ring of preallocated log records that any number of threads
+    can push to without locking, and that one thread (the FileLogger's writer
+    thread) takes records from.
+
+    Each slot has a sequence number that tells whose turn it is: a producer
+    claims a slot by moving the shared write position forward with a
+    compare-and-swap, copies its message into the slot, and then publishes
+    the slot by bumping its sequence number.  The consumer only reads a slot
+    after it is published, and hands it back to the producers the same way.
+    Nothing is allocated after construction.  If the ring is full, push()
+    drops the message (and counts it) rather than making the caller wait.
+    ***************************************************************************/
+    class LogRing
+    {
+    public:
+        static const int MAX_MESSAGE_LENGTH = 512;
+
+        /*******************************************************************//**
+        One log message.  A message longer than MAX_MESSAGE_LENGTH is cut
+        short.
+        ***********************************************************************/
+        class Record
+        {
+        public:
+            long long timestamp; // Milliseconds since the epoch.
+            int severity,
+                length;
+            char text[MAX_MESSAGE_LENGTH];
+        };
+
+        LogRing( int capacity );
+        virtual ~LogRing();
+
+        bool push( int severity, long long timestamp, const char * text, int length );
+        const Record * front();
+        void pop();
+        unsigned int takeDroppedCount();
+
+    private:
+        class Slot
+        {
+        public:
+            std::atomic<size_t> sequence;
+            Record record;
+        };
+
+        LogRing( const LogRing & );
+        LogRing & operator=( const LogRing & );
+
+        Slot * slots_;
+        size_t mask_;
+        std::atomic<size_t> writePosition_;
+        size_t readPosition_; // Only used by the consumer.
+        std::atomic<unsigned int> droppedCount_;
+    };
+}
+
+#endif
@@ -32,15 +32,54 @@ CREATED: 3/27/2014
  Boston, MA  02111-1307  USA
 */
 #include "playsurface/Playsurface.h"
+#include "gestures/GestureBenchmark.h"
+#include "gui/PaintBenchmark.h"
+#include "logger/JournalDecoder.h"
+#include "logger/EventJournal.h"
+#include "logger/FileLogger.h"
+#include "xml/SettingsXmlBenchmark.h"
 #include <QApplication>
 #include <iostream>
 
 // function prototypes
 bool showGesturesMenu( int, char * [] );
+static int runLauncher( QApplication & );
 
 int main( int argc, char * argv [] )
 {
     QApplication app( argc, argv );
+    // Start the log writer at a known point; it is stopped before main() 
+    // returns, since it cannot be joined during static destruction.
+    logger::FileLogger::instance();
+    int exitCode = 0;
+
+    if( gestures::GestureBenchmark::isBenchmarkRequested( argc, argv ) ) {
+        exitCode = gestures::GestureBenchmark::run( argc, argv, std::cout );
+    }
+    else if( gui::PaintBenchmark::isBenchmarkRequested( argc, argv ) ) {
+        exitCode = gui::PaintBenchmark::run( argc, argv, std::cout );
+    }
+    else if( logger::JournalDecoder::isDecodeRequested( argc, argv ) ) {
+        exitCode = logger::JournalDecoder::run( argc, argv, std::cout );
+    }
+    else if( xml::SettingsXmlBenchmark::isBenchmarkRequested( argc, argv ) ) {
+        exitCode = xml::SettingsXmlBenchmark::run( argc, argv, std::cout );
+    }
+    else {
+        // Open the journal on this thread, before the TUIO thread can use it.
+        logger::EventJournal::instance();
+        exitCode = runLauncher( app );
+    }
+    logger::FileLogger::shutdown();
+    return exitCode;
+}
+
+/*******************************************************************************
+The Playsurface is destroyed before this returns, so anything it logs while
+shutting down still reaches the log file.
+*******************************************************************************/
+static int runLauncher( QApplication & app )
+{
     //bool gesturesMenu = showGesturesMenu( argc, argv );
     bool gesturesMenu = true;
 
@@ -0,0 +1,207 @@
+/*******************************************************************************
+Metrics
+
+PURPOSE: The counters and histograms that the launcher keeps about itself (TUIO
+         frames, touch latency, gestures, app launches, scan and paint times).
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "metrics/Metrics.h"
+
+using metrics::Metrics;
+
+static const double TOUCH_LATENCY_BOUNDS[] = { 0.0005, 0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1, 0.25 },
+                    APP_RUN_TIME_BOUNDS[] = { 10, 30, 60, 120, 300, 600, 1200, 1800, 3600, 7200 },
+                    DIRECTORY_SCAN_BOUNDS[] = { 0.01, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30 },
+                    PAINT_TIME_BOUNDS[] = { 0.0005, 0.001, 0.002, 0.004, 0.008, 0.016, 0.033, 0.05, 0.1 };
+
+#define NUMBER_OF( array )  ((int)(sizeof( array ) / sizeof( array[0] )))
+
+/***************************************************************************//**
+instance() is called once during static initialization, so that the instance
+is constructed before main() runs and before any other thread can use it 
+(function-local statics are not thread-safe in Visual Studio 2013).  The 
+reference itself is not used, since it may not be bound yet while another 
+file's statics are being initialized; code goes through instance().
+*******************************************************************************/
+static Metrics & theMetrics = Metrics::instance();
+
+Metrics & Metrics::instance()
+{
+    static Metrics instance;
+    return instance;
+}
+
+long long Metrics::microseconds()
+{
+    return instance().clock_.nsecsElapsed() / 1000;
+}
+
+Metrics::Counter::Counter( const char * name, const char * help ) :
+  name( name ),
+  help( help )
+{
+    value_.store( 0 );
+}
+
+void Metrics::Counter::increment()
+{
+    value_.fetch_add( 1, std::memory_order_relaxed );
+}
+
+unsigned long long Metrics::Counter::value() const
+{
+    return value_.load( std::memory_order_relaxed );
+}
+
+Metrics::Histogram::Histogram( const char * name, const char * help, 
+                               const double * upperBoundsInSeconds, int numberOfBounds ) :
+  name( name ),
+  help( help ),
+  numberOfBounds( numberOfBounds )
+{
+    if( this->numberOfBounds > MAX_BUCKETS ) {
+        this->numberOfBounds = MAX_BUCKETS;
+    }
+    for( int i = 0; i < this->numberOfBounds; ++i ) {
+        upperBounds[i] = (long long)(upperBoundsInSeconds[i] * 1000000.0);
+    }
+    for( int i = 0; i <= MAX_BUCKETS; ++i ) {
+        bucketCounts[i].store( 0 );
+    }
+    sumMicroseconds.store( 0 );
+}
+
+/***************************************************************************//**
+Only the bucket the observation falls in is incremented; the counts are made
+cumulative when the text is written.
+*******************************************************************************/
+void Metrics::Histogram::observeMicroseconds( long long microseconds )
+{
+    if( microseconds < 0 ) {
+        microseconds = 0;
+    }
+    int bucket = 0;
+
+    while( bucket < numberOfBounds && microseconds > upperBounds[bucket] ) {
+        ++bucket;
+    }
+    bucketCounts[bucket].fetch_add( 1, std::memory_order_relaxed );
+    sumMicroseconds.fetch_add( (unsigned long long)microseconds, std::memory_order_relaxed );
+}
+
+void Metrics::Histogram::observeSince( long long startMicroseconds )
+{
+    observeMicroseconds( Metrics::microseconds() - startMicroseconds );
+}
+
+Metrics::Metrics() :
+  tuioFrames( "playsurface_tuio_frames_total", 
+              "TUIO frames (fseq messages) received, all profiles." ),
+  touchEventsPosted( "playsurface_touch_events_posted_total", 
+                     "QTouchEvents posted to the GUI thread by QTuio." ),
+  plusSignGestures( "playsurface_plus_sign_gestures_total", 
+                    "Plus sign gestures recognized." ),
+  horizontalLineGestures( "playsurface_horizontal_line_gestures_total", 
+                          "Horizontal line gestures recognized (gestures mode)." ),
+  verticalLineGestures( "playsurface_vertical_line_gestures_total", 
+                        "Vertical line gestures recognized (gestures mode)." ),
+  appLaunches( "playsurface_app_launches_total", 
+               "Multitouch apps launched." ),
+  appCrashes( "playsurface_app_crashes_total", 
+              "Multitouch apps that crashed or exited with a non-zero exit code." ),
+  touchLatency( "playsurface_touch_latency_seconds", 
+                "Time from QTuio posting a touch event to the GUI thread handling it.",
+                TOUCH_LATENCY_BOUNDS, NUMBER_OF( TOUCH_LATENCY_BOUNDS ) ),
+  appRunTime( "playsurface_app_run_seconds", 
+              "How long each multitouch app ran, from launch to exit.",
+              APP_RUN_TIME_BOUNDS, NUMBER_OF( APP_RUN_TIME_BOUNDS ) ),
+  directoryScanTime( "playsurface_directory_scan_seconds", 
+                     "Time taken by DirectoryReader to read the MultitouchApps directories.",
+                     DIRECTORY_SCAN_BOUNDS, NUMBER_OF( DIRECTORY_SCAN_BOUNDS ) ),
+  paintTime( "playsurface_paint_seconds", 
+             "Time spent in PaintWidget::paintEvent().",
+             PAINT_TIME_BOUNDS, NUMBER_OF( PAINT_TIME_BOUNDS ) ),
+  clock_()
+{
+    clock_.start();
+}
+
+/***************************************************************************//**
+Returns all of the metrics in the Prometheus text exposition format.
+*******************************************************************************/
+QString Metrics::exposition()
+{
+    QString text;
+    appendCounter( text, tuioFrames );
+    appendCounter( text, touchEventsPosted );
+    appendCounter( text, plusSignGestures );
+    appendCounter( text, horizontalLineGestures );
+    appendCounter( text, verticalLineGestures );
+    appendCounter( text, appLaunches );
+    appendCounter( text, appCrashes );
+    appendHistogram( text, touchLatency );
+    appendHistogram( text, appRunTime );
+    appendHistogram( text, directoryScanTime );
+    appendHistogram( text, paintTime );
+    return text;
+}
+
+void Metrics::appendCounter( QString & text, const Counter & counter )
+{
+    text += QString( "# HELP %1 %2\n# TYPE %1 counter\n%1 %3\n" )
+                .arg( counter.name )
+                .arg( counter.help )
+                .arg( counter.value() );
+}
+
+/***************************************************************************//**
+The _count is the total of the buckets, so it always equals the +Inf bucket,
+even when an observation is made while the buckets are being read.
+*******************************************************************************/
+void Metrics::appendHistogram( QString & text, const Histogram & histogram )
+{
+    text += QString( "# HELP %1 %2\n# TYPE %1 histogram\n" )
+                .arg( histogram.name )
+                .arg( histogram.help );
+    unsigned long long cumulative = 0;
+
+    for( int i = 0; i <= histogram.numberOfBounds; ++i ) {
+        cumulative += histogram.bucketCounts[i].load( std::memory_order_relaxed );
+        QString bound = (i < histogram.numberOfBounds) 
+                        ? QString::number( histogram.upperBounds[i] / 1000000.0, 'g', 6 )
+                        : QString( "+Inf" );
+        text += QString( "%1_bucket{le=\"%2\"} %3\n" )
+                    .arg( histogram.name )
+                    .arg( bound )
+                    .arg( cumulative );
+    }
+    text += QString( "%1_sum %2\n%1_count %3\n" )
+                .arg( histogram.name )
+                .arg( histogram.sumMicroseconds.load( std::memory_order_relaxed ) / 1000000.0, 0, 'f', 6 )
+                .arg( cumulative );
+}
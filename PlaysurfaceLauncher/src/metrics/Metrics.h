@@ -0,0 +1,132 @@
+/*******************************************************************************
+Metrics
+
+PURPOSE: The counters and histograms that the launcher keeps about itself (TUIO
+         frames, touch latency, gestures, app launches, scan and paint times).
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef METRICS_METRICS_H
+#define METRICS_METRICS_H
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QList>
+#include <atomic>
+
+/***************************************************************************//**
+Contains the counters and histograms that the launcher keeps about itself,
+and the endpoint that serves them to a monitoring system.
+*******************************************************************************/
+namespace metrics
+{
+    /***********************************************************************//**
+    The launcher's counters and histograms, in one place so that they can be
+    served together by the MetricsServer in the Prometheus text format.
+
+    The metrics are always kept, whether or not the endpoint is turned on.
+    Updating one is a relaxed atomic increment (two for a histogram), with
+    no lock and no allocation, so it can be done on the TUIO thread and in
+    paintEvent() without showing up in the timings.  Times are measured
+    with microseconds(), which reads the performance counter.
+    ***************************************************************************/
+    class Metrics
+    {
+    public:
+        static const int MAX_BUCKETS = 12;
+
+        /*******************************************************************//**
+        A count that only goes up.
+        ***********************************************************************/
+        class Counter
+        {
+        public:
+            Counter( const char * name, const char * help );
+
+            void increment();
+            unsigned long long value() const;
+
+            const char * name,
+                       * help;
+
+        private:
+            std::atomic<unsigned long long> value_;
+        };
+
+        /*******************************************************************//**
+        Counts observations (in microseconds) in buckets whose upper bounds
+        are given in seconds, as Prometheus expects.  The bounds must be in
+        increasing order; anything above the last bound only goes into the
+        +Inf bucket.
+        ***********************************************************************/
+        class Histogram
+        {
+        public:
+            Histogram( const char * name, const char * help, 
+                       const double * upperBoundsInSeconds, int numberOfBounds );
+
+            void observeMicroseconds( long long microseconds );
+            void observeSince( long long startMicroseconds );
+
+            const char * name,
+                       * help;
+            long long upperBounds[MAX_BUCKETS]; // In microseconds.
+            int numberOfBounds;
+            std::atomic<unsigned long long> bucketCounts[MAX_BUCKETS + 1],
+                                            sumMicroseconds;
+        };
+
+        static Metrics & instance();
+        static long long microseconds();
+
+        Counter tuioFrames,
+                touchEventsPosted,
+                plusSignGestures,
+                horizontalLineGestures,
+                verticalLineGestures,
+                appLaunches,
+                appCrashes;
+        Histogram touchLatency,
+                  appRunTime,
+                  directoryScanTime,
+                  paintTime;
+
+        QString exposition();
+
+    private:
+        Metrics();
+        Metrics( const Metrics & );
+        Metrics & operator=( const Metrics & );
+
+        void appendCounter( QString & text, const Counter & counter );
+        void appendHistogram( QString & text, const Histogram & histogram );
+
+        QElapsedTimer clock_;
+    };
+}
+
+#endif
@@ -0,0 +1,170 @@
+/*******************************************************************************
+MetricsServer
+
+PURPOSE: Serves the Metrics in the Prometheus text format over HTTP on
+         localhost.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "metrics/MetricsServer.h"
+#include "metrics/Metrics.h"
+#include "logger/FileLogger.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QTimer>
+#include <QList>
+
+using metrics::MetricsServer;
+
+const int MetricsServer::MAX_REQUEST_LINE_BYTES = 1024,
+          MetricsServer::REQUEST_TIMEOUT_MILLISEC = 5000;
+
+MetricsServer::MetricsServer( QObject * parent ) :
+  QObject( parent ),
+  tcpServer_( new QTcpServer( this ) )
+{
+    connect( tcpServer_, SIGNAL( newConnection() ), this, SLOT( acceptConnections() ) );
+}
+
+MetricsServer::~MetricsServer()
+{
+}
+
+/***************************************************************************//**
+Starts listening on the given port of 127.0.0.1 (or moves to it, if the
+server is already listening on another port).  Returns false, and logs a
+warning, if the port could not be opened.
+*******************************************************************************/
+bool MetricsServer::listen( int port )
+{
+    if( tcpServer_->isListening() ) {
+        if( tcpServer_->serverPort() == port ) {
+            return true;
+        }
+        tcpServer_->close();
+    }
+    if( !tcpServer_->listen( QHostAddress::LocalHost, (quint16)port ) ) {
+        QString message = QString( "MetricsServer: could not listen on port %1 (%2)" )
+                              .arg( port )
+                              .arg( tcpServer_->errorString() );
+        logger::FileLogger::instance().writeWarning( message.toStdString() );
+        return false;
+    }
+    QString message = QString( "MetricsServer: serving metrics at http://127.0.0.1:%1/metrics" )
+                          .arg( port );
+    logger::FileLogger::instance().writeInfo( message.toStdString() );
+    return true;
+}
+
+void MetricsServer::close()
+{
+    tcpServer_->close();
+}
+
+bool MetricsServer::isListening()
+{
+    return tcpServer_->isListening();
+}
+
+int MetricsServer::port()
+{
+    return tcpServer_->isListening() ? tcpServer_->serverPort() : 0;
+}
+
+/***************************************************************************//**
+Each socket gets its own timeout timer.  The timer is a child of the socket,
+so it goes away with the socket.
+*******************************************************************************/
+void MetricsServer::acceptConnections()
+{
+    while( tcpServer_->hasPendingConnections() ) {
+        QTcpSocket * socket = tcpServer_->nextPendingConnection();
+        connect( socket, SIGNAL( readyRead() ), this, SLOT( readRequest() ) );
+        connect( socket, SIGNAL( disconnected() ), socket, SLOT( deleteLater() ) );
+
+        QTimer * timeoutTimer = new QTimer( socket );
+        timeoutTimer->setSingleShot( true );
+        connect( timeoutTimer, SIGNAL( timeout() ), this, SLOT( abortTimedOutConnection() ) );
+        timeoutTimer->start( REQUEST_TIMEOUT_MILLISEC );
+    }
+}
+
+void MetricsServer::abortTimedOutConnection()
+{
+    QTcpSocket * socket = (sender() != NULL) ? qobject_cast<QTcpSocket *>( sender()->parent() ) : NULL;
+
+    if( socket != NULL ) {
+        socket->abort();
+        socket->deleteLater();
+    }
+}
+
+/***************************************************************************//**
+Only the request line is needed, so the rest of the request is ignored.
+*******************************************************************************/
+void MetricsServer::readRequest()
+{
+    QTcpSocket * socket = qobject_cast<QTcpSocket *>( sender() );
+
+    if( socket == NULL ) {
+        return;
+    }
+    if( !socket->canReadLine() ) {
+        if( socket->bytesAvailable() > MAX_REQUEST_LINE_BYTES ) {
+            socket->abort();
+        }
+        return;
+    }
+    disconnect( socket, SIGNAL( readyRead() ), this, SLOT( readRequest() ) );
+    QList<QByteArray> requestLine = socket->readLine( MAX_REQUEST_LINE_BYTES ).trimmed().split( ' ' );
+    QByteArray method = requestLine.value( 0 ),
+               path = requestLine.value( 1 );
+
+    if( method != "GET" ) {
+        respond( socket, "405 Method Not Allowed", "Only GET is supported.\n" );
+    }
+    else if( path == "/metrics" || path == "/" ) {
+        respond( socket, "200 OK", metrics::Metrics::instance().exposition().toUtf8() );
+    }
+    else {
+        respond( socket, "404 Not Found", "The metrics are at /metrics.\n" );
+    }
+}
+
+void MetricsServer::respond( QTcpSocket * socket, 
+                             const QByteArray & status, 
+                             const QByteArray & body )
+{
+    QByteArray response = "HTTP/1.1 " + status + "\r\n"
+                          "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                          "Content-Length: " + QByteArray::number( body.size() ) + "\r\n"
+                          "Connection: close\r\n"
+                          "\r\n" + body;
+    socket->write( response );
+    socket->disconnectFromHost();
+}
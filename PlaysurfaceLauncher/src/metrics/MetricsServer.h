@@ -0,0 +1,84 @@
+/*******************************************************************************
+MetricsServer
+
+PURPOSE: Serves the Metrics in the Prometheus text format over HTTP on
+         localhost.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef METRICS_METRICSSERVER_H
+#define METRICS_METRICSSERVER_H
+
+#include <QObject>
+#include <QByteArray>
+
+class QTcpServer;
+class QTcpSocket;
+
+namespace metrics
+{
+    /***********************************************************************//**
+    A minimal HTTP listener that answers "GET /metrics" with the Metrics in
+    the Prometheus text format, so that every table can be scraped by a
+    monitoring agent running on it.  It only listens on the loopback 
+    address, and each connection gets one response and is then closed.  A
+    connection that has not been answered and closed within 
+    REQUEST_TIMEOUT_MILLISEC is aborted, so a client that never sends a 
+    whole request line cannot hold a socket open.  The server runs on the 
+    GUI thread, which only reads the atomics when a scrape arrives.
+    ***************************************************************************/
+    class MetricsServer : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        static const int MAX_REQUEST_LINE_BYTES,
+                         REQUEST_TIMEOUT_MILLISEC;
+
+        MetricsServer( QObject * parent = NULL );
+        virtual ~MetricsServer();
+
+        bool listen( int port );
+        void close();
+        bool isListening();
+        int port();
+
+    private slots:
+        void acceptConnections();
+        void readRequest();
+        void abortTimedOutConnection();
+
+    private:
+        void respond( QTcpSocket * socket, 
+                      const QByteArray & status, 
+                      const QByteArray & body );
+
+        QTcpServer * tcpServer_;
+    };
+}
+
+#endif
@@ -37,6 +37,7 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #include "gui/FullScreenWindow.h"
 #include "serialport/ProjectorPort.h"
 #include "qtuio/QTuio.h"
+#include "qtuio/TuioStreamMonitor.h"
 
 using playsurface::Playsurface;
 
@@ -49,12 +50,14 @@ Playsurface::Playsurface() :
   xmlSettings_( new gui::XmlSettings() ),
   fullScreenWindow_( NULL ),
   qTuio_( NULL ),
+  tuioStreamMonitor_( NULL ),
   shutDownProjector_( true )
 {
 }
 
 Playsurface::~Playsurface()
 {
+    delete tuioStreamMonitor_;
     delete qTuio_;
     delete fullScreenWindow_;
     delete xmlSettings_;
@@ -138,7 +141,14 @@ void Playsurface::startTuioClient()
         bool allow2DcurFiltering = xmlSettings_->isBigBlobbySelected();
         qTuio_->allowTuioProfileFiltering( allow2DcurFiltering );
         qTuio_->setTuioUdpPort( DEFAULT_TUIO_PORT );
+        qTuio_->setBackgroundGestureDetector( fullScreenWindow_->backgroundGestureDetector() );
+        qTuio_->setTuioGeneratorSupervisor( appLauncher_->tuioGeneratorSupervisor() );
         qTuio_->run();
+
+        tuioStreamMonitor_ = new qtuio::TuioStreamMonitor( qTuio_->tuioStats() );
+        connect( tuioStreamMonitor_, SIGNAL( statsUpdated( const QString & ) ),
+                 fullScreenWindow_, SLOT( setTuioStatsText( const QString & ) ) );
+        tuioStreamMonitor_->start();
     }
 }
 
@@ -41,6 +41,7 @@ namespace serialport { class ProjectorPort; }
 namespace gui { class XmlSettings; }
 namespace gui { class FullScreenWindow; }
 namespace qtuio { class QTuio; }
+namespace qtuio { class TuioStreamMonitor; }
 
 namespace playsurface
 {
@@ -83,6 +84,7 @@ namespace playsurface
         gui::XmlSettings * xmlSettings_;
         gui::FullScreenWindow * fullScreenWindow_;
         qtuio::QTuio * qTuio_;
+        qtuio::TuioStreamMonitor * tuioStreamMonitor_;
         bool shutDownProjector_;
     };
 }
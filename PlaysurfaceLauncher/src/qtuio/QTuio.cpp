@@ -25,6 +25,10 @@ NOTE: This class was obtained from GitHub (https://github.com/x29a/qTUIO) and
 #include "QTuio.h"
 #include "TuioClient.h"
 #include "TuioCursor.h"
+#include "gestures/BackgroundGestureDetector.h"
+#include "app/TuioGeneratorSupervisor.h"
+#include "logger/EventJournal.h"
+#include "metrics/Metrics.h"
 #include <QEvent>
 #include <QTouchEvent>
 #include <QApplication>
@@ -54,8 +58,13 @@ QTuio::QTuio( QObject * parent ) :
   screenArea_( 0.0 ),
   tuioClient_( NULL ),
   qTouchPointMap_( NULL ),
+  backgroundSessionIds_(),
+  backgroundGestureDetector_( NULL ),
+  tuioGeneratorSupervisor_( NULL ),
   running_( false ),
-  tuioUdpPort_( DEFAULT_TUIO_UDP_PORT )
+  tuioUdpPort_( DEFAULT_TUIO_UDP_PORT ),
+  journaledTouchCount_( 0 ),
+  journaledFrame_( -1 )
 {
     // If a QMainWindow exists, get the central widget.
     if( theMainWindow_ != NULL ) {
@@ -86,6 +95,24 @@ void QTuio::setTuioUdpPort( int port )
     tuioUdpPort_ = port;
 }
 
+/***************************************************************************//**
+Must be called before run(), since the detector is used (without locking) by
+the thread that receives TUIO messages.
+*******************************************************************************/
+void QTuio::setBackgroundGestureDetector( gestures::BackgroundGestureDetector * detector )
+{
+    backgroundGestureDetector_ = detector;
+}
+
+/***************************************************************************//**
+Must be called before run().  The supervisor is told about every TUIO frame,
+so that it can tell when the TUIO generator has stopped sending.
+*******************************************************************************/
+void QTuio::setTuioGeneratorSupervisor( app::TuioGeneratorSupervisor * supervisor )
+{
+    tuioGeneratorSupervisor_ = supervisor;
+}
+
 void QTuio::run()
 {
     running_ = true;
@@ -99,6 +126,15 @@ void QTuio::run()
     tuioClient_->connect();
 }
 
+/***************************************************************************//**
+Returns NULL until run() has been called.  The counters belong to the 
+TuioClient, so they must not be used after this QTuio is deleted.
+*******************************************************************************/
+TUIO::TuioStats * QTuio::tuioStats()
+{
+    return (tuioClient_ != NULL) ? &tuioClient_->getStats() : NULL;
+}
+
 /**
  * If the /tuio/2Dblb TUIO message profile is seen, it may be desirable
  * to allow filter out any /tuio/2Dcur messages.  2Dcur is a subset of
@@ -135,6 +171,9 @@ bool QTuio::tuioToQt( TUIO::TuioCursor * tcur, QEvent::Type eventType )
     const QPointF screenPos( screenRect_.width() * normPos.x(), 
                              screenRect_.height() * normPos.y() );
 
+    if( sendToBackgroundGestureDetector( id, eventType, screenPos, speed ) ) {
+        return true;
+    }
     QTouchEvent::TouchPoint touchPoint( id );
     touchPoint.setNormalizedPos( normPos );
     touchPoint.setRect( QRectF() );
@@ -149,6 +188,53 @@ bool QTuio::tuioToQt( TUIO::TuioCursor * tcur, QEvent::Type eventType )
     return true;
 }
 
+/***************************************************************************//**
+While a multitouch app is open, the launcher only needs to know whether a plus 
+sign was drawn, so the touch goes straight to the background gesture detector 
+(on this thread) and no QTouchEvent is built or posted to the GUI thread.  
+Returns false if the touch should be sent to the GUI as usual.  Like the GUI
+path, stationary updates are not added to a gesture.
+
+The route is chosen once for each session id, at TouchBegin, and kept until
+that id's TouchEnd.  If the detector is turned on or off while a finger is
+down, that finger stays on the path it started on, so neither the detector
+nor the GUI ever sees half a stroke.
+*******************************************************************************/
+bool QTuio::sendToBackgroundGestureDetector( int id, 
+                                             QEvent::Type eventType, 
+                                             const QPointF & screenPos,
+                                             double speed )
+{
+    if( eventType == QEvent::TouchBegin ) {
+        if( backgroundGestureDetector_ == NULL || !backgroundGestureDetector_->isEnabled() ) {
+            return false;
+        }
+        backgroundSessionIds_.insert( id );
+    }
+    else if( !backgroundSessionIds_.contains( id ) ) {
+        return false;
+    }
+    double x = screenPos.x(),
+           y = screenPos.y();
+
+    switch( eventType ) {
+        case QEvent::TouchBegin:
+            backgroundGestureDetector_->startGesture( id, x, y );
+            break;
+        case QEvent::TouchUpdate:
+            if( speed > 0 ) {
+                backgroundGestureDetector_->updateGesture( id, x, y );
+            }
+            break;
+        case QEvent::TouchEnd:
+            backgroundGestureDetector_->finishGesture( id, x, y );
+            backgroundSessionIds_.remove( id );
+            break;
+        default:  break;
+    }
+    return true;
+}
+
 void QTuio::setScenePosAndRect( QTouchEvent::TouchPoint & touchPoint, 
                                 const QPointF & screenPos )
 {
@@ -278,11 +364,14 @@ void QTuio::sendTouchEvent( QEvent::Type eventType, Qt::TouchPointStates touchPo
     if( eventType == QEvent::TouchBegin ) {
         eventType = QEvent::TouchUpdate;
     }
-    QEvent * touchEvent = new QTouchEvent( eventType, 
-                                           0, 
-                                           Qt::NoModifier, 
-                                           touchPointStates, 
-                                           qTouchPointMap_->values() );
+    QTouchEvent * touchEvent = new QTouchEvent( eventType, 
+                                                0, 
+                                                Qt::NoModifier, 
+                                                touchPointStates, 
+                                                qTouchPointMap_->values() );
+    // The timestamp is used by the CentralWidget to measure touch latency.
+    touchEvent->setTimestamp( (ulong)metrics::Metrics::microseconds() );
+    metrics::Metrics::instance().touchEventsPosted.increment();
 
     if( theView_ && theView_->viewport() ) {
         qApp->postEvent( theView_->viewport(), touchEvent );
@@ -324,6 +413,9 @@ bool QTuio::tuioToQt( TUIO::TuioBlob * tblb, QEvent::Type eventType )
     const QPointF normPos( tblb->getX(), tblb->getY() );
     const QPointF screenPos( screenRect_.width() * normPos.x(), 
                              screenRect_.height() * normPos.y() );
+    if( sendToBackgroundGestureDetector( id, eventType, screenPos, speed ) ) {
+        return true;
+    }
     const QRectF boundingBox( screenPos.x() - (width / 2.0),
                               screenPos.y() - (height / 2.0), 
                               width, 
@@ -376,8 +468,34 @@ bool QTuio::tuioToQt( TUIO::TuioObject * tobj, QEvent::Type eventType )
     return true;
 }
 
+/***************************************************************************//**
+Frames are only journaled while something is touching the table (plus the 
+first empty frame after that), so an idle table does not fill the journal.
+The TuioClient calls refresh() once for each profile in a frame (e.g., for 
+both 2Dcur and 2Dblb), so a frame is journaled only when the frame number 
+changes.
+*******************************************************************************/
 void QTuio::refresh( TUIO::TuioTime frameTime ) 
 {
+    if( tuioGeneratorSupervisor_ != NULL ) {
+        tuioGeneratorSupervisor_->frameReceived();
+    }
+    metrics::Metrics::instance().tuioFrames.increment();
+    TUIO::TuioStats * stats = tuioStats();
+
+    if( stats != NULL && tuioClient_->getCurrentFrame() != journaledFrame_ ) {
+        journaledFrame_ = tuioClient_->getCurrentFrame();
+        int cursors = stats->aliveCount( TUIO::TuioStats::CURSOR_PROFILE ),
+            blobs = stats->aliveCount( TUIO::TuioStats::BLOB_PROFILE ),
+            objects = stats->aliveCount( TUIO::TuioStats::OBJECT_PROFILE ),
+            touchCount = cursors + blobs + objects;
+
+        if( touchCount > 0 || journaledTouchCount_ > 0 ) {
+            logger::EventJournal::instance().record( logger::EventJournal::TOUCH_FRAME, 
+                                                     cursors, blobs, objects );
+        }
+        journaledTouchCount_ = touchCount;
+    }
 }
 
 void QTuio::printScreenRect()
@@ -28,12 +28,16 @@ NOTE: This class was obtained from GitHub (https://github.com/x29a/qTUIO) and
 #include "TuioListener.h"
 //#include <QThread>
 #include <QMap>
+#include <QSet>
 #include <QEvent>
 #include <QTouchEvent>
 
 namespace TUIO { class TuioClient; }
 namespace TUIO { class TuioCursor; }
 namespace TUIO { class TuioBlob; }
+namespace TUIO { class TuioStats; }
+namespace gestures { class BackgroundGestureDetector; }
+namespace app { class TuioGeneratorSupervisor; }
 
 class QGraphicsView;
 class QGraphicsScene;
@@ -53,7 +57,10 @@ namespace qtuio
 
         void allowTuioProfileFiltering( bool b );
         void setTuioUdpPort( int port );
+        void setBackgroundGestureDetector( gestures::BackgroundGestureDetector * detector );
+        void setTuioGeneratorSupervisor( app::TuioGeneratorSupervisor * supervisor );
         void run();
+        TUIO::TuioStats * tuioStats();
 
         virtual void addTuioCursor( TUIO::TuioCursor *tcur );
         virtual void updateTuioCursor( TUIO::TuioCursor * tcur );
@@ -71,6 +78,10 @@ namespace qtuio
 
     private:
         bool tuioToQt( TUIO::TuioCursor * tcur, QEvent::Type eventType );
+        bool sendToBackgroundGestureDetector( int id, 
+                                              QEvent::Type eventType, 
+                                              const QPointF & screenPos,
+                                              double speed );
         void setScenePosAndRect( QTouchEvent::TouchPoint & touchPoint, const QPointF & screenPos );
         void setPositionBasedOnTheScene( QTouchEvent::TouchPoint & touchPoint, 
                                          const QPointF & screenPos );
@@ -105,8 +116,13 @@ namespace qtuio
         double screenArea_;
         TUIO::TuioClient * tuioClient_;
         QMap<int, QTouchEvent::TouchPoint> * qTouchPointMap_;
+        QSet<int> backgroundSessionIds_; // Only used by the TUIO thread.
+        gestures::BackgroundGestureDetector * backgroundGestureDetector_;
+        app::TuioGeneratorSupervisor * tuioGeneratorSupervisor_;
         bool running_;
         int tuioUdpPort_;
+        int journaledTouchCount_, // Only used by the TUIO thread.
+            journaledFrame_;
     };
 }
 
@@ -0,0 +1,173 @@
+/*******************************************************************************
+TuioStreamMonitor
+
+PURPOSE: Samples the TUIO receive counters once a second for the on-screen TUIO
+         statistics, and writes a summary of them to the log once a minute.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "qtuio/TuioStreamMonitor.h"
+#include "logger/FileLogger.h"
+#include <QTimer>
+#include <QStringList>
+
+using qtuio::TuioStreamMonitor;
+using TUIO::TuioStats;
+
+const int TuioStreamMonitor::SAMPLE_MILLISECONDS = 1000,
+          TuioStreamMonitor::LOG_INTERVAL_SECONDS = 60;
+
+/***************************************************************************//**
+Describes what arrived between two snapshots, one line (joined by the
+separator) for the datagrams and one for each profile that has been seen.
+The counters wrap around, so the differences are taken as unsigned ints.
+*******************************************************************************/
+QString TuioStreamMonitor::describe( const TuioStats::Snapshot & from,
+                                     const TuioStats::Snapshot & to,
+                                     double seconds,
+                                     unsigned int maxDatagramBytes,
+                                     const int * maxAliveCounts,
+                                     const QString & separator )
+{
+    QStringList lines;
+    unsigned int datagrams = to.datagrams - from.datagrams,
+                 bytes = to.datagramBytes - from.datagramBytes;
+
+    if( datagrams == 0 || seconds <= 0.0 ) {
+        lines << "TUIO  no datagrams";
+    }
+    else {
+        lines << QString( "TUIO  %1 datagrams/s, %2 bytes avg, %3 max" )
+                     .arg( datagrams / seconds, 0, 'f', 1 )
+                     .arg( bytes / datagrams )
+                     .arg( maxDatagramBytes );
+    }
+    for( int i = 0; i < TuioStats::NUMBER_OF_PROFILES; ++i ) {
+        if( to.frames[i] == 0 && to.lateFrames[i] == 0 ) {
+            continue;
+        }
+        unsigned int frames = to.frames[i] - from.frames[i];
+        double fps = (seconds > 0.0) ? frames / seconds : 0.0;
+        lines << QString( "%1  %2 fps, %3 gaps (%4 frames skipped), %5 late, %6 sessions" )
+                     .arg( TuioStats::profileName( (TuioStats::Profile)i ) )
+                     .arg( fps, 0, 'f', 1 )
+                     .arg( to.gaps[i] - from.gaps[i] )
+                     .arg( to.skippedFrames[i] - from.skippedFrames[i] )
+                     .arg( to.lateFrames[i] - from.lateFrames[i] )
+                     .arg( maxAliveCounts[i] );
+    }
+    return lines.join( separator );
+}
+
+TuioStreamMonitor::TuioStreamMonitor( TuioStats * stats, QObject * parent ) :
+  QObject( parent ),
+  stats_( stats ),
+  sampleTimer_( new QTimer( this ) ),
+  sampleClock_(),
+  logClock_(),
+  previous_(),
+  logStart_(),
+  logMaxDatagramBytes_( 0 ),
+  statsText_()
+{
+    sampleTimer_->setInterval( SAMPLE_MILLISECONDS );
+    connect( sampleTimer_, SIGNAL( timeout() ), this, SLOT( sample() ) );
+
+    for( int i = 0; i < TuioStats::NUMBER_OF_PROFILES; ++i ) {
+        logMaxAliveCounts_[i] = 0;
+    }
+}
+
+TuioStreamMonitor::~TuioStreamMonitor()
+{
+}
+
+void TuioStreamMonitor::start()
+{
+    if( stats_ == NULL ) {
+        return;
+    }
+    previous_ = stats_->snapshot();
+    resetLogInterval( previous_ );
+    sampleClock_.start();
+    sampleTimer_->start();
+}
+
+void TuioStreamMonitor::stop()
+{
+    sampleTimer_->stop();
+}
+
+QString TuioStreamMonitor::statsText()
+{
+    return statsText_;
+}
+
+void TuioStreamMonitor::sample()
+{
+    TuioStats::Snapshot snapshot = stats_->snapshot();
+    double seconds = sampleClock_.restart() / 1000.0;
+    statsText_ = describe( previous_, snapshot, seconds, snapshot.maxDatagramBytes,
+                           snapshot.aliveCount, "\n" );
+    previous_ = snapshot;
+    emit statsUpdated( statsText_ );
+
+    logMaxDatagramBytes_ = qMax( logMaxDatagramBytes_, snapshot.maxDatagramBytes );
+
+    for( int i = 0; i < TuioStats::NUMBER_OF_PROFILES; ++i ) {
+        logMaxAliveCounts_[i] = qMax( logMaxAliveCounts_[i], snapshot.aliveCount[i] );
+    }
+    if( logClock_.elapsed() >= LOG_INTERVAL_SECONDS * 1000 ) {
+        writeLogLine( snapshot );
+        resetLogInterval( snapshot );
+    }
+}
+
+void TuioStreamMonitor::resetLogInterval( const TuioStats::Snapshot & snapshot )
+{
+    logStart_ = snapshot;
+    logMaxDatagramBytes_ = 0;
+
+    for( int i = 0; i < TuioStats::NUMBER_OF_PROFILES; ++i ) {
+        logMaxAliveCounts_[i] = snapshot.aliveCount[i];
+    }
+    logClock_.start();
+}
+
+void TuioStreamMonitor::writeLogLine( const TuioStats::Snapshot & snapshot )
+{
+    logger::Log & log = logger::FileLogger::instance();
+
+    if( !log.isEnabled( logger::Log::INFO_LEVEL ) ) {
+        return;
+    }
+    double seconds = logClock_.elapsed() / 1000.0;
+    QString message = "TuioStreamMonitor: "
+                      + describe( logStart_, snapshot, seconds, logMaxDatagramBytes_,
+                                  logMaxAliveCounts_, "; " );
+    log.writeInfo( message.toStdString() );
+}
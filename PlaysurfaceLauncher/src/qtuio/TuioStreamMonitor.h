@@ -0,0 +1,99 @@
+/*******************************************************************************
+TuioStreamMonitor
+
+PURPOSE: Samples the TUIO receive counters once a second for the on-screen TUIO
+         statistics, and writes a summary of them to the log once a minute.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef QTUIO_TUIOSTREAMMONITOR_H
+#define QTUIO_TUIOSTREAMMONITOR_H
+
+#include "TuioStats.h"
+#include <QObject>
+#include <QString>
+#include <QElapsedTimer>
+
+class QTimer;
+
+namespace qtuio
+{
+    /***********************************************************************//**
+    Turns the TuioStats counters of the TuioClient into rates.  Every
+    SAMPLE_MILLISECONDS it takes a snapshot of the counters (which does not
+    lock the thread that receives the TUIO messages), works out the frames
+    per second of each profile and the datagrams per second since the last
+    snapshot, and emits the result as text with statsUpdated(), for the
+    PaintWidget's overlay.  Every LOG_INTERVAL_SECONDS the averages for the
+    whole interval are written to the log as one line, so the log shows
+    whether the camera was running at 30 or 60 frames per second.
+    ***************************************************************************/
+    class TuioStreamMonitor : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        static const int SAMPLE_MILLISECONDS,
+                         LOG_INTERVAL_SECONDS;
+
+        static QString describe( const TUIO::TuioStats::Snapshot & from,
+                                 const TUIO::TuioStats::Snapshot & to,
+                                 double seconds,
+                                 unsigned int maxDatagramBytes,
+                                 const int * maxAliveCounts,
+                                 const QString & separator );
+
+        TuioStreamMonitor( TUIO::TuioStats * stats, QObject * parent = NULL );
+        virtual ~TuioStreamMonitor();
+
+        void start();
+        void stop();
+        QString statsText();
+
+    signals:
+        void statsUpdated( const QString & text );
+
+    private slots:
+        void sample();
+
+    private:
+        void resetLogInterval( const TUIO::TuioStats::Snapshot & snapshot );
+        void writeLogLine( const TUIO::TuioStats::Snapshot & snapshot );
+
+        TUIO::TuioStats * stats_;
+        QTimer * sampleTimer_;
+        QElapsedTimer sampleClock_,
+                      logClock_;
+        TUIO::TuioStats::Snapshot previous_,
+                                  logStart_;
+        unsigned int logMaxDatagramBytes_;
+        int logMaxAliveCounts_[TUIO::TuioStats::NUMBER_OF_PROFILES];
+        QString statsText_;
+    };
+}
+
+#endif
@@ -258,6 +258,7 @@ void TuioClient::processTuio2DblbAliveMessage( ReceivedMessageArgumentStream & a
         args >> s_sessionID;
         aliveBlobList_.push_back( (long)s_sessionID );
     }
+    stats_.setAliveCount( TuioStats::BLOB_PROFILE, (int)aliveBlobList_.size() );
 }
 
 void TuioClient::processTuio2DblbFseqMessage( ReceivedMessageArgumentStream & args )
@@ -274,6 +275,9 @@ void TuioClient::processTuio2DblbFseqMessage( ReceivedMessageArgumentStream & ar
     else if( (TuioTime::getSessionTime().getTotalMilliseconds() - currentTime_.getTotalMilliseconds()) > 100 ) {
         currentTime_ = TuioTime::getSessionTime();
     }
+    if( lateFrame ) { stats_.addLateFrame( TuioStats::BLOB_PROFILE ); }
+    else { stats_.addFrame( TuioStats::BLOB_PROFILE, fseq ); }
+
     if( !lateFrame ) {
         lockBlobList();
 
@@ -479,6 +483,7 @@ void TuioClient::processTuio2DcurAliveMessage( ReceivedMessageArgumentStream & a
         args >> s_id;
         aliveCursorList_.push_back( (long)s_id );
     }
+    stats_.setAliveCount( TuioStats::CURSOR_PROFILE, (int)aliveCursorList_.size() );
 }
 
 void TuioClient::processTuio2DcurFseqMessage( ReceivedMessageArgumentStream & args )
@@ -495,6 +500,9 @@ void TuioClient::processTuio2DcurFseqMessage( ReceivedMessageArgumentStream & ar
     else if( (TuioTime::getSessionTime().getTotalMilliseconds() - currentTime_.getTotalMilliseconds()) > 100 ) {
         currentTime_ = TuioTime::getSessionTime();
     }
+    if( lateFrame ) { stats_.addLateFrame( TuioStats::CURSOR_PROFILE ); }
+    else { stats_.addFrame( TuioStats::CURSOR_PROFILE, fseq ); }
+
     if( !lateFrame ) {
         lockCursorList();
 
@@ -639,6 +647,7 @@ void TuioClient::processTuio2DcurFseqMessage( ReceivedMessageArgumentStream & ar
 void TuioClient::ProcessPacket( const char *data, int size, const IpEndpointName& remoteEndpoint ) 
 {
     try {
+        stats_.addDatagram( size );
         ReceivedPacket p( data, size );
         if(p.IsBundle()) ProcessBundle( ReceivedBundle(p), remoteEndpoint);
         else ProcessMessage( ReceivedMessage(p), remoteEndpoint);
@@ -703,6 +712,7 @@ void TuioClient::processTuio2DobjAliveMessage( osc::ReceivedMessageArgumentStrea
         args >> s_id;
         aliveObjectList_.push_back( (long)s_id );
     }
+    stats_.setAliveCount( TuioStats::OBJECT_PROFILE, (int)aliveObjectList_.size() );
 }
 
 void TuioClient::processTuio2DobjFseqMessage( osc::ReceivedMessageArgumentStream & args )
@@ -719,6 +729,9 @@ void TuioClient::processTuio2DobjFseqMessage( osc::ReceivedMessageArgumentStream
     else if( (TuioTime::getSessionTime().getTotalMilliseconds() - currentTime_.getTotalMilliseconds()) > 100 ) {
         currentTime_ = TuioTime::getSessionTime();
     }
+    if( lateFrame ) { stats_.addLateFrame( TuioStats::OBJECT_PROFILE ); }
+    else { stats_.addFrame( TuioStats::OBJECT_PROFILE, fseq ); }
+
     if( !lateFrame ) {
         lockObjectList();
 
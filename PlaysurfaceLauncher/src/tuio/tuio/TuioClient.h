@@ -41,6 +41,7 @@
 #include "TuioObject.h"
 #include "TuioCursor.h"
 #include "TuioBlob.h"
+#include "TuioStats.h"
 
 namespace TUIO 
 {
@@ -199,6 +200,22 @@ namespace TUIO
          */
         void allowTuioProfileFiltering( bool b );
 
+        /**
+         * Returns the counters for the TUIO messages received so far.  They
+         * are updated without locking, so they may be read from any thread.
+         *
+         * @return  the counters for this TuioClient
+         */
+        TuioStats & getStats() { return stats_; }
+
+        /**
+         * Returns the sequence number (fseq) of the newest frame received.
+         * The same number is reported for every profile's part of a frame.
+         *
+         * @return  the current frame's sequence number, or -1 before the first frame
+         */
+        int getCurrentFrame() { return currentFrame_; }
+
         UdpListeningReceiveSocket * socket;
                 
     protected:
@@ -251,6 +268,7 @@ namespace TUIO
         
         osc::int32 currentFrame_;
         TuioTime currentTime_;
+        TuioStats stats_;
             
         std::list<TuioCursor *> freeCursorList_;
         std::list<TuioCursor *> freeCursorBuffer_;
@@ -0,0 +1,145 @@
+/*******************************************************************************
+TuioStats
+
+PURPOSE: Lock-free counters for the TUIO messages received by a TuioClient
+         (frames, late frames, frame number gaps, datagram sizes, and active
+         sessions).
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "TuioStats.h"
+
+using namespace TUIO;
+
+TuioStats::Snapshot::Snapshot() :
+  datagrams( 0 ),
+  datagramBytes( 0 ),
+  maxDatagramBytes( 0 )
+{
+    for( int i = 0; i < NUMBER_OF_PROFILES; ++i ) {
+        frames[i] = 0;
+        lateFrames[i] = 0;
+        gaps[i] = 0;
+        skippedFrames[i] = 0;
+        aliveCount[i] = 0;
+    }
+}
+
+const char * TuioStats::profileName( Profile profile )
+{
+    switch( profile ) {
+        case OBJECT_PROFILE:  return "2Dobj";
+        case CURSOR_PROFILE:  return "2Dcur";
+        case BLOB_PROFILE:    return "2Dblb";
+        default:              return "unknown";
+    }
+}
+
+TuioStats::TuioStats()
+{
+    datagrams_.store( 0 );
+    datagramBytes_.store( 0 );
+    maxDatagramBytes_.store( 0 );
+
+    for( int i = 0; i < NUMBER_OF_PROFILES; ++i ) {
+        frames_[i].store( 0 );
+        lateFrames_[i].store( 0 );
+        gaps_[i].store( 0 );
+        skippedFrames_[i].store( 0 );
+        aliveCount_[i].store( 0 );
+        lastFseq_[i] = -1;
+    }
+}
+
+TuioStats::~TuioStats()
+{
+}
+
+void TuioStats::addDatagram( int size )
+{
+    datagrams_.fetch_add( 1, std::memory_order_relaxed );
+    datagramBytes_.fetch_add( (unsigned int)size, std::memory_order_relaxed );
+    unsigned int max = maxDatagramBytes_.load( std::memory_order_relaxed );
+
+    // The loop only repeats if snapshot() reset the maximum in between.
+    while( (unsigned int)size > max
+           && !maxDatagramBytes_.compare_exchange_weak( max, (unsigned int)size, std::memory_order_relaxed ) )
+    {
+    }
+}
+
+/**
+ * Trackers that do not number their frames send an fseq of -1, so only
+ * positive frame numbers are checked for gaps.  A frame number that goes
+ * backwards (the tracker was restarted) just starts over.
+ */
+void TuioStats::addFrame( Profile profile, osc::int32 fseq )
+{
+    frames_[profile].fetch_add( 1, std::memory_order_relaxed );
+
+    if( fseq > 0 ) {
+        osc::int32 last = lastFseq_[profile];
+
+        if( last > 0 && fseq > last + 1 ) {
+            gaps_[profile].fetch_add( 1, std::memory_order_relaxed );
+            skippedFrames_[profile].fetch_add( (unsigned int)(fseq - last - 1), std::memory_order_relaxed );
+        }
+        lastFseq_[profile] = fseq;
+    }
+}
+
+void TuioStats::addLateFrame( Profile profile )
+{
+    lateFrames_[profile].fetch_add( 1, std::memory_order_relaxed );
+}
+
+void TuioStats::setAliveCount( Profile profile, int count )
+{
+    aliveCount_[profile].store( count, std::memory_order_relaxed );
+}
+
+int TuioStats::aliveCount( Profile profile )
+{
+    return aliveCount_[profile].load( std::memory_order_relaxed );
+}
+
+TuioStats::Snapshot TuioStats::snapshot()
+{
+    Snapshot s;
+    s.datagrams = datagrams_.load( std::memory_order_relaxed );
+    s.datagramBytes = datagramBytes_.load( std::memory_order_relaxed );
+    s.maxDatagramBytes = maxDatagramBytes_.exchange( 0, std::memory_order_relaxed );
+
+    for( int i = 0; i < NUMBER_OF_PROFILES; ++i ) {
+        s.frames[i] = frames_[i].load( std::memory_order_relaxed );
+        s.lateFrames[i] = lateFrames_[i].load( std::memory_order_relaxed );
+        s.gaps[i] = gaps_[i].load( std::memory_order_relaxed );
+        s.skippedFrames[i] = skippedFrames_[i].load( std::memory_order_relaxed );
+        s.aliveCount[i] = aliveCount_[i].load( std::memory_order_relaxed );
+    }
+    return s;
+}
@@ -0,0 +1,112 @@
+/*******************************************************************************
+TuioStats
+
+PURPOSE: Lock-free counters for the TUIO messages received by a TuioClient
+         (frames, late frames, frame number gaps, datagram sizes, and active
+         sessions).
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef INCLUDED_TUIOSTATS_H
+#define INCLUDED_TUIOSTATS_H
+
+#include "osc/OscTypes.h"
+#include <atomic>
+
+namespace TUIO
+{
+    /**
+     * Counts what arrives at a TuioClient: datagrams and their sizes, and for
+     * each profile the frames (fseq messages), the late frames that were
+     * dropped, the gaps in the frame numbers, and the size of the last alive
+     * list (the number of active sessions).
+     *
+     * The counters are only written by the thread that receives the TUIO
+     * messages, and they are atomics, so another thread can take a snapshot()
+     * at any time without locking the receive path.  The counters only go up
+     * (and wrap around), so a reader works out rates from the difference
+     * between two snapshots.  The largest datagram is the only value that is
+     * reset, by each snapshot.
+     */
+    class TuioStats
+    {
+    public:
+        enum Profile
+        {
+            OBJECT_PROFILE,
+            CURSOR_PROFILE,
+            BLOB_PROFILE,
+            NUMBER_OF_PROFILES
+        };
+
+        /**
+         * A copy of the counters at one moment.
+         */
+        class Snapshot
+        {
+        public:
+            Snapshot();
+
+            unsigned int datagrams,
+                         datagramBytes,
+                         maxDatagramBytes;
+            unsigned int frames[NUMBER_OF_PROFILES],
+                         lateFrames[NUMBER_OF_PROFILES],
+                         gaps[NUMBER_OF_PROFILES],
+                         skippedFrames[NUMBER_OF_PROFILES];
+            int aliveCount[NUMBER_OF_PROFILES];
+        };
+
+        static const char * profileName( Profile profile );
+
+        TuioStats();
+        ~TuioStats();
+
+        void addDatagram( int size );
+        void addFrame( Profile profile, osc::int32 fseq );
+        void addLateFrame( Profile profile );
+        void setAliveCount( Profile profile, int count );
+        int aliveCount( Profile profile );
+        Snapshot snapshot();
+
+    private:
+        TuioStats( const TuioStats & );
+        TuioStats & operator=( const TuioStats & );
+
+        std::atomic<unsigned int> datagrams_,
+                                  datagramBytes_,
+                                  maxDatagramBytes_;
+        std::atomic<unsigned int> frames_[NUMBER_OF_PROFILES],
+                                  lateFrames_[NUMBER_OF_PROFILES],
+                                  gaps_[NUMBER_OF_PROFILES],
+                                  skippedFrames_[NUMBER_OF_PROFILES];
+        std::atomic<int> aliveCount_[NUMBER_OF_PROFILES];
+        osc::int32 lastFseq_[NUMBER_OF_PROFILES]; // Only used by the receiving thread.
+    };
+};
+
+#endif /* INCLUDED_TUIOSTATS_H */
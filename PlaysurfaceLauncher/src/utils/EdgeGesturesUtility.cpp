@@ -34,9 +34,9 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 */
 #include "utils/EdgeGesturesUtility.h"
 #include "utils/WindowUtility.h"
+#include "utils/WindowReadiness.h"
 #include "utils/StopWatch.h"
 #include <QApplication>
-#include <QTimer>
 #include <Windows.h>
 #include <Propsys.h>
 #include <Propkey.h>
@@ -44,25 +44,12 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #include <iostream>
 
 using utils::EdgeGesturesUtility;
+using utils::WindowUtility;
 
-const int EdgeGesturesUtility::TIME_INTERVAL_MILLISEC = 100,
-          EdgeGesturesUtility::NUMBER_OF_ATTEMPTS = 300;
+const int EdgeGesturesUtility::FULLSCREEN_TIMEOUT_MILLISEC = 30000;
 
 static bool s_edgeGesturesDisabled_ = false;
 
-static bool isFullscreenWindow( HWND hwnd )
-{
-    RECT windowRect,
-         desktopRect;
-    GetWindowRect( hwnd, &windowRect );
-    GetWindowRect( GetDesktopWindow(), &desktopRect );
-
-    return (windowRect.left == desktopRect.left)
-        && (windowRect.top == desktopRect.top)
-        && (windowRect.right == desktopRect.right)
-        && (windowRect.bottom == desktopRect.bottom);
-}
-
 static void printWindowRect( HWND hwnd )
 {
     RECT windowRect;
@@ -80,7 +67,7 @@ static void printWindowInfo( DWORD pid, HWND hwnd )
     std::cout << "pid = " << pid
               << " and hwnd = " << hwnd << "\n"
               << "windowVisible = " << IsWindowVisible( hwnd ) 
-              << " and windowFullscreen = " << isFullscreenWindow( hwnd ) << "\n";
+              << " and windowFullscreen = " << WindowUtility::isFullscreenWindow( hwnd ) << "\n";
 
     printWindowRect( hwnd );
 }
@@ -117,7 +104,7 @@ static BOOL CALLBACK disableEdgeGesturesWhenFullscreen( HWND hwnd, LPARAM lParam
     if( windowParentPid == targetPid ) {
         //printWindowInfo( targetPid, hwnd );
 
-        if( IsWindowVisible( hwnd ) && isFullscreenWindow( hwnd ) ) {
+        if( IsWindowVisible( hwnd ) && WindowUtility::isFullscreenWindow( hwnd ) ) {
             //printWindowInfo( targetPid, hwnd );
             disableTouchBasedEdgeGestures( hwnd );
         }
@@ -125,13 +112,14 @@ static BOOL CALLBACK disableEdgeGesturesWhenFullscreen( HWND hwnd, LPARAM lParam
     return TRUE; // Continue the enumeration.
 }
 
-EdgeGesturesUtility::EdgeGesturesUtility() :
+EdgeGesturesUtility::EdgeGesturesUtility( utils::WindowReadiness * windowReadiness ) :
   stopWatch_( new utils::StopWatch() ),
+  windowReadiness_( windowReadiness ),
   fullscreenAppPid_( 0 ),
-  playsurfaceLauncherPid_( 0 ),
-  fullscreenAppCountdown_( 0 ),
-  playsurfaceLauncherCountdown_( 0 )
+  playsurfaceLauncherPid_( 0 )
 {
+    connect( windowReadiness_, SIGNAL( windowReady( unsigned long, int ) ),
+             this, SLOT( onWindowReady( unsigned long, int ) ) );
 }
 
 EdgeGesturesUtility::~EdgeGesturesUtility()
@@ -139,34 +127,20 @@ EdgeGesturesUtility::~EdgeGesturesUtility()
     delete stopWatch_;
 }
 
+/***************************************************************************//**
+Edge gestures can only be disabled once the app has a fullscreen window, so 
+if it does not have one yet, the WindowReadiness is asked to report when it 
+does.
+*******************************************************************************/
 void EdgeGesturesUtility::disableFullscreenAppEdgeGestures( unsigned long int pid )
 {
     //std::cout << "\nEdgeGesturesUtility::disableFullscreenAppEdgeGestures(" << pid << ")\n";
     fullscreenAppPid_ = pid;
-    fullscreenAppCountdown_ = NUMBER_OF_ATTEMPTS;
-    disableFullscreenAppEdgeGestures();
-}
 
-void EdgeGesturesUtility::disableFullscreenAppEdgeGestures()
-{
-    if( fullscreenAppCountdown_ > 0  ) {
-        --fullscreenAppCountdown_;
-
-        if( fullscreenAppPid_ != 0 ) {
-            s_edgeGesturesDisabled_ = false;
-            EnumWindows( disableEdgeGesturesWhenFullscreen, reinterpret_cast<LPARAM>(&fullscreenAppPid_) );
-
-            if( s_edgeGesturesDisabled_ ) {
-                //std::cout << "Edge gestures disabled for pid " << fullscreenAppPid_ << ".\n";
-                fullscreenAppCountdown_ = 0;
-            }
-            else { // Try again after a fraction of a second.
-                //std::cout << "Will try again in " << TIME_INTERVAL_MILLISEC << " milliseconds.\n";
-                QTimer::singleShot( TIME_INTERVAL_MILLISEC,
-                                    this,
-                                    SLOT( disableFullscreenAppEdgeGestures() ) );
-            }
-        }
+    if( !disableEdgeGestures( fullscreenAppPid_ ) ) {
+        windowReadiness_->watch( fullscreenAppPid_, 
+                                 utils::WindowReadiness::FULLSCREEN, 
+                                 FULLSCREEN_TIMEOUT_MILLISEC );
     }
 }
 
@@ -174,29 +148,35 @@ void EdgeGesturesUtility::disablePlaysurfaceLauncherEdgeGestures()
 {
     //std::cout << "\nEdgeGesturesUtility::disablePlaysurfaceLauncherEdgeGestures() called...\n";
     playsurfaceLauncherPid_ = (unsigned long)QApplication::instance()->applicationPid();
-    playsurfaceLauncherCountdown_ = NUMBER_OF_ATTEMPTS;
-    disablePlaysurfaceEdgeGestures();
+
+    if( !disableEdgeGestures( playsurfaceLauncherPid_ ) ) {
+        windowReadiness_->watch( playsurfaceLauncherPid_, 
+                                 utils::WindowReadiness::FULLSCREEN, 
+                                 FULLSCREEN_TIMEOUT_MILLISEC );
+    }
 }
 
-void EdgeGesturesUtility::disablePlaysurfaceEdgeGestures()
+void EdgeGesturesUtility::onWindowReady( unsigned long pid, int condition )
 {
-    if( playsurfaceLauncherCountdown_ > 0  ) {
-        --playsurfaceLauncherCountdown_;
-
-        if( playsurfaceLauncherPid_ != 0 ) {
-            s_edgeGesturesDisabled_ = false;
-            EnumWindows( disableEdgeGesturesWhenFullscreen, reinterpret_cast<LPARAM>(&playsurfaceLauncherPid_) );
-
-            if( s_edgeGesturesDisabled_ ) {
-                //std::cout << "Edge gestures disabled for PlaysurfaceLauncher desktop.\n";
-                playsurfaceLauncherCountdown_ = 0;
-            }
-            else { // Try again after a fraction of a second.
-                //std::cout << "Will try again in " << TIME_INTERVAL_MILLISEC << " milliseconds.\n";
-                QTimer::singleShot( TIME_INTERVAL_MILLISEC,
-                                    this,
-                                    SLOT( disablePlaysurfaceEdgeGestures() ) );
-            }
-        }
+    if( condition == utils::WindowReadiness::FULLSCREEN
+        && pid != 0
+        && (pid == fullscreenAppPid_ || pid == playsurfaceLauncherPid_) ) 
+    {
+        disableEdgeGestures( pid );
+    }
+}
+
+/***************************************************************************//**
+Returns true if the process had a fullscreen window and its edge gestures 
+were disabled.
+*******************************************************************************/
+bool EdgeGesturesUtility::disableEdgeGestures( unsigned long pid )
+{
+    if( pid == 0 ) {
+        return false;
     }
+    s_edgeGesturesDisabled_ = false;
+    EnumWindows( disableEdgeGesturesWhenFullscreen, reinterpret_cast<LPARAM>(&pid) );
+    //std::cout << "Edge gestures disabled for pid " << pid << ": " << s_edgeGesturesDisabled_ << "\n";
+    return s_edgeGesturesDisabled_;
 }
@@ -40,6 +40,7 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 struct _PROCESS_INFORMATION;
 
 namespace utils { class StopWatch; }
+namespace utils { class WindowReadiness; }
 
 namespace utils
 {
@@ -48,26 +49,24 @@ namespace utils
         Q_OBJECT
 
     public:
-        static const int TIME_INTERVAL_MILLISEC,
-                         NUMBER_OF_ATTEMPTS;
+        static const int FULLSCREEN_TIMEOUT_MILLISEC;
 
-        EdgeGesturesUtility();
+        EdgeGesturesUtility( utils::WindowReadiness * windowReadiness );
         virtual ~EdgeGesturesUtility();
 
         void disableFullscreenAppEdgeGestures( unsigned long pid );
         void disablePlaysurfaceLauncherEdgeGestures();
 
     public slots:
-        void disableFullscreenAppEdgeGestures();
-        void disablePlaysurfaceEdgeGestures();
-
+        void onWindowReady( unsigned long pid, int condition );
 
     private:
+        bool disableEdgeGestures( unsigned long pid );
+
         utils::StopWatch * stopWatch_;
+        utils::WindowReadiness * windowReadiness_;
         unsigned long fullscreenAppPid_,
                       playsurfaceLauncherPid_;
-        int fullscreenAppCountdown_,
-            playsurfaceLauncherCountdown_;
     };
 }
 
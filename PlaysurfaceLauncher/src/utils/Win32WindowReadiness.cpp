@@ -0,0 +1,176 @@
+/*******************************************************************************
+Win32WindowReadiness
+
+PURPOSE: The Windows backend for WindowReadiness, driven by WinEvent hooks.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "utils/Win32WindowReadiness.h"
+#include "utils/WindowUtility.h"
+#include "logger/FileLogger.h"
+#include <Windows.h>
+
+using utils::Win32WindowReadiness;
+using utils::WindowUtility;
+
+static Win32WindowReadiness * s_instance_ = NULL;
+
+static bool meetsCondition( HWND hwnd, utils::WindowReadiness::Condition condition )
+{
+    if( !IsWindowVisible( hwnd ) ) {
+        return false;
+    }
+    if( condition == utils::WindowReadiness::FULLSCREEN ) {
+        return WindowUtility::isFullscreenWindow( hwnd );
+    }
+    return WindowUtility::isLargeWindow( hwnd, utils::WindowReadiness::LARGE_WINDOW_FRACTION );
+}
+
+/***************************************************************************//**
+The parameters for the EnumWindows() callback.
+*******************************************************************************/
+class ReadinessQuery
+{
+public:
+    DWORD pid;
+    utils::WindowReadiness::Condition condition;
+    bool ready;
+};
+
+static BOOL CALLBACK findReadyWindow( HWND hwnd, LPARAM lParam )
+{
+    ReadinessQuery * query = reinterpret_cast<ReadinessQuery *>(lParam);
+    DWORD windowProcessId = NULL;
+    GetWindowThreadProcessId( hwnd, &windowProcessId );
+
+    if( windowProcessId == query->pid && meetsCondition( hwnd, query->condition ) ) {
+        query->ready = true;
+        return FALSE; // End the enumeration.
+    }
+    return TRUE; // Continue the enumeration.
+}
+
+/***************************************************************************//**
+Only events for whole windows are of interest (not for the cursor, carets, 
+or controls inside a window), and the window must be a top-level window.
+*******************************************************************************/
+static void CALLBACK onWinEvent( HWINEVENTHOOK hook, DWORD event, HWND hwnd,
+                                 LONG idObject, LONG idChild,
+                                 DWORD eventThread, DWORD eventTime )
+{
+    if( s_instance_ != NULL 
+        && hwnd != NULL 
+        && idObject == OBJID_WINDOW 
+        && idChild == CHILDID_SELF
+        && GetAncestor( hwnd, GA_ROOT ) == hwnd )
+    {
+        s_instance_->onWindowEvent( hwnd );
+    }
+}
+
+Win32WindowReadiness::Win32WindowReadiness( QObject * parent ) :
+  WindowReadiness( parent ),
+  showHook_( NULL ),
+  locationHook_( NULL )
+{
+    s_instance_ = this;
+}
+
+Win32WindowReadiness::~Win32WindowReadiness()
+{
+    removeHooks();
+
+    if( s_instance_ == this ) {
+        s_instance_ = NULL;
+    }
+}
+
+/***************************************************************************//**
+Called for every top-level window that was shown, moved, or resized while 
+something is being watched.
+*******************************************************************************/
+void Win32WindowReadiness::onWindowEvent( HWND__ * hwnd )
+{
+    DWORD windowProcessId = NULL;
+    GetWindowThreadProcessId( hwnd, &windowProcessId );
+
+    if( isWatching( windowProcessId, LARGE ) && meetsCondition( hwnd, LARGE ) ) {
+        notifyReady( windowProcessId, LARGE );
+    }
+    if( isWatching( windowProcessId, FULLSCREEN ) && meetsCondition( hwnd, FULLSCREEN ) ) {
+        notifyReady( windowProcessId, FULLSCREEN );
+    }
+}
+
+bool Win32WindowReadiness::isReady( unsigned long pid, Condition condition )
+{
+    ReadinessQuery query;
+    query.pid = pid;
+    query.condition = condition;
+    query.ready = false;
+    EnumWindows( findReadyWindow, reinterpret_cast<LPARAM>(&query) );
+    return query.ready;
+}
+
+void Win32WindowReadiness::firstWatchAdded()
+{
+    DWORD flags = WINEVENT_OUTOFCONTEXT;
+
+    if( showHook_ == NULL ) {
+        showHook_ = SetWinEventHook( EVENT_OBJECT_SHOW, EVENT_OBJECT_SHOW, 
+                                     NULL, onWinEvent, 0, 0, flags );
+    }
+    if( locationHook_ == NULL ) {
+        locationHook_ = SetWinEventHook( EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_LOCATIONCHANGE, 
+                                         NULL, onWinEvent, 0, 0, flags );
+    }
+    if( showHook_ == NULL || locationHook_ == NULL ) {
+        logger::FileLogger::instance().writeWarning( 
+            "Win32WindowReadiness: could not install the window event hooks (windows are only acted on after the timeout)." );
+    }
+}
+
+/***************************************************************************//**
+The location hook sees every window move on the desktop, so the hooks are 
+only kept while something is being watched.
+*******************************************************************************/
+void Win32WindowReadiness::lastWatchRemoved()
+{
+    removeHooks();
+}
+
+void Win32WindowReadiness::removeHooks()
+{
+    if( showHook_ != NULL ) {
+        UnhookWinEvent( showHook_ );
+        showHook_ = NULL;
+    }
+    if( locationHook_ != NULL ) {
+        UnhookWinEvent( locationHook_ );
+        locationHook_ = NULL;
+    }
+}
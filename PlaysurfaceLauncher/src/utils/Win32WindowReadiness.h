@@ -0,0 +1,75 @@
+/*******************************************************************************
+Win32WindowReadiness
+
+PURPOSE: The Windows backend for WindowReadiness, driven by WinEvent hooks.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef UTILS_WIN32WINDOWREADINESS_H
+#define UTILS_WIN32WINDOWREADINESS_H
+
+#include "utils/WindowReadiness.h"
+
+struct HWINEVENTHOOK__;
+struct HWND__;
+
+namespace utils
+{
+    /***********************************************************************//**
+    The Windows backend for WindowReadiness.  While anything is watched, it 
+    installs out-of-context WinEvent hooks for windows being shown and being
+    moved or resized, so it is told about each window change instead of 
+    polling.  The hooks call back on the thread that installed them (the GUI
+    thread), through its message loop.
+
+    Only one Win32WindowReadiness may exist at a time, since the WinEvent 
+    callback has no user data and finds the object through a static pointer.
+    ***************************************************************************/
+    class Win32WindowReadiness : public WindowReadiness
+    {
+        Q_OBJECT
+
+    public:
+        Win32WindowReadiness( QObject * parent = NULL );
+        virtual ~Win32WindowReadiness();
+
+        void onWindowEvent( HWND__ * hwnd );
+
+    protected:
+        virtual bool isReady( unsigned long pid, Condition condition );
+        virtual void firstWatchAdded();
+        virtual void lastWatchRemoved();
+
+    private:
+        void removeHooks();
+
+        HWINEVENTHOOK__ * showHook_,
+                        * locationHook_;
+    };
+}
+
+#endif
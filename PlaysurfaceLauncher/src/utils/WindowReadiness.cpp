@@ -0,0 +1,160 @@
+/*******************************************************************************
+WindowReadiness
+
+PURPOSE: Tells when the main window of another process has appeared (or 
+         gone fullscreen), so actions can fire as soon as the window exists.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "utils/WindowReadiness.h"
+#include "logger/FileLogger.h"
+#include <QTimer>
+
+using utils::WindowReadiness;
+
+const double WindowReadiness::LARGE_WINDOW_FRACTION = 0.5;
+
+WindowReadiness::WindowReadiness( QObject * parent ) :
+  QObject( parent ),
+  watches_()
+{
+}
+
+WindowReadiness::~WindowReadiness()
+{
+    for( int i = 0; i < watches_.size(); ++i ) {
+        delete watches_.at( i ).timer;
+    }
+    watches_.clear();
+}
+
+void WindowReadiness::watch( unsigned long pid, Condition condition, int timeoutMilliseconds )
+{
+    if( pid == 0 || indexOf( pid, condition ) >= 0 ) {
+        return;
+    }
+    Watch w;
+    w.pid = pid;
+    w.condition = condition;
+    w.timer = new QTimer();
+    w.timer->setSingleShot( true );
+    connect( w.timer, SIGNAL( timeout() ), this, SLOT( onWatchTimedOut() ) );
+    watches_.append( w );
+
+    if( watches_.size() == 1 ) {
+        firstWatchAdded();
+    }
+    if( isReady( pid, condition ) ) {
+        notifyReady( pid, condition );
+    }
+    else {
+        w.timer->start( timeoutMilliseconds );
+    }
+}
+
+void WindowReadiness::unwatch( unsigned long pid )
+{
+    for( int i = watches_.size() - 1; i >= 0; --i ) {
+        if( watches_.at( i ).pid == pid ) {
+            removeWatch( i );
+        }
+    }
+}
+
+bool WindowReadiness::isWatching( unsigned long pid, Condition condition )
+{
+    return indexOf( pid, condition ) >= 0;
+}
+
+bool WindowReadiness::isWatching( unsigned long pid )
+{
+    return isWatching( pid, LARGE ) || isWatching( pid, FULLSCREEN );
+}
+
+int WindowReadiness::watchCount()
+{
+    return watches_.size();
+}
+
+void WindowReadiness::firstWatchAdded()
+{
+}
+
+void WindowReadiness::lastWatchRemoved()
+{
+}
+
+/***************************************************************************//**
+Drops the watch before the signal is emitted, so a slot connected to 
+windowReady() may watch the same process again.  Does nothing if the 
+process is not being watched for the condition.
+*******************************************************************************/
+void WindowReadiness::notifyReady( unsigned long pid, Condition condition )
+{
+    int index = indexOf( pid, condition );
+
+    if( index >= 0 ) {
+        removeWatch( index );
+        emit windowReady( pid, condition );
+    }
+}
+
+void WindowReadiness::onWatchTimedOut()
+{
+    for( int i = 0; i < watches_.size(); ++i ) {
+        if( watches_.at( i ).timer == sender() ) {
+            Watch w = watches_.at( i );
+            removeWatch( i );
+            QString message = "WindowReadiness: timed out waiting for a window from pid " 
+                            + QString::number( w.pid );
+            logger::FileLogger::instance().writeInfo( message.toStdString() );
+            emit windowTimedOut( w.pid, w.condition );
+            return;
+        }
+    }
+}
+
+int WindowReadiness::indexOf( unsigned long pid, Condition condition )
+{
+    for( int i = 0; i < watches_.size(); ++i ) {
+        if( watches_.at( i ).pid == pid && watches_.at( i ).condition == condition ) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void WindowReadiness::removeWatch( int index )
+{
+    Watch w = watches_.takeAt( index );
+    w.timer->stop();
+    w.timer->deleteLater();
+
+    if( watches_.isEmpty() ) {
+        lastWatchRemoved();
+    }
+}
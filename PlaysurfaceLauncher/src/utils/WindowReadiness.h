@@ -0,0 +1,120 @@
+/*******************************************************************************
+WindowReadiness
+
+PURPOSE: Tells when the main window of another process has appeared (or 
+         gone fullscreen), so actions can fire as soon as the window exists.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef UTILS_WINDOWREADINESS_H
+#define UTILS_WINDOWREADINESS_H
+
+#include <QObject>
+#include <QList>
+
+class QTimer;
+
+namespace utils
+{
+    /***********************************************************************//**
+    Tells when the window of another process is ready, so that the launcher 
+    can act on a window (focus it, hide it, disable its edge gestures) the
+    moment the window exists, instead of after a fixed delay.
+
+    watch() asks for a windowReady() signal once a top-level window of the 
+    process meets the condition.  If the condition is already met, the 
+    signal is emitted right away; if it is not met within the timeout, 
+    windowTimedOut() is emitted instead.  Either way, the watch is then 
+    dropped.  A process can be watched for several conditions at once.
+
+    A LARGE window is at least LARGE_WINDOW_FRACTION of the screen's width 
+    and height (a fullscreen window is large), which is how an app's main 
+    window is told apart from a splash screen or console window shown 
+    before it.
+
+    This base class does the bookkeeping.  A backend only has to say whether
+    a condition is met right now (isReady()) and call notifyReady() when the
+    window system reports a change; firstWatchAdded() and lastWatchRemoved()
+    let it listen for window events only while something is being watched.
+    Win32WindowReadiness is the only backend: the launcher only runs on 
+    Windows, and there is no unit test suite that a fake backend could serve.
+    ***************************************************************************/
+    class WindowReadiness : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        enum Condition
+        {
+            LARGE,
+            FULLSCREEN
+        };
+
+        static const double LARGE_WINDOW_FRACTION;
+
+        WindowReadiness( QObject * parent = NULL );
+        virtual ~WindowReadiness();
+
+        void watch( unsigned long pid, Condition condition, int timeoutMilliseconds );
+        void unwatch( unsigned long pid );
+        bool isWatching( unsigned long pid, Condition condition );
+        bool isWatching( unsigned long pid );
+        int watchCount();
+
+    signals:
+        void windowReady( unsigned long pid, int condition );
+        void windowTimedOut( unsigned long pid, int condition );
+
+    protected:
+        virtual bool isReady( unsigned long pid, Condition condition ) = 0;
+        virtual void firstWatchAdded();
+        virtual void lastWatchRemoved();
+        void notifyReady( unsigned long pid, Condition condition );
+
+    private slots:
+        void onWatchTimedOut();
+
+    private:
+        /*******************************************************************//**
+        One process and condition being watched.
+        ***********************************************************************/
+        class Watch
+        {
+        public:
+            unsigned long pid;
+            Condition condition;
+            QTimer * timer;
+        };
+
+        int indexOf( unsigned long pid, Condition condition );
+        void removeWatch( int index );
+
+        QList<Watch> watches_;
+    };
+}
+
+#endif
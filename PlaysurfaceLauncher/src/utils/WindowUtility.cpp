@@ -52,6 +52,37 @@ static const wchar_t TITLE_OF_TOUCHHOOKS2TUIO_WINDOW [] = TEXT( "TouchHooks2Tuio
 static const DWORD TITLE_LENGTH_FOR_TOUCHHOOKS2TUIO = 15;
 static unsigned long pidTouchHooks2Tuio_ = 0;
 
+/***************************************************************************//**
+True if the window covers exactly the desktop (the primary screen).
+*******************************************************************************/
+bool WindowUtility::isFullscreenWindow( HWND hwnd )
+{
+    RECT windowRect,
+         desktopRect;
+    GetWindowRect( hwnd, &windowRect );
+    GetWindowRect( GetDesktopWindow(), &desktopRect );
+
+    return (windowRect.left == desktopRect.left)
+        && (windowRect.top == desktopRect.top)
+        && (windowRect.right == desktopRect.right)
+        && (windowRect.bottom == desktopRect.bottom);
+}
+
+/***************************************************************************//**
+True if the window is at least the given fraction of the desktop's width and
+of its height (so a fullscreen window is always large).
+*******************************************************************************/
+bool WindowUtility::isLargeWindow( HWND hwnd, double minFraction )
+{
+    RECT windowRect,
+         desktopRect;
+    GetWindowRect( hwnd, &windowRect );
+    GetWindowRect( GetDesktopWindow(), &desktopRect );
+
+    return (windowRect.right - windowRect.left) >= minFraction * (desktopRect.right - desktopRect.left)
+        && (windowRect.bottom - windowRect.top) >= minFraction * (desktopRect.bottom - desktopRect.top);
+}
+
 WindowUtility::WindowUtility()
 {
 }
@@ -357,16 +388,3 @@ void WindowUtility::leftClickMouse()
     input.mi.dwFlags = MOUSEEVENTF_LEFTUP;
     ::SendInput( 1, &input, sizeof( INPUT ) );
 }
-
-static bool isFullscreenWindow( HWND hwnd )
-{
-    RECT windowRect,
-         desktopRect;
-    GetWindowRect( hwnd, &windowRect );
-    GetWindowRect( GetDesktopWindow(), &desktopRect );
-
-    return (windowRect.left == desktopRect.left)
-        && (windowRect.top == desktopRect.top)
-        && (windowRect.right == desktopRect.right)
-        && (windowRect.bottom == desktopRect.bottom);
-}
@@ -34,12 +34,16 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #define UTILS_WINDOWUTILITY_H
 
 struct _PROCESS_INFORMATION;
+struct HWND__;
 
 namespace utils
 {
     class WindowUtility
     {
     public:
+        static bool isFullscreenWindow( HWND__ * hwnd );
+        static bool isLargeWindow( HWND__ * hwnd, double minFraction );
+
         WindowUtility();
         virtual ~WindowUtility();
 
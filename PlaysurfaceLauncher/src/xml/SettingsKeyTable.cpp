@@ -0,0 +1,187 @@
+/*******************************************************************************
+SettingsKeyTable
+
+PURPOSE: Maps the tags of the settings file to the SettingsValidator functions
+         that store their values, using a perfect hash.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "xml/SettingsKeyTable.h"
+#include "xml/SettingsValidator.h"
+#include <QLatin1String>
+
+using xml::SettingsKeyTable;
+using xml::SettingsValidator;
+
+const char * const SettingsKeyTable::ROOT_TAG = "PlaysurfaceLauncherSettings";
+
+/***************************************************************************//**
+Every tag the settings file may contain.  To add a setting, add a line here
+(and the setter to the SettingsValidator); the hash table is rebuilt from
+this list on start-up.
+*******************************************************************************/
+static const SettingsKeyTable::Key KEYS[] = 
+{
+    { SettingsKeyTable::ROOT_SECTION,     "Options",                  NULL,                                                   SettingsKeyTable::OPTIONS_SECTION },
+    { SettingsKeyTable::ROOT_SECTION,     "Gestures",                 NULL,                                                   SettingsKeyTable::GESTURES_SECTION },
+
+    { SettingsKeyTable::OPTIONS_SECTION,  "TouchDetection",           &SettingsValidator::setTuioSource,                      SettingsKeyTable::NO_SECTION },
+    { SettingsKeyTable::OPTIONS_SECTION,  "ShowShutdownComputerIcon", &SettingsValidator::showShutdownComputerIcon,           SettingsKeyTable::NO_SECTION },
+    { SettingsKeyTable::OPTIONS_SECTION,  "UseOpenGLRenderer",        &SettingsValidator::useOpenGLRenderer,                  SettingsKeyTable::NO_SECTION },
+    { SettingsKeyTable::OPTIONS_SECTION,  "WarmStart",                &SettingsValidator::useWarmStart,                       SettingsKeyTable::NO_SECTION },
+    { SettingsKeyTable::OPTIONS_SECTION,  "WarmStartApps",            &SettingsValidator::setWarmStartApps,                   SettingsKeyTable::NO_SECTION },
+    { SettingsKeyTable::OPTIONS_SECTION,  "MetricsPort",              &SettingsValidator::setMetricsPort,                     SettingsKeyTable::NO_SECTION },
+
+    { SettingsKeyTable::GESTURES_SECTION, "UsePlusSignToQuitApps",    &SettingsValidator::usePlusGestureToQuitApps,           SettingsKeyTable::NO_SECTION },
+    { SettingsKeyTable::GESTURES_SECTION, "MinNumPoints",             &SettingsValidator::setGestureMinNumPoints,             SettingsKeyTable::NO_SECTION },
+    { SettingsKeyTable::GESTURES_SECTION, "ExpirationMilliseconds",   &SettingsValidator::setGestureExpirationMilliseconds,   SettingsKeyTable::NO_SECTION },
+    { SettingsKeyTable::GESTURES_SECTION, "ValidLineAspectRatio",     &SettingsValidator::setGestureValidLineAspectRatio,     SettingsKeyTable::NO_SECTION },
+    { SettingsKeyTable::GESTURES_SECTION, "ToleranceFactor",          &SettingsValidator::setGestureToleranceFactor,          SettingsKeyTable::NO_SECTION }
+};
+
+static const int NUMBER_OF_KEYS = (int)(sizeof( KEYS ) / sizeof( KEYS[0] ));
+
+/***************************************************************************//**
+One step of a 32-bit FNV-1a hash, with ASCII letters folded to lower case.
+*******************************************************************************/
+static inline unsigned int mix( unsigned int h, unsigned int c )
+{
+    if( c >= 'A' && c <= 'Z' ) {
+        c += 'a' - 'A';
+    }
+    return (h ^ c) * 16777619u;
+}
+
+/***************************************************************************//**
+The table is only used on the GUI thread.
+*******************************************************************************/
+const SettingsKeyTable & SettingsKeyTable::instance()
+{
+    static SettingsKeyTable instance;
+    return instance;
+}
+
+/***************************************************************************//**
+Starts with twice as many slots as keys and tries seeds until the hash is
+perfect.  If no seed works (which has not happened with the keys above),
+the number of slots is doubled and the search starts over.
+*******************************************************************************/
+SettingsKeyTable::SettingsKeyTable() :
+  slots_(),
+  seed_( 0 ),
+  mask_( 0 )
+{
+    unsigned int size = 2;
+
+    while( size < 2 * (unsigned int)NUMBER_OF_KEYS ) {
+        size *= 2;
+    }
+    while( true ) {
+        slots_.assign( size, (const Key *)NULL );
+        mask_ = size - 1;
+
+        for( unsigned int seed = 1; seed <= 100000; ++seed ) {
+            if( tryToFillSlots( seed ) ) {
+                seed_ = seed;
+                return;
+            }
+        }
+        size *= 2;
+    }
+}
+
+bool SettingsKeyTable::tryToFillSlots( unsigned int seed )
+{
+    slots_.assign( slots_.size(), (const Key *)NULL );
+
+    for( int i = 0; i < NUMBER_OF_KEYS; ++i ) {
+        unsigned int slot = hash( seed, KEYS[i].section, KEYS[i].tag ) & mask_;
+
+        if( slots_[slot] != NULL ) {
+            return false;
+        }
+        slots_[slot] = &KEYS[i];
+    }
+    return true;
+}
+
+unsigned int SettingsKeyTable::hash( unsigned int seed, Section section, const QStringRef & tag )
+{
+    unsigned int h = mix( 2166136261u ^ seed, (unsigned int)section );
+
+    for( int i = 0; i < tag.size(); ++i ) {
+        h = mix( h, tag.at( i ).unicode() );
+    }
+    return h;
+}
+
+unsigned int SettingsKeyTable::hash( unsigned int seed, Section section, const char * tag )
+{
+    unsigned int h = mix( 2166136261u ^ seed, (unsigned int)section );
+
+    for( ; *tag != '\0'; ++tag ) {
+        h = mix( h, (unsigned char)*tag );
+    }
+    return h;
+}
+
+/***************************************************************************//**
+Returns the key for a tag found in the given section, or NULL if the tag is 
+not allowed there.
+*******************************************************************************/
+const SettingsKeyTable::Key * SettingsKeyTable::find( Section section, const QStringRef & tag ) const
+{
+    const Key * key = slots_[hash( seed_, section, tag ) & mask_];
+
+    if( key != NULL 
+        && key->section == section 
+        && tag.compare( QLatin1String( key->tag ), Qt::CaseInsensitive ) == 0 )
+    {
+        return key;
+    }
+    return NULL;
+}
+
+bool SettingsKeyTable::isRootTag( const QStringRef & tag ) const
+{
+    return (tag.compare( QLatin1String( ROOT_TAG ), Qt::CaseInsensitive ) == 0);
+}
+
+int SettingsKeyTable::numberOfKeys() const
+{
+    return NUMBER_OF_KEYS;
+}
+
+int SettingsKeyTable::numberOfSlots() const
+{
+    return (int)slots_.size();
+}
+
+unsigned int SettingsKeyTable::seed() const
+{
+    return seed_;
+}
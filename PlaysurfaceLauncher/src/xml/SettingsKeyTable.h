@@ -0,0 +1,106 @@
+/*******************************************************************************
+SettingsKeyTable
+
+PURPOSE: Maps the tags of the settings file to the SettingsValidator functions
+         that store their values, using a perfect hash.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef XML_SETTINGSKEYTABLE_H
+#define XML_SETTINGSKEYTABLE_H
+
+#include <QStringRef>
+#include <vector>
+
+namespace xml { class SettingsValidator; }
+
+namespace xml
+{
+    /***********************************************************************//**
+    Maps each tag of the settings file to the SettingsValidator function that
+    validates and stores its value, so that the SettingsXmlReader dispatches
+    a tag with one hash and one comparison instead of a chain of string
+    comparisons.
+
+    The tags are listed once, in the KEYS array in SettingsKeyTable.cpp.  The
+    hash table is generated from that list the first time the table is used:
+    seeds are tried until one hashes every (section, tag) pair to a slot of
+    its own, which makes the hash perfect, so a lookup never probes a second
+    slot.  The hash ignores case (as the settings file always has), and reads
+    the tag in place, so a lookup does not allocate.
+    ***************************************************************************/
+    class SettingsKeyTable
+    {
+    public:
+        enum Section
+        {
+            NO_SECTION,
+            ROOT_SECTION,
+            OPTIONS_SECTION,
+            GESTURES_SECTION
+        };
+
+        typedef void (xml::SettingsValidator::*Setter)( const QString & tagValue );
+
+        /*******************************************************************//**
+        A tag that is allowed inside the given section.  A tag either opens
+        another section (such as <Options>) or holds a value that is given
+        to its setter.
+        ***********************************************************************/
+        class Key
+        {
+        public:
+            Section section;
+            const char * tag;
+            Setter setter;
+            Section opensSection;
+        };
+
+        static const char * const ROOT_TAG;
+
+        static const SettingsKeyTable & instance();
+
+        const Key * find( Section section, const QStringRef & tag ) const;
+        bool isRootTag( const QStringRef & tag ) const;
+        int numberOfKeys() const;
+        int numberOfSlots() const;
+        unsigned int seed() const;
+
+    private:
+        SettingsKeyTable();
+
+        static unsigned int hash( unsigned int seed, Section section, const QStringRef & tag );
+        static unsigned int hash( unsigned int seed, Section section, const char * tag );
+        bool tryToFillSlots( unsigned int seed );
+
+        std::vector<const Key *> slots_;
+        unsigned int seed_,
+                     mask_;
+    };
+}
+
+#endif
@@ -31,16 +31,37 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
  Boston, MA  02111-1307  USA
 */
 #include "xml/SettingsValidator.h"
+#include "gestures/GestureParams.h"
 #include "exceptions/ValidatorException.h"
 
 using xml::SettingsValidator;
 using exceptions::ValidatorException;
 
+const int SettingsValidator::MIN_GESTURE_NUM_POINTS = 2,
+          SettingsValidator::MAX_GESTURE_NUM_POINTS = 200,
+          SettingsValidator::MIN_GESTURE_EXPIRATION_MILLISECONDS = 500,
+          SettingsValidator::MAX_GESTURE_EXPIRATION_MILLISECONDS = 60000,
+          SettingsValidator::MIN_METRICS_PORT = 0,
+          SettingsValidator::MAX_METRICS_PORT = 65535;
+
+const double SettingsValidator::MIN_GESTURE_ASPECT_RATIO = 2.0,
+             SettingsValidator::MAX_GESTURE_ASPECT_RATIO = 100.0,
+             SettingsValidator::MIN_GESTURE_TOLERANCE_FACTOR = 0.05,
+             SettingsValidator::MAX_GESTURE_TOLERANCE_FACTOR = 1.0;
+
 SettingsValidator::SettingsValidator() :
   xmlConfigFilename_(),
   usePlusGestureToQuitApps_( false ),
   showShutdownComputerIcon_( false ),
-  tuioSource_( enums::TuioSourceEnum::BIG_BLOBBY )
+  useOpenGLRenderer_( false ),
+  useWarmStart_( false ),
+  warmStartApps_(),
+  tuioSource_( enums::TuioSourceEnum::BIG_BLOBBY ),
+  metricsPort_( 0 ),
+  gestureMinNumPoints_( gestures::GestureParams::DEFAULT_MIN_NUM_POINTS ),
+  gestureExpirationMilliseconds_( gestures::GestureParams::DEFAULT_EXPIRATION_MILLISECONDS ),
+  gestureValidLineAspectRatio_( gestures::GestureParams::DEFAULT_VALID_LINE_ASPECT_RATIO ),
+  gestureToleranceFactor_( gestures::GestureParams::DEFAULT_TOLERANCE_FACTOR )
 {
 }
 
@@ -145,3 +166,237 @@ void SettingsValidator::showShutdownComputerIcon( bool b )
 {
     showShutdownComputerIcon_ = b;
 }
+
+void SettingsValidator::useOpenGLRenderer( const QString & tagValue )
+{
+    QString b = tagValue.trimmed().toLower();
+
+    if( b == "true" ) {
+        useOpenGLRenderer_ = true;
+    }
+    else if( b == "false" ) {
+        useOpenGLRenderer_ = false;
+    }
+    else {
+        throw ValidatorException( "Invalid startup setting detected.",
+                                  "SettingsValidator::useOpenGLRenderer()",
+                                  "useOpenGLRenderer",
+                                  tagValue,
+                                  "true or false",
+                                  xmlConfigFilename_ );
+    }
+}
+
+bool SettingsValidator::useOpenGLRenderer()
+{
+    return useOpenGLRenderer_;
+}
+
+void SettingsValidator::useOpenGLRenderer( bool b )
+{
+    useOpenGLRenderer_ = b;
+}
+
+void SettingsValidator::useWarmStart( const QString & tagValue )
+{
+    QString b = tagValue.trimmed().toLower();
+
+    if( b == "true" ) {
+        useWarmStart_ = true;
+    }
+    else if( b == "false" ) {
+        useWarmStart_ = false;
+    }
+    else {
+        throw ValidatorException( "Invalid startup setting detected.",
+                                  "SettingsValidator::useWarmStart()",
+                                  "useWarmStart",
+                                  tagValue,
+                                  "true or false",
+                                  xmlConfigFilename_ );
+    }
+}
+
+bool SettingsValidator::useWarmStart()
+{
+    return useWarmStart_;
+}
+
+void SettingsValidator::useWarmStart( bool b )
+{
+    useWarmStart_ = b;
+}
+
+/***************************************************************************//**
+The apps are given as a comma-separated list of the names of their 
+subdirectories in the MultitouchApps directory.  An empty list means the
+few most recently launched apps (see AppLauncher::useWarmStart()).
+*******************************************************************************/
+void SettingsValidator::setWarmStartApps( const QString & tagValue )
+{
+    QStringList appNames = tagValue.split( ",", QString::SkipEmptyParts );
+    warmStartApps_.clear();
+
+    for( int i = 0; i < appNames.size(); ++i ) {
+        QString appName = appNames.at( i ).trimmed();
+
+        if( appName.contains( "/" ) || appName.contains( "\\" ) ) {
+            throw ValidatorException( "Invalid startup setting detected.",
+                                      "SettingsValidator::setWarmStartApps()",
+                                      "warmStartApps",
+                                      tagValue,
+                                      "names of MultitouchApps subdirectories, separated by commas",
+                                      xmlConfigFilename_ );
+        }
+        if( !appName.isEmpty() ) {
+            warmStartApps_.append( appName );
+        }
+    }
+}
+
+QStringList SettingsValidator::warmStartApps()
+{
+    return warmStartApps_;
+}
+
+void SettingsValidator::setWarmStartApps( const QStringList & appNames )
+{
+    warmStartApps_ = appNames;
+}
+
+/***************************************************************************//**
+The port of the metrics endpoint on localhost, or 0 for no endpoint.
+*******************************************************************************/
+void SettingsValidator::setMetricsPort( const QString & tagValue )
+{
+    metricsPort_ = convertToInt( tagValue, 
+                                 MIN_METRICS_PORT, 
+                                 MAX_METRICS_PORT,
+                                 "SettingsValidator::setMetricsPort()",
+                                 "metricsPort" );
+}
+
+int SettingsValidator::metricsPort()
+{
+    return metricsPort_;
+}
+
+void SettingsValidator::setMetricsPort( int port )
+{
+    metricsPort_ = port;
+}
+
+void SettingsValidator::setGestureMinNumPoints( const QString & tagValue )
+{
+    gestureMinNumPoints_ = convertToInt( tagValue, 
+                                         MIN_GESTURE_NUM_POINTS, 
+                                         MAX_GESTURE_NUM_POINTS,
+                                         "SettingsValidator::setGestureMinNumPoints()",
+                                         "gestureMinNumPoints" );
+}
+
+int SettingsValidator::gestureMinNumPoints()
+{
+    return gestureMinNumPoints_;
+}
+
+void SettingsValidator::setGestureMinNumPoints( int n )
+{
+    gestureMinNumPoints_ = n;
+}
+
+void SettingsValidator::setGestureExpirationMilliseconds( const QString & tagValue )
+{
+    gestureExpirationMilliseconds_ = convertToInt( tagValue, 
+                                                   MIN_GESTURE_EXPIRATION_MILLISECONDS, 
+                                                   MAX_GESTURE_EXPIRATION_MILLISECONDS,
+                                                   "SettingsValidator::setGestureExpirationMilliseconds()",
+                                                   "gestureExpirationMilliseconds" );
+}
+
+int SettingsValidator::gestureExpirationMilliseconds()
+{
+    return gestureExpirationMilliseconds_;
+}
+
+void SettingsValidator::setGestureExpirationMilliseconds( int n )
+{
+    gestureExpirationMilliseconds_ = n;
+}
+
+void SettingsValidator::setGestureValidLineAspectRatio( const QString & tagValue )
+{
+    gestureValidLineAspectRatio_ = convertToDouble( tagValue, 
+                                                    MIN_GESTURE_ASPECT_RATIO, 
+                                                    MAX_GESTURE_ASPECT_RATIO,
+                                                    "SettingsValidator::setGestureValidLineAspectRatio()",
+                                                    "gestureValidLineAspectRatio" );
+}
+
+double SettingsValidator::gestureValidLineAspectRatio()
+{
+    return gestureValidLineAspectRatio_;
+}
+
+void SettingsValidator::setGestureValidLineAspectRatio( double d )
+{
+    gestureValidLineAspectRatio_ = d;
+}
+
+void SettingsValidator::setGestureToleranceFactor( const QString & tagValue )
+{
+    gestureToleranceFactor_ = convertToDouble( tagValue, 
+                                               MIN_GESTURE_TOLERANCE_FACTOR, 
+                                               MAX_GESTURE_TOLERANCE_FACTOR,
+                                               "SettingsValidator::setGestureToleranceFactor()",
+                                               "gestureToleranceFactor" );
+}
+
+double SettingsValidator::gestureToleranceFactor()
+{
+    return gestureToleranceFactor_;
+}
+
+void SettingsValidator::setGestureToleranceFactor( double d )
+{
+    gestureToleranceFactor_ = d;
+}
+
+/***************************************************************************//**
+Throws a ValidatorException if the tag value is not an integer in the range
+[min, max].  The member variable is left untouched in that case, so a bad 
+value in the XML file never replaces a good one.
+*******************************************************************************/
+int SettingsValidator::convertToInt( const QString & tagValue, int min, int max,
+                                     const QString & source, const QString & name )
+{
+    bool ok = false;
+    int n = tagValue.trimmed().toInt( &ok );
+
+    if( !ok || n < min || n > max ) {
+        throw ValidatorException( "Invalid startup setting detected.",
+                                  source,
+                                  name,
+                                  tagValue,
+                                  QString( "an integer from %1 to %2" ).arg( min ).arg( max ),
+                                  xmlConfigFilename_ );
+    }
+    return n;
+}
+
+double SettingsValidator::convertToDouble( const QString & tagValue, double min, double max,
+                                           const QString & source, const QString & name )
+{
+    bool ok = false;
+    double d = tagValue.trimmed().toDouble( &ok );
+
+    if( !ok || d < min || d > max ) {
+        throw ValidatorException( "Invalid startup setting detected.",
+                                  source,
+                                  name,
+                                  tagValue,
+                                  QString( "a number from %1 to %2" ).arg( min ).arg( max ),
+                                  xmlConfigFilename_ );
+    }
+    return d;
+}
@@ -35,6 +35,7 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 
 #include "enums/TuioSourceEnum.h"
 #include <QString>
+#include <QStringList>
 
 /***************************************************************************//**
 Contains classes for reading/writing program settings as XML files.  
@@ -47,6 +48,17 @@ namespace xml
     class SettingsValidator
     {
     public:
+        static const int MIN_GESTURE_NUM_POINTS,
+                         MAX_GESTURE_NUM_POINTS,
+                         MIN_GESTURE_EXPIRATION_MILLISECONDS,
+                         MAX_GESTURE_EXPIRATION_MILLISECONDS,
+                         MIN_METRICS_PORT,
+                         MAX_METRICS_PORT;
+        static const double MIN_GESTURE_ASPECT_RATIO,
+                            MAX_GESTURE_ASPECT_RATIO,
+                            MIN_GESTURE_TOLERANCE_FACTOR,
+                            MAX_GESTURE_TOLERANCE_FACTOR;
+
         SettingsValidator();
         ~SettingsValidator();
 
@@ -64,11 +76,56 @@ namespace xml
         bool showShutdownComputerIcon();
         void showShutdownComputerIcon( bool b );
 
+        void useOpenGLRenderer( const QString & s );
+        bool useOpenGLRenderer();
+        void useOpenGLRenderer( bool b );
+
+        void useWarmStart( const QString & s );
+        bool useWarmStart();
+        void useWarmStart( bool b );
+
+        void setWarmStartApps( const QString & s );
+        QStringList warmStartApps();
+        void setWarmStartApps( const QStringList & appNames );
+
+        void setMetricsPort( const QString & s );
+        int metricsPort();
+        void setMetricsPort( int port );
+
+        void setGestureMinNumPoints( const QString & s );
+        int gestureMinNumPoints();
+        void setGestureMinNumPoints( int n );
+
+        void setGestureExpirationMilliseconds( const QString & s );
+        int gestureExpirationMilliseconds();
+        void setGestureExpirationMilliseconds( int n );
+
+        void setGestureValidLineAspectRatio( const QString & s );
+        double gestureValidLineAspectRatio();
+        void setGestureValidLineAspectRatio( double d );
+
+        void setGestureToleranceFactor( const QString & s );
+        double gestureToleranceFactor();
+        void setGestureToleranceFactor( double d );
+
     private:
+        int convertToInt( const QString & tagValue, int min, int max,
+                          const QString & source, const QString & name );
+        double convertToDouble( const QString & tagValue, double min, double max,
+                                const QString & source, const QString & name );
+
         QString xmlConfigFilename_;
         enums::TuioSourceEnum::Enum tuioSource_;
         bool usePlusGestureToQuitApps_,
-             showShutdownComputerIcon_;
+             showShutdownComputerIcon_,
+             useOpenGLRenderer_,
+             useWarmStart_;
+        QStringList warmStartApps_;
+        int metricsPort_,
+            gestureMinNumPoints_,
+            gestureExpirationMilliseconds_;
+        double gestureValidLineAspectRatio_,
+               gestureToleranceFactor_;
     };
 }
 
@@ -0,0 +1,316 @@
+/*******************************************************************************
+SettingsXmlBenchmark
+
+PURPOSE: Times how long it takes to read and validate the settings file.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#include "xml/SettingsXmlBenchmark.h"
+#include "xml/SettingsXmlReader.h"
+#include "xml/SettingsKeyTable.h"
+#include "xml/SettingsValidator.h"
+#include "gui/XmlSettings.h"
+#include "exceptions/FileNotFoundException.h"
+#include <QFile>
+#include <QBuffer>
+#include <QIODevice>
+#include <QElapsedTimer>
+#include <iomanip>
+
+using xml::SettingsXmlBenchmark;
+using xml::SettingsKeyTable;
+using exceptions::FileNotFoundException;
+using exceptions::ValidatorException;
+using exceptions::UnknownXmlTagException;
+using exceptions::IOException;
+
+const QString SettingsXmlBenchmark::COMMAND_LINE_ARG = "-benchmarksettings";
+
+const int SettingsXmlBenchmark::DEFAULT_ITERATIONS = 10000;
+
+bool SettingsXmlBenchmark::isBenchmarkRequested( int argc, char * argv[] )
+{
+    if( argc > 1 ) {
+        QString arg = argv[1];
+        return (arg.compare( COMMAND_LINE_ARG, Qt::CaseInsensitive ) == 0);
+    }
+    return false;
+}
+
+/***************************************************************************//**
+Command line usage:
+
+    PlaysurfaceLauncher.exe -benchmarksettings [settingsFile] [iterations]
+
+Returns 0 on success, or 1 if the settings file could not be read.
+*******************************************************************************/
+int SettingsXmlBenchmark::run( int argc, char * argv[], std::ostream & out )
+{
+    QString xmlFile = (argc > 2) ? QString( argv[2] ) : gui::XmlSettings::DEFAULT_CONFIG_FILE;
+    int iterations = (argc > 3) ? QString( argv[3] ).toInt() : DEFAULT_ITERATIONS;
+    if( iterations < 1 ) { iterations = DEFAULT_ITERATIONS; }
+
+    SettingsXmlBenchmark benchmark;
+
+    try {
+        benchmark.readSettingsFile( xmlFile );
+        benchmark.measureStreamReader( iterations );
+    }
+    catch( IOException & e ) {
+        out << "Unable to read settings file " << xmlFile.toStdString() << "\n"
+            << e.getMessage().toStdString() << " (" << e.getSource().toStdString() << ")\n";
+        return 1;
+    }
+    benchmark.measureDomReader( iterations );
+    benchmark.printReport( out );
+    return 0;
+}
+
+SettingsXmlBenchmark::SettingsXmlBenchmark() :
+  xmlBytes_(),
+  iterations_( 0 ),
+  streamNanoseconds_( 0.0 ),
+  domNanoseconds_( 0.0 ),
+  xmlFile_( "unknown" ),
+  unknownXmlTagExceptions_(),
+  validatorExceptions_()
+{
+}
+
+SettingsXmlBenchmark::~SettingsXmlBenchmark()
+{
+}
+
+void SettingsXmlBenchmark::readSettingsFile( const QString & xmlFile )
+{
+    xmlFile_ = xmlFile;
+    QFile file( xmlFile_ );
+
+    if( !file.open( QIODevice::ReadOnly ) ) {
+        QString msg( "The XML configuration file could not be found." );
+        throw FileNotFoundException( msg, "SettingsXmlBenchmark::readSettingsFile()", xmlFile_ );
+    }
+    xmlBytes_ = file.readAll();
+}
+
+/***************************************************************************//**
+Each read gets a new validator, as the launcher does when it starts.  The
+reader's exceptions (a malformed file, for example) are passed on to run().
+*******************************************************************************/
+void SettingsXmlBenchmark::measureStreamReader( int iterations )
+{
+    xml::SettingsXmlReader reader;
+    QElapsedTimer timer;
+    timer.start();
+
+    for( int n = 0; n < iterations; ++n ) {
+        xml::SettingsValidator validator;
+        QBuffer buffer( &xmlBytes_ );
+        buffer.open( QIODevice::ReadOnly );
+        reader.readFromDevice( &buffer, &validator );
+    }
+    streamNanoseconds_ = (double)timer.nsecsElapsed();
+    iterations_ = iterations;
+}
+
+/***************************************************************************//**
+Each read gets a new validator and starts with no exceptions, as the old 
+reader did when the launcher started.
+*******************************************************************************/
+void SettingsXmlBenchmark::measureDomReader( int iterations )
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    for( int n = 0; n < iterations; ++n ) {
+        xml::SettingsValidator validator;
+        QDomDocument doc;
+        unknownXmlTagExceptions_.clear();
+        validatorExceptions_.clear();
+
+        if( doc.setContent( xmlBytes_ ) ) {
+            extractParams( doc, &validator );
+        }
+    }
+    domNanoseconds_ = (double)timer.nsecsElapsed();
+}
+
+void SettingsXmlBenchmark::extractParams( QDomDocument & doc, 
+                                          xml::SettingsValidator * validator )
+{
+    QDomElement root = doc.documentElement();
+    QDomNode childNode = root.firstChild();
+    QString tag = root.tagName().trimmed();
+
+    if( tag.compare( "PlaysurfaceLauncherSettings", Qt::CaseInsensitive ) != 0 ) {
+        QString msg( "Unrecognized XML tag found." );
+        UnknownXmlTagException e( msg, "SettingsXmlBenchmark::extractParams()",
+                                  tag, xmlFile_ );
+        unknownXmlTagExceptions_.push_back( e );
+        return;
+    }
+    while( !childNode.isNull() ) {
+        if( childNode.isElement() ) {
+            storeParams( childNode.toElement(), validator );
+        }
+        childNode = childNode.nextSibling();
+    }
+}
+
+void SettingsXmlBenchmark::storeParams( QDomElement element, 
+                                        xml::SettingsValidator * validator )
+{
+    QString tag = element.tagName().trimmed();
+    QDomNode childNode = element.firstChild();
+    tag = tag.toLower();
+
+    if( tag == "options" ) {
+        storeOptionsParams( childNode, validator );
+    }
+    else if( tag == "gestures" ) { 
+        storeGesturesParams( childNode, validator );
+    }
+    else { 
+        if( tag.size() == 0 ) { tag = "NO VALUE GIVEN"; }
+        QString msg( "Unrecognized XML tag found." );
+        UnknownXmlTagException e( msg, "SettingsXmlBenchmark::storeParams()",
+                                  tag, xmlFile_ );
+        unknownXmlTagExceptions_.push_back( e );
+    }
+}
+
+void SettingsXmlBenchmark::storeOptionsParams( QDomNode & node, 
+                                               xml::SettingsValidator * validator )
+{
+    while( !node.isNull() ) {
+        if( node.isElement() ) {
+            QDomElement subelement = node.toElement();
+            QString tag = subelement.tagName().trimmed(),
+                    text = subelement.text().trimmed();
+            tag = tag.toLower();
+
+            try {
+                if( tag == "touchdetection" ) {
+                    validator->setTuioSource( text );
+                }
+                else if( tag == "showshutdowncomputericon" ) { 
+                    validator->showShutdownComputerIcon( text ); 
+                }
+                else if( tag == "useopenglrenderer" ) { 
+                    validator->useOpenGLRenderer( text ); 
+                }
+                else if( tag == "warmstart" ) { 
+                    validator->useWarmStart( text ); 
+                }
+                else if( tag == "warmstartapps" ) { 
+                    validator->setWarmStartApps( text ); 
+                }
+                else if( tag == "metricsport" ) { 
+                    validator->setMetricsPort( text ); 
+                }
+                else { 
+                    if( tag.size() == 0 ) { tag = "NO VALUE GIVEN"; }
+                    QString msg( "Unrecognized XML tag found." );
+                    UnknownXmlTagException e( msg, "SettingsXmlBenchmark::storeOptionsParams()",
+                                              tag, xmlFile_ );
+                    unknownXmlTagExceptions_.push_back( e );
+                }
+            }
+            catch( ValidatorException e ) {
+                validatorExceptions_.push_back( e );
+            }
+        }
+        node = node.nextSibling();
+    }
+}
+
+void SettingsXmlBenchmark::storeGesturesParams( QDomNode & node, 
+                                                xml::SettingsValidator * validator )
+{
+    while( !node.isNull() ) {
+        if( node.isElement() ) {
+            QDomElement subelement = node.toElement();
+            QString tag = subelement.tagName().trimmed(),
+                    text = subelement.text().trimmed();
+            tag = tag.toLower();
+
+            try {
+                if( tag == "useplussigntoquitapps" ) { 
+                    validator->usePlusGestureToQuitApps( text ); 
+                }
+                else if( tag == "minnumpoints" ) { 
+                    validator->setGestureMinNumPoints( text ); 
+                }
+                else if( tag == "expirationmilliseconds" ) { 
+                    validator->setGestureExpirationMilliseconds( text ); 
+                }
+                else if( tag == "validlineaspectratio" ) { 
+                    validator->setGestureValidLineAspectRatio( text ); 
+                }
+                else if( tag == "tolerancefactor" ) { 
+                    validator->setGestureToleranceFactor( text ); 
+                }
+                else { 
+                    if( tag.size() == 0 ) { tag = "NO VALUE GIVEN"; }
+                    QString msg( "Unrecognized XML tag found." );
+                    UnknownXmlTagException e( msg, "SettingsXmlBenchmark::storeGesturesParams()",
+                                              tag, xmlFile_ );
+                    unknownXmlTagExceptions_.push_back( e );
+                }
+            }
+            catch( ValidatorException e ) {
+                validatorExceptions_.push_back( e );
+            }
+        }
+        node = node.nextSibling();
+    }
+}
+
+void SettingsXmlBenchmark::printReport( std::ostream & out )
+{
+    const SettingsKeyTable & keyTable = SettingsKeyTable::instance();
+
+    out << "\nSettings XML benchmark: " << xmlFile_.toStdString() << "\n"
+        << "bytes = " << xmlBytes_.size()
+        << "; unknown tags = " << unknownXmlTagExceptions_.size()
+        << "; invalid values = " << validatorExceptions_.size() << "\n"
+        << "key table: keys = " << keyTable.numberOfKeys()
+        << "; slots = " << keyTable.numberOfSlots()
+        << "; seed = " << keyTable.seed() << "\n";
+
+    if( iterations_ > 0 ) {
+        double microseconds = 1000.0 * iterations_;
+
+        out << "\niterations = " << iterations_ 
+            << std::fixed << std::setprecision( 2 )
+            << "\n" << std::left << std::setw( 22 ) << "QXmlStreamReader" 
+            << std::right << std::setw( 10 ) << streamNanoseconds_ / microseconds << " us/read"
+            << "\n" << std::left << std::setw( 22 ) << "QDomDocument (old)" 
+            << std::right << std::setw( 10 ) << domNanoseconds_ / microseconds << " us/read\n";
+    }
+    out.flush();
+}
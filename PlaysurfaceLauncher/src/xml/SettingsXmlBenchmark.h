@@ -0,0 +1,95 @@
+/*******************************************************************************
+SettingsXmlBenchmark
+
+PURPOSE: Times how long it takes to read and validate the settings file.
+
+AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
+*******************************************************************************/
+/*
+ PlaysurfaceLauncher - Provides a game console-like environment for launching
+                       TUIO-based multitouch apps.  
+ 
+ Copyright (c) 2014, 2015 J.R.Weber <joe.weber77@gmail.com>
+ 
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation; either version 3 of the License, or
+ (at your option) any later version.
+ 
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+ 
+ You should have received a copy of the GNU General Public License along with 
+ this program.  If not, go to http://www.gnu.org/licenses/gpl-3.0.en.html or
+ write to 
+ 
+ Free Software  Foundation, Inc.
+ 59 Temple Place, Suite 330
+ Boston, MA  02111-1307  USA
+*/
+#ifndef XML_SETTINGSXMLBENCHMARK_H
+#define XML_SETTINGSXMLBENCHMARK_H
+
+#include "exceptions/ValidatorException.h"
+#include "exceptions/UnknownXmlTagException.h"
+#include <QString>
+#include <QByteArray>
+#include <QtXml/QDomDocument>
+#include <QtXml/QDomElement>
+#include <QtXml/QDomNode>
+#include <ostream>
+#include <vector>
+
+namespace xml { class SettingsValidator; }
+
+namespace xml
+{
+    /***********************************************************************//**
+    Times how long it takes to read the settings file, both with the
+    streaming SettingsXmlReader and with the QDomDocument reader it 
+    replaced, and reports microseconds per read.  The file is read from disk
+    once and then parsed from memory, so only the parsing and validating 
+    are timed.
+
+    The old reader is kept here as it was (extractParams() and the 
+    store...Params() methods): it lower-cases each tag, finds it with a 
+    chain of string compares, and builds an UnknownXmlTagException for 
+    every tag it does not know, so the baseline costs what the old reader
+    cost.
+    ***************************************************************************/
+    class SettingsXmlBenchmark
+    {
+    public:
+        static const QString COMMAND_LINE_ARG;
+        static const int DEFAULT_ITERATIONS;
+
+        static bool isBenchmarkRequested( int argc, char * argv[] );
+        static int run( int argc, char * argv[], std::ostream & out );
+
+        SettingsXmlBenchmark();
+        virtual ~SettingsXmlBenchmark();
+
+        void readSettingsFile( const QString & xmlFile );
+        void measureStreamReader( int iterations );
+        void measureDomReader( int iterations );
+        void printReport( std::ostream & out );
+
+    private:
+        void extractParams( QDomDocument & doc, xml::SettingsValidator * validator );
+        void storeParams( QDomElement element, xml::SettingsValidator * validator );
+        void storeOptionsParams( QDomNode & node, xml::SettingsValidator * validator );
+        void storeGesturesParams( QDomNode & node, xml::SettingsValidator * validator );
+
+        QByteArray xmlBytes_;
+        int iterations_;
+        double streamNanoseconds_,
+               domNanoseconds_;
+        QString xmlFile_;
+        std::vector<exceptions::UnknownXmlTagException> unknownXmlTagExceptions_;
+        std::vector<exceptions::ValidatorException> validatorExceptions_;
+    };
+}
+
+#endif
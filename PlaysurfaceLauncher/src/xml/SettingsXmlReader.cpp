@@ -35,16 +35,11 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #include "exceptions/SettingsXmlReaderException.h"
 #include <QFile>
 #include <QIODevice>
-#include <QByteArray>
-#include <QtXml/QDomDocument>
-#include <QtXml/QDomDocumentType>
-#include <QtXml/QDomElement>
-#include <QtXml/QDomNode>
-#include <QtXml/QDomAttr>
-#include <QtXml/QDomText>
+#include <QXmlStreamReader>
 #include <iostream>
 
 using xml::SettingsXmlReader;
+using xml::SettingsKeyTable;
 using exceptions::ValidatorException;
 using exceptions::UnknownXmlTagException;
 using exceptions::FileNotFoundException;
@@ -54,6 +49,7 @@ SettingsXmlReader::SettingsXmlReader() :
   unknownXmlTagExceptions_(),
   validatorExceptions_(),
   xmlFile_( "unknown" ),
+  onlySection_( SettingsKeyTable::NO_SECTION ),
   debugPrint_( false )
 {
 }
@@ -72,132 +68,130 @@ void SettingsXmlReader::read( const QString & xmlFile,
     debugPrintLn( "\nSettingsXmlReader::readXmlFile( " + xmlFile_ + " ) called..." );
 
     QFile file( xmlFile_ );
-    QDomDocument doc;
-    QString err;
-    int line = 0,
-        col = 0;
 
     if( !file.open( QIODevice::ReadOnly ) ) {
         QString msg( "The XML configuration file could not be found." );
         throw FileNotFoundException( msg, "SettingsXmlReader::read()", xmlFile );
     }
-    if( !doc.setContent( file.readAll(), &err, &line, &col ) ) {
-        QString msg( "An error occurred while reading the XML configuration file." );
-        throw SettingsXmlReaderException( msg, "BlobParamsXmlReader::read()",
-                                          err, line, col, xmlFile_ );
-    }
-    extractParams( doc, validator );
+    readFromDevice( &file, validator );
 }
 
-void SettingsXmlReader::extractParams( QDomDocument & doc, 
-                                       xml::SettingsValidator * validator )
+/***************************************************************************//**
+Reads the settings from an open device (the benchmark uses a QBuffer, so 
+that it does not time the disk).  The file name given to the exceptions is
+the one last passed to read().  The validator is only updated if the whole
+document could be read.
+*******************************************************************************/
+void SettingsXmlReader::readFromDevice( QIODevice * device, 
+                                        xml::SettingsValidator * validator )
 {
-    QDomElement root = doc.documentElement();
-    QDomNode childNode = root.firstChild();
-    QString tag = root.tagName().trimmed();
-    debugPrintLn( "root = <" + tag + ">" );
-
-    if( tag.compare( "PlaysurfaceLauncherSettings", Qt::CaseInsensitive ) != 0 ) {
-        QString msg( "Unrecognized XML tag found." );
-        throw UnknownXmlTagException( msg, "SettingsXmlReader::extractParams()",
-                                      tag, xmlFile_ );
-    }
-    while( !childNode.isNull() ) {
-        if( childNode.isElement() ) {
-            storeParams( childNode.toElement(), validator );
+    unknownXmlTagExceptions_.clear();
+    validatorExceptions_.clear();
+    xml::SettingsValidator parsed( *validator );
+    QXmlStreamReader reader( device );
+
+    if( reader.readNextStartElement() ) {
+        QString tag = reader.name().toString().trimmed();
+        debugPrintLn( "root = <" + tag + ">" );
+
+        if( !SettingsKeyTable::instance().isRootTag( reader.name() ) ) {
+            QString msg( "Unrecognized XML tag found." );
+            throw UnknownXmlTagException( msg, "SettingsXmlReader::read()",
+                                          tag, xmlFile_ );
         }
-        childNode = childNode.nextSibling();
+        readSection( reader, SettingsKeyTable::ROOT_SECTION, &parsed );
+    }
+    if( reader.hasError() ) {
+        unknownXmlTagExceptions_.clear();
+        validatorExceptions_.clear();
+        QString msg( "An error occurred while reading the XML configuration file." );
+        throw SettingsXmlReaderException( msg, "SettingsXmlReader::read()",
+                                          reader.errorString(), 
+                                          (int)reader.lineNumber(), 
+                                          (int)reader.columnNumber(), 
+                                          xmlFile_ );
     }
+    *validator = parsed;
 }
 
-void SettingsXmlReader::storeParams( QDomElement element, 
-                                     xml::SettingsValidator * validator )
+/***************************************************************************//**
+Reads only the <Gestures> section of the file, for the hot reload of the 
+gesture thresholds.  The other sections are skipped without being checked.
+*******************************************************************************/
+void SettingsXmlReader::readGestures( const QString & xmlFile, 
+                                      xml::SettingsValidator * validator )
 {
-    QString tag = element.tagName().trimmed();
-    QDomNode childNode = element.firstChild();
-    debugPrintLn( "   Element = <" + tag + ">" );
-    tag = tag.toLower();
+    onlySection_ = SettingsKeyTable::GESTURES_SECTION;
 
-    if( tag == "options" ) {
-        storeOptionsParams( childNode, validator );
-    }
-    else if( tag == "gestures" ) { 
-        storeGesturesParams( childNode, validator );
+    try {
+        read( xmlFile, validator );
     }
-    else { 
-        if( tag.size() == 0 ) { tag = "NO VALUE GIVEN"; }
-        QString msg( "Unrecognized XML tag found." );
-        UnknownXmlTagException e( msg, "SettingsXmlReader::storeParams()",
-                                  tag, xmlFile_ );
-        unknownXmlTagExceptions_.push_back( e );
+    catch( ... ) {
+        onlySection_ = SettingsKeyTable::NO_SECTION;
+        throw;
     }
+    onlySection_ = SettingsKeyTable::NO_SECTION;
 }
 
-void SettingsXmlReader::storeOptionsParams( QDomNode & node, 
-                                            xml::SettingsValidator * validator )
+/***************************************************************************//**
+Reads the child elements of the current element, up to its end tag.
+*******************************************************************************/
+void SettingsXmlReader::readSection( QXmlStreamReader & reader,
+                                     SettingsKeyTable::Section section,
+                                     xml::SettingsValidator * validator )
 {
-    while( !node.isNull() ) {
-        if( node.isElement() ) {
-            QDomElement subelement = node.toElement();
-            QString tag = subelement.tagName().trimmed(),
-                    text = subelement.text().trimmed();
-            debugPrintLn( "        XML tag: " + tag + " = " + text );
-            tag = tag.toLower();
-
-            try {
-                if( tag == "touchdetection" ) {
-                    validator->setTuioSource( text );
-                }
-                else if( tag == "showshutdowncomputericon" ) { 
-                    validator->showShutdownComputerIcon( text ); 
-                }
-                else { 
-                    if( tag.size() == 0 ) { tag = "NO VALUE GIVEN"; }
-                    QString msg( "Unrecognized XML tag found." );
-                    UnknownXmlTagException e( msg, "SettingsXmlReader::storeOptionsParams()",
-                                              tag, xmlFile_ );
-                    unknownXmlTagExceptions_.push_back( e );
-                }
-            }
-            catch( ValidatorException e ) {
-                validatorExceptions_.push_back( e );
-            }
+    const SettingsKeyTable & keyTable = SettingsKeyTable::instance();
+
+    while( reader.readNextStartElement() ) {
+        const SettingsKeyTable::Key * key = keyTable.find( section, reader.name() );
+
+        if( key == NULL ) {
+            addUnknownXmlTag( reader.name().toString().trimmed(), 
+                              "SettingsXmlReader::readSection()" );
+            reader.skipCurrentElement();
+        }
+        else if( key->opensSection != SettingsKeyTable::NO_SECTION
+                 && onlySection_ != SettingsKeyTable::NO_SECTION
+                 && key->opensSection != onlySection_ )
+        {
+            reader.skipCurrentElement();
+        }
+        else if( key->opensSection != SettingsKeyTable::NO_SECTION ) {
+            debugPrintLn( "   Element = <" + QString( key->tag ) + ">" );
+            readSection( reader, key->opensSection, validator );
+        }
+        else {
+            readSetting( reader, key, validator );
         }
-        node = node.nextSibling();
     }
 }
 
-void SettingsXmlReader::storeGesturesParams( QDomNode & node, 
-                                             xml::SettingsValidator * validator )
+void SettingsXmlReader::readSetting( QXmlStreamReader & reader,
+                                     const SettingsKeyTable::Key * key,
+                                     xml::SettingsValidator * validator )
 {
-    while( !node.isNull() ) {
-        if( node.isElement() ) {
-            QDomElement subelement = node.toElement();
-            QString tag = subelement.tagName().trimmed(),
-                    text = subelement.text().trimmed();
-            debugPrintLn( "        XML tag: " + tag + " = " + text );
-            tag = tag.toLower();
-
-            try {
-                if( tag == "useplussigntoquitapps" ) { 
-                    validator->usePlusGestureToQuitApps( text ); 
-                }
-                else { 
-                    if( tag.size() == 0 ) { tag = "NO VALUE GIVEN"; }
-                    QString msg( "Unrecognized XML tag found." );
-                    UnknownXmlTagException e( msg, "SettingsXmlReader::storeGesturesParams()",
-                                              tag, xmlFile_ );
-                    unknownXmlTagExceptions_.push_back( e );
-                }
-            }
-            catch( ValidatorException e ) {
-                validatorExceptions_.push_back( e );
-            }
-        }
-        node = node.nextSibling();
+    QString text = reader.readElementText( QXmlStreamReader::IncludeChildElements ).trimmed();
+    debugPrintLn( "        XML tag: " + QString( key->tag ) + " = " + text );
+
+    if( reader.hasError() ) {
+        return;
+    }
+    try {
+        (validator->*key->setter)( text );
+    }
+    catch( ValidatorException e ) {
+        validatorExceptions_.push_back( e );
     }
 }
 
+void SettingsXmlReader::addUnknownXmlTag( const QString & tag, const QString & source )
+{
+    QString name = (tag.size() == 0) ? QString( "NO VALUE GIVEN" ) : tag.toLower();
+    QString msg( "Unrecognized XML tag found." );
+    UnknownXmlTagException e( msg, source, name, xmlFile_ );
+    unknownXmlTagExceptions_.push_back( e );
+}
+
 bool SettingsXmlReader::hasUnknownXmlTagExceptions()
 {
     return (unknownXmlTagExceptions_.size() > 0);
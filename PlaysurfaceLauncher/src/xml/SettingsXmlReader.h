@@ -32,20 +32,29 @@ AUTHOR:  J.R. Weber <joe.weber77@gmail.com>
 #ifndef XML_SETTINGSXMLREADER_H
 #define XML_SETTINGSXMLREADER_H
 
+#include "xml/SettingsKeyTable.h"
 #include "exceptions/ValidatorException.h"
 #include "exceptions/UnknownXmlTagException.h"
 #include <QString>
-#include <QtCore/QByteArray>
-#include <QtXml/QDomDocument>
-#include <QtXml/QDomElement>
 #include <vector>
 
 namespace xml { class SettingsValidator; }
+class QIODevice;
+class QXmlStreamReader;
 
 namespace xml
 {
     /***********************************************************************//**
     Reads program settings from an XML file.
+
+    The file is read with a QXmlStreamReader rather than being loaded into a
+    QDomDocument, and each tag is looked up in the SettingsKeyTable and its
+    value handed to the SettingsValidator as soon as the end of the tag is 
+    reached.  The values go into a copy of the validator, which is copied
+    back only once the whole file has been read, so if the XML turns out to
+    be malformed part way through (a file truncated by an editor that is 
+    still saving it, say), none of the settings are changed, no problems
+    with them are reported, and a SettingsXmlReaderException is thrown.
     ***************************************************************************/
     class SettingsXmlReader
     {
@@ -54,6 +63,8 @@ namespace xml
         ~SettingsXmlReader();
 
         void read( const QString & xmlFile, xml::SettingsValidator * validator );
+        void readFromDevice( QIODevice * device, xml::SettingsValidator * validator );
+        void readGestures( const QString & xmlFile, xml::SettingsValidator * validator );
 
         bool hasUnknownXmlTagExceptions();
         std::vector<exceptions::UnknownXmlTagException> unknownXmlTagExceptions();
@@ -61,16 +72,20 @@ namespace xml
         std::vector<exceptions::ValidatorException> validatorExceptions();
 
     private:
-        void extractParams( QDomDocument & doc, xml::SettingsValidator * validator );
-        void storeParams( QDomElement element, xml::SettingsValidator * validator );
-        void storeOptionsParams( QDomNode & node, xml::SettingsValidator * validator );
-        void storeGesturesParams( QDomNode & node, xml::SettingsValidator * validator );
+        void readSection( QXmlStreamReader & reader,
+                          xml::SettingsKeyTable::Section section,
+                          xml::SettingsValidator * validator );
+        void readSetting( QXmlStreamReader & reader,
+                          const xml::SettingsKeyTable::Key * key,
+                          xml::SettingsValidator * validator );
+        void addUnknownXmlTag( const QString & tag, const QString & source );
 
         void debugPrintLn( const QString & msg );
 
         std::vector<exceptions::UnknownXmlTagException> unknownXmlTagExceptions_;
         std::vector<exceptions::ValidatorException> validatorExceptions_;
         QString xmlFile_;
+        xml::SettingsKeyTable::Section onlySection_;
         bool debugPrint_;
     };
 }
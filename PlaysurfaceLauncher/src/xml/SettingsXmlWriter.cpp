@@ -85,6 +85,10 @@ QString SettingsXmlWriter::getOptionsXml( xml::SettingsValidator * validator )
     QString xml( "    <Options>\n" );
     xml.append( createXmlFromEnum( "TouchDetection", validator->tuioSource() ) );
     xml.append( createXmlFromBool( "ShowShutdownComputerIcon", validator->showShutdownComputerIcon() ) );
+    xml.append( createXmlFromBool( "UseOpenGLRenderer", validator->useOpenGLRenderer() ) );
+    xml.append( createXmlFromBool( "WarmStart", validator->useWarmStart() ) );
+    xml.append( createXmlFromString( "WarmStartApps", validator->warmStartApps().join( ", " ) ) );
+    xml.append( createXmlFromInt( "MetricsPort", validator->metricsPort() ) );
     xml.append( "    </Options>\n\n" );
     return xml;
 }
@@ -93,6 +97,10 @@ QString SettingsXmlWriter::getGesturesXml( xml::SettingsValidator * validator )
 {
     QString xml( "    <Gestures>\n" );
     xml.append( createXmlFromBool( "UsePlusSignToQuitApps", validator->usePlusGestureToQuitApps() ) );
+    xml.append( createXmlFromInt( "MinNumPoints", validator->gestureMinNumPoints() ) );
+    xml.append( createXmlFromInt( "ExpirationMilliseconds", validator->gestureExpirationMilliseconds() ) );
+    xml.append( createXmlFromDouble( "ValidLineAspectRatio", validator->gestureValidLineAspectRatio() ) );
+    xml.append( createXmlFromDouble( "ToleranceFactor", validator->gestureToleranceFactor() ) );
     xml.append( "    </Gestures>\n\n" );
     return xml;
 }